@@ -0,0 +1,38 @@
+# OpenClonk, http://www.openclonk.org
+#
+# Copyright (c) 2019, The OpenClonk Team and contributors
+#
+# Distributed under the terms of the ISC license; see accompanying file
+# "COPYING" for details.
+#
+# "Clonk" is a registered trademark of Matthes Bender, used with permission.
+# See accompanying file "TRADEMARK" for details.
+#
+# To redistribute this file separately, substitute the full license texts
+# for the above references.
+
+# - Find LZ4
+# Find the native lz4 includes and library
+#
+#  LZ4_INCLUDE_DIR - where to find lz4.h
+#  LZ4_LIBRARIES   - List of libraries when using lz4.
+#  LZ4_FOUND       - True if lz4 found.
+
+IF (LZ4_INCLUDE_DIR)
+	# Already in cache, be silent
+	SET(LZ4_FIND_QUIETLY TRUE)
+ENDIF (LZ4_INCLUDE_DIR)
+
+FIND_PATH(LZ4_INCLUDE_DIR lz4.h)
+FIND_LIBRARY(LZ4_LIBRARY NAMES lz4 liblz4)
+
+INCLUDE(FindPackageHandleStandardArgs)
+FIND_PACKAGE_HANDLE_STANDARD_ARGS(LZ4 DEFAULT_MSG LZ4_LIBRARY LZ4_INCLUDE_DIR)
+
+IF(LZ4_FOUND)
+	SET(LZ4_LIBRARIES ${LZ4_LIBRARY})
+ELSE(LZ4_FOUND)
+	SET(LZ4_LIBRARIES)
+ENDIF(LZ4_FOUND)
+
+MARK_AS_ADVANCED(LZ4_LIBRARY LZ4_INCLUDE_DIR)
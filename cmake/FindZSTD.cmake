@@ -0,0 +1,38 @@
+# OpenClonk, http://www.openclonk.org
+#
+# Copyright (c) 2019, The OpenClonk Team and contributors
+#
+# Distributed under the terms of the ISC license; see accompanying file
+# "COPYING" for details.
+#
+# "Clonk" is a registered trademark of Matthes Bender, used with permission.
+# See accompanying file "TRADEMARK" for details.
+#
+# To redistribute this file separately, substitute the full license texts
+# for the above references.
+
+# - Find ZSTD
+# Find the native zstd includes and library
+#
+#  ZSTD_INCLUDE_DIR - where to find zstd.h
+#  ZSTD_LIBRARIES   - List of libraries when using zstd.
+#  ZSTD_FOUND       - True if zstd found.
+
+IF (ZSTD_INCLUDE_DIR)
+	# Already in cache, be silent
+	SET(ZSTD_FIND_QUIETLY TRUE)
+ENDIF (ZSTD_INCLUDE_DIR)
+
+FIND_PATH(ZSTD_INCLUDE_DIR zstd.h)
+FIND_LIBRARY(ZSTD_LIBRARY NAMES zstd libzstd)
+
+INCLUDE(FindPackageHandleStandardArgs)
+FIND_PACKAGE_HANDLE_STANDARD_ARGS(ZSTD DEFAULT_MSG ZSTD_LIBRARY ZSTD_INCLUDE_DIR)
+
+IF(ZSTD_FOUND)
+	SET(ZSTD_LIBRARIES ${ZSTD_LIBRARY})
+ELSE(ZSTD_FOUND)
+	SET(ZSTD_LIBRARIES)
+ENDIF(ZSTD_FOUND)
+
+MARK_AS_ADVANCED(ZSTD_LIBRARY ZSTD_INCLUDE_DIR)
@@ -20,6 +20,9 @@
 /* Define to 1 if you have the <locale.h> header file. */
 #cmakedefine HAVE_LOCALE_H 1
 
+/* Define if you have the LZ4 compression library */
+#cmakedefine HAVE_LZ4 1
+
 /* Define to 1 if you have the <poll.h> header file. */
 #cmakedefine HAVE_POLL_H 1
 
@@ -65,12 +68,18 @@
 /* Define to 1 if you have the <X11/extensions/Xrandr.h> header file. */
 #cmakedefine HAVE_X11_EXTENSIONS_XRANDR_H 1
 
+/* Define if you have the Zstandard compression library */
+#cmakedefine HAVE_ZSTD 1
+
 /* compile without debug options */
 #cmakedefine NDEBUG 1
 
 /* MP3 music */
 #cmakedefine USE_MP3 1
 
+/* Dispatch script bytecode through computed gotos */
+#cmakedefine USE_AUL_COMPUTED_GOTO 1
+
 /* Glib */
 #cmakedefine WITH_GLIB 1
 
@@ -0,0 +1,81 @@
+/**
+	Find Object Indexes
+	Checks that object searches answered through the definition and
+	category indexes and the result cache match the object state.
+	Searches with Find_Func are never cached and serve as reference.
+	Results are written to the log.
+*/
+
+static FindObjectIndexes_Failures;
+
+func Initialize()
+{
+	FindObjectIndexes_Failures = 0;
+	ScheduleCall(nil, Global.RunChecks, 1);
+	return true;
+}
+
+global func RunChecks()
+{
+	// Reassigned prototypes are found by Find_ID.
+	var rock = CreateObject(Rock, 100, 100, NO_OWNER);
+	CreateObject(Wood, 150, 100, NO_OWNER);
+	rock.Prototype = Wood;
+	CheckResult("Find_ID with reassigned prototype", ObjectCount(Find_ID(Wood)), 2);
+	CheckResult("Find_ID of the original definition", ObjectCount(Find_ID(Rock)), 0);
+	rock.Prototype = Rock;
+	CheckResult("Find_ID with restored prototype", ObjectCount(Find_ID(Wood)), 1);
+	CheckResult("Find_ID of the restored definition", ObjectCount(Find_ID(Rock)), 1);
+
+	// Category 0 does not restrict the search.
+	CheckResult("Find_Category(0)", ObjectCount(Find_Category(0)), ObjectCount(Find_Or(Find_Category(C4D_All), Find_Not(Find_Category(C4D_All)))));
+
+	// A con change between two identical searches changes the shape.
+	var small_rock = CreateObject(Rock, 300, 100, NO_OWNER);
+	small_rock->SetCon(10);
+	var x = small_rock->GetX(), y = small_rock->GetY() - 3;
+	CheckResult("Find_AtPoint outside of the shape", ObjectCount(Find_AtPoint(x, y)), 0);
+	small_rock->SetCon(100);
+	CheckResult("Find_AtPoint after con change", ObjectCount(Find_AtPoint(x, y)), ObjectCount(Find_AtPoint(x, y), Find_Not(Find_Func("NoSuchFunction"))));
+	CheckResult("Find_AtPoint inside of the grown shape", ObjectCount(Find_AtPoint(x, y)), 1);
+
+	// Leaving a container moves the object between two identical searches.
+	var box = CreateObject(Rock, 500, 100, NO_OWNER);
+	var content = CreateObject(Rock, 500, 100, NO_OWNER);
+	content->Enter(box);
+	CheckResult("Find_InRect before exit", ObjectCount(Find_InRect(580, 80, 40, 40)), 0);
+	content->Exit(100, 0);
+	CheckResult("Find_InRect after exit", ObjectCount(Find_InRect(580, 80, 40, 40)), 1);
+
+	// Objects resorted into the main list keep their order in the indexes. Changing the
+	// plane only marks them unsorted, so check in the next frame.
+	for (var i = 0; i < 20; i++)
+		CreateObject(Rock, 700 + i, 100, NO_OWNER).Plane = 400 + (i % 3) * 100;
+	ScheduleCall(nil, Global.RunOrderChecks, 1);
+	return true;
+}
+
+global func RunOrderChecks()
+{
+	var indexed = FindObjects(Find_ID(Rock)), reference = FindObjects(Find_Or(Find_ID(Rock), Find_ID(Rock)));
+	var misplaced = Abs(GetLength(indexed) - GetLength(reference));
+	for (var i = 0; i < Min(GetLength(indexed), GetLength(reference)); i++)
+		if (indexed[i] != reference[i])
+			misplaced++;
+	CheckResult("Find_ID order after resort", misplaced, 0);
+
+	if (FindObjectIndexes_Failures)
+		Log("FindObjectIndexes: %d checks FAILED", FindObjectIndexes_Failures);
+	else
+		Log("FindObjectIndexes: all checks passed");
+	GameOver();
+	return true;
+}
+
+global func CheckResult(string name, int result, int expected)
+{
+	if (result == expected)
+		return Log("%s: passed", name);
+	FindObjectIndexes_Failures++;
+	return Log("%s: FAILED (%d instead of %d)", name, result, expected);
+}
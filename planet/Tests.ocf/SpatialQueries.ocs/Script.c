@@ -0,0 +1,64 @@
+/**
+	Spatial Queries
+	Measures the time spent in area based object searches, which are
+	answered through the landscape sector lists.
+*/
+
+static const SpatialQueries_ObjectCount = 5000;
+static const SpatialQueries_QueryCount = 2000;
+
+func Initialize()
+{
+	// Spread many small objects and a few large ones over the landscape.
+	var wdt = LandscapeWidth(), hgt = LandscapeHeight();
+	for (var i = 0; i < SpatialQueries_ObjectCount; ++i)
+	{
+		var obj = CreateObject(Rock, Random(wdt), Random(hgt), NO_OWNER);
+		obj->SetCategory(C4D_StaticBack);
+	}
+	for (var i = 0; i < 20; ++i)
+	{
+		var obj = CreateObject(Rock, Random(wdt), Random(hgt), NO_OWNER);
+		obj->SetCategory(C4D_StaticBack);
+		obj->SetShape(-250, -250, 500, 500);
+	}
+	ScheduleCall(nil, Global.RunQueries, 1);
+	return true;
+}
+
+global func RunQueries()
+{
+	var wdt = LandscapeWidth(), hgt = LandscapeHeight();
+	var found, time;
+	
+	// Small rectangles.
+	found = 0;
+	time = GetTime();
+	for (var i = 0; i < SpatialQueries_QueryCount; ++i)
+		found += GetLength(FindObjects(Find_InRect(Random(wdt) - 50, Random(hgt) - 50, 100, 100)));
+	Log("Find_InRect 100x100: %d ms (%d objects found)", GetTime() - time, found);
+	
+	// Large rectangles.
+	found = 0;
+	time = GetTime();
+	for (var i = 0; i < SpatialQueries_QueryCount / 10; ++i)
+		found += GetLength(FindObjects(Find_InRect(Random(wdt) - 500, Random(hgt) - 500, 1000, 1000)));
+	Log("Find_InRect 1000x1000: %d ms (%d objects found)", GetTime() - time, found);
+	
+	// Distance queries, sorted.
+	found = 0;
+	time = GetTime();
+	for (var i = 0; i < SpatialQueries_QueryCount; ++i)
+		found += GetLength(FindObjects(Find_Distance(80, Random(wdt), Random(hgt)), Sort_Distance()));
+	Log("Find_Distance 80: %d ms (%d objects found)", GetTime() - time, found);
+	
+	// Queries partially outside the landscape.
+	found = 0;
+	time = GetTime();
+	for (var i = 0; i < SpatialQueries_QueryCount; ++i)
+		found += GetLength(FindObjects(Find_AtRect(-100, Random(hgt), 150, 100)));
+	Log("Find_AtRect at border: %d ms (%d objects found)", GetTime() - time, found);
+	
+	GameOver();
+	return true;
+}
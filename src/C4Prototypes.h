@@ -107,7 +107,6 @@ class C4PlayerInfoListBox;
 class C4PlayerList;
 class C4PropList;
 class C4PropListStatic;
-class C4PXS;
 class C4PXSSystem;
 class C4RankSystem;
 class C4Record;
@@ -116,6 +115,7 @@ class C4RoundResult;
 class C4RoundResults;
 class C4Scenario;
 class C4ScriptHost;
+class C4SectorObjectList;
 class C4SolidMask;
 class C4SoundSystem;
 class C4Stream;
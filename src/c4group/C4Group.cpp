@@ -25,6 +25,14 @@
 #include "c4group/C4Components.h"
 #include "lib/C4InputValidation.h"
 #include <zlib.h>
+#ifdef _WIN32
+#include "platform/C4windowswrapper.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 
 //------------------------------ File Sort Lists -------------------------------------------
@@ -54,6 +62,75 @@ int iC4GroupRewindFilePtrNoWarn = 0;
 //#define C4GROUP_DUMP_ACCESS
 #endif
 
+//------------------------------ C4GroupEntryView ------------------------------------------
+
+struct C4GroupEntryView::Storage
+{
+	StdBuf Buffer; // loaded entries
+	void *Mapping = nullptr; // mapped entries
+	size_t MappingSize = 0;
+
+	~Storage()
+	{
+		if (!Mapping) return;
+#ifdef _WIN32
+		UnmapViewOfFile(Mapping);
+#else
+		munmap(Mapping, MappingSize);
+#endif
+	}
+};
+
+bool C4GroupEntryView::isMapped() const
+{
+	return Store && Store->Mapping;
+}
+
+void C4GroupEntryView::Clear()
+{
+	Store.reset();
+	Data = nullptr;
+	Size = 0;
+}
+
+bool C4GroupEntryView::Map(const char *filename, size_t offset, size_t size)
+{
+	auto store = std::make_shared<Storage>();
+#ifdef _WIN32
+	SYSTEM_INFO system_info;
+	GetSystemInfo(&system_info);
+	size_t start = offset - offset % system_info.dwAllocationGranularity;
+	HANDLE file = CreateFileW(GetWideChar(filename), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) return false;
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping) return false;
+	store->Mapping = MapViewOfFile(mapping, FILE_MAP_READ, DWORD(uint64_t(start) >> 32), DWORD(start), offset - start + size);
+	CloseHandle(mapping);
+	if (!store->Mapping) return false;
+#else
+	size_t start = offset - offset % sysconf(_SC_PAGESIZE);
+	int fd = open(filename, O_RDONLY | O_CLOEXEC);
+	if (fd == -1) return false;
+	// Don't map beyond the end of the file
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) || size_t(file_stat.st_size) < offset + size)
+	{
+		close(fd);
+		return false;
+	}
+	void *mapping = mmap(nullptr, offset - start + size, PROT_READ, MAP_PRIVATE, fd, start);
+	close(fd);
+	if (mapping == MAP_FAILED) return false;
+	store->Mapping = mapping;
+#endif
+	store->MappingSize = offset - start + size;
+	Store = std::move(store);
+	Data = static_cast<const BYTE *>(Store->Mapping) + (offset - start);
+	Size = size;
+	return true;
+}
+
 //---------------------------- Global C4Group_Functions -------------------------------------------
 
 char C4Group_TempPath[_MAX_PATH_LEN] = "";
@@ -578,6 +655,13 @@ struct C4Group::P
 	C4GroupEntry *FirstEntry = nullptr;
 	BYTE *pInMemEntry = nullptr;
 	size_t iInMemEntrySize = 0; // for reading from entries prefetched into memory
+	// Random access: seekable groups and their child groups are read by position
+	bool RandomAccess = false;
+	bool Seekable = false; // layout of the group data: seekable format or legacy
+	bool SaveSeekable = false; // format written on close
+	int ReadPos = 0; // read position in the group data
+	std::vector<BYTE> GroupData; // group data if it cannot be read from a file
+	std::vector<BYTE> EntryData; // decompressed data of the accessed entry
 #ifdef _DEBUG
 	StdStrBuf sPrevAccessedEntry;
 #endif
@@ -773,7 +857,12 @@ bool C4Group::OpenRealGrpFile()
 	// Open StdFile
 	if (!p->StdFile.Open(GetName(), true))
 	{
-		return Error("OpenRealGrpFile: Cannot open standard file");
+		// Seekable groups are not compressed as a whole
+		if (!p->StdFile.Open(GetName(), false))
+		{
+			return Error("OpenRealGrpFile: Cannot open standard file");
+		}
+		return OpenRandomAccess(FileSize(GetName()));
 	}
 
 	// Read header
@@ -784,6 +873,26 @@ bool C4Group::OpenRealGrpFile()
 	MemScramble((BYTE*)&Head, sizeof(C4GroupHeader));
 	p->EntryOffset += sizeof(C4GroupHeader);
 
+	// Seekable group that got compressed as a whole: read into memory
+	if (Head.Ver2 == C4GroupFileVer2Seekable)
+	{
+		size_t size = UncompressedFileSize(GetName());
+		if (size < sizeof(C4GroupHeader))
+		{
+			return Error("OpenRealGrpFile: Error reading group");
+		}
+		p->GroupData.resize(size);
+		C4GroupHeader header_buffer = Head;
+		MemScramble((BYTE*)&header_buffer, sizeof(C4GroupHeader));
+		memcpy(p->GroupData.data(), &header_buffer, sizeof(C4GroupHeader));
+		if (!p->StdFile.Read(&p->GroupData[sizeof(C4GroupHeader)], size - sizeof(C4GroupHeader)))
+		{
+			return Error("OpenRealGrpFile: Error reading group");
+		}
+		p->StdFile.Close();
+		return OpenRandomAccess(size);
+	}
+
 	// Check Header
 	if (!SEqual(Head.Id, C4GroupFileID)
 	|| (Head.Ver1 != C4GroupFileVer1)
@@ -825,6 +934,151 @@ bool C4Group::OpenRealGrpFile()
 	return true;
 }
 
+bool C4Group::OpenRandomAccess(size_t size)
+{
+	p->RandomAccess = true;
+	p->FilePtr = -1; // position unknown, seek on first read
+
+	// Read header
+	if (size < sizeof(C4GroupHeader) || !ReadAt(0, &Head, sizeof(C4GroupHeader)))
+	{
+		return Error("OpenRandomAccess: Error reading header");
+	}
+	MemScramble((BYTE*)&Head, sizeof(C4GroupHeader));
+
+	// Check Header
+	if (!SEqual(Head.Id, C4GroupFileID)
+	|| (Head.Ver1 != C4GroupFileVer1)
+	|| (Head.Ver2 > C4GroupFileVer2Seekable))
+	{
+		return Error("OpenRandomAccess: Invalid header");
+	}
+	p->Seekable = p->SaveSeekable = (Head.Ver2 == C4GroupFileVer2Seekable);
+
+	// Read entries: after the header in legacy groups, at the end in seekable groups
+	int file_entries = Head.Entries;
+	Head.Entries = 0; // Reset, will be recounted by AddEntry
+	if (file_entries < 0 || size_t(file_entries) > (size - sizeof(C4GroupHeader)) / sizeof(C4GroupEntryCore))
+	{
+		return Error("OpenRandomAccess: Invalid entry count");
+	}
+	size_t index_size = file_entries * sizeof(C4GroupEntryCore);
+	size_t index_pos = p->Seekable ? size - index_size : sizeof(C4GroupHeader);
+	std::vector<C4GroupEntryCore> index(file_entries);
+	if (file_entries && !ReadAt(index_pos, index.data(), index_size))
+	{
+		return Error("OpenRandomAccess: Error reading entries");
+	}
+	p->EntryOffset = p->Seekable ? 0 : sizeof(C4GroupHeader) + index_size;
+	size_t data_end = p->Seekable ? index_pos : size;
+	for (C4GroupEntryCore &core : index)
+	{
+		// New C4Groups have filenames in UTF-8
+		StdStrBuf entryname(core.FileName);
+		entryname.EnsureUnicode();
+		// Prevent overwriting of user stuff by malicuous groups
+		C4InVal::ValidateFilename(const_cast<char *>(entryname.getData()),entryname.getLength());
+		if (!AddEntry(C4GroupEntry::C4GRES_InGroup,
+				      !!core.ChildGroup,
+		              core.FileName,
+					  core.Size,
+		              entryname.getData(),
+		              nullptr,
+					  false,
+					  false,
+		              !!core.Executable))
+		{
+			return Error("OpenRandomAccess: Cannot add entry");
+		}
+		C4GroupEntry *entry = p->FirstEntry;
+		while (entry->Next) entry = entry->Next;
+		// Seekable groups store the position of each entry
+		if (p->Seekable)
+		{
+			if (!core.Packed) core.PackedSize = core.Size;
+			entry->Offset = core.Offset;
+			entry->Packed = core.Packed;
+			entry->PackedSize = core.PackedSize;
+		}
+		if (core.Size < 0 || entry->PackedSize < 0 || entry->Offset < 0
+		 || size_t(p->EntryOffset) + entry->Offset + (p->Seekable ? entry->PackedSize : entry->Size) > data_end)
+		{
+			return Error("OpenRandomAccess: Entry out of range");
+		}
+		// Deflate can't compress by more than 1032:1, so larger sizes are corrupt and mustn't be allocated
+		if (p->Seekable && entry->Packed && int64_t(entry->Size) > int64_t(entry->PackedSize) * 1032)
+		{
+			return Error("OpenRandomAccess: Invalid entry size");
+		}
+	}
+
+	return true;
+}
+
+bool C4Group::ReadAt(size_t position, void *buffer, size_t size)
+{
+	// Group in memory
+	if (!p->GroupData.empty())
+	{
+		if (position > p->GroupData.size() || size > p->GroupData.size() - position)
+		{
+			return false;
+		}
+		memcpy(buffer, &p->GroupData[position], size);
+		return true;
+	}
+	// Group file
+	if (p->StdFile.IsOpen())
+	{
+		if (p->FilePtr < 0 || size_t(p->FilePtr) != position)
+		{
+			if (p->StdFile.Seek(position, SEEK_SET))
+			{
+				p->FilePtr = -1;
+				return false;
+			}
+		}
+		if (!p->StdFile.Read(buffer, size))
+		{
+			p->FilePtr = -1;
+			return false;
+		}
+		p->FilePtr = position + size;
+		return true;
+	}
+	// Child group stored in a group with random access
+	if (p->Mother)
+	{
+		return p->Mother->ReadAt(p->MotherOffset + position, buffer, size);
+	}
+	return false;
+}
+
+bool C4Group::SetFilePtr2RandomAccessEntry(C4GroupEntry *entry)
+{
+	// Compressed entries are decompressed as a whole
+	if (p->Seekable && entry->Packed && entry->Size)
+	{
+		std::vector<BYTE> packed(entry->PackedSize);
+		if (!ReadAt(entry->Offset, packed.data(), packed.size()))
+		{
+			return Error("SetFilePtr2Entry: Cannot read entry");
+		}
+		p->EntryData.resize(entry->Size);
+		uLongf size = entry->Size;
+		if (uncompress(p->EntryData.data(), &size, packed.data(), packed.size()) != Z_OK || size != uLongf(entry->Size))
+		{
+			return Error("SetFilePtr2Entry: Corrupt entry");
+		}
+		p->pInMemEntry = p->EntryData.data();
+		p->iInMemEntrySize = entry->Size;
+		return true;
+	}
+	// Stored entries are read directly
+	p->ReadPos = p->EntryOffset + entry->Offset;
+	return true;
+}
+
 bool C4Group::AddEntry(C4GroupEntry::EntryStatus status,
                        bool add_as_child,
                        const char *filename,
@@ -1013,7 +1267,7 @@ bool C4Group::Close()
 
 	// Set new version
 	Head.Ver1 = C4GroupFileVer1;
-	Head.Ver2 = C4GroupFileVer2;
+	Head.Ver2 = p->SaveSeekable ? C4GroupFileVer2Seekable : C4GroupFileVer2;
 
 	// Automatic sort
 	SortByList(C4Group_SortList);
@@ -1044,13 +1298,16 @@ bool C4Group::Save(bool reopen)
 			save_core[core_index]=(C4GroupEntryCore)*entry;
 			// Make actual offset
 			save_core[core_index].Offset = contents_size;
+			save_core[core_index].Packed = save_core[core_index].PackedSize = 0;
 			contents_size += entry->Size;
 			core_index++;
 		}
 	}
 
 	// Hold contents in memory?
-	bool hold_in_memory = !reopen && p->Mother && contents_size < C4GroupSwapThreshold;
+	// (Folders would store a seekable child compressed)
+	bool hold_in_memory = !reopen && p->Mother && contents_size < C4GroupSwapThreshold
+	                   && !(p->SaveSeekable && p->Mother->p->SourceType == P::ST_Unpacked);
 	if (!hold_in_memory)
 	{
 		// Create target temp file (in temp directory!)
@@ -1074,46 +1331,59 @@ bool C4Group::Save(bool reopen)
 	}
 
 	// Create the new (temp) group file
+	// Seekable groups compress each entry on its own
 	CStdFile temp_file;
-	if (!temp_file.Create(temp_filename, true, false, hold_in_memory))
+	if (!temp_file.Create(temp_filename, !p->SaveSeekable, false, hold_in_memory))
 	{
 		delete [] save_core;
 		return Error("Close: ...");
 	}
 
-	// Save header and core list
-	C4GroupHeader header_buffer = Head;
-	MemScramble((BYTE*)&header_buffer, sizeof(C4GroupHeader));
-	if (!temp_file.Write((BYTE*)&header_buffer, sizeof(C4GroupHeader))
-	 || !temp_file.Write((BYTE*)save_core, Head.Entries*sizeof(C4GroupEntryCore)))
+	if (p->SaveSeekable)
 	{
-		temp_file.Close();
 		delete [] save_core;
-		return Error("Close: ...");
-	}
-	delete [] save_core;
-
-	// Save Entries to temp file
-	int total_size = 0;
-	for (C4GroupEntry *entry = p->FirstEntry; entry; entry = entry->Next)
-	{
-		total_size += entry->Size;
+		if (!SaveSeekableContents(temp_file))
+		{
+			temp_file.Close();
+			return false;
+		}
 	}
-	int size_done = 0;
-	for (C4GroupEntry *entry = p->FirstEntry; entry; entry = entry->Next)
+	else
 	{
-		if (AppendEntry2StdFile(entry, temp_file))
+		// Save header and core list
+		C4GroupHeader header_buffer = Head;
+		MemScramble((BYTE*)&header_buffer, sizeof(C4GroupHeader));
+		if (!temp_file.Write((BYTE*)&header_buffer, sizeof(C4GroupHeader))
+		 || !temp_file.Write((BYTE*)save_core, Head.Entries*sizeof(C4GroupEntryCore)))
 		{
-			size_done += entry->Size;
-			if (total_size && p->ProcessCallback)
-			{
-				p->ProcessCallback(entry->FileName, 100 * size_done / total_size);
-			}
+			temp_file.Close();
+			delete [] save_core;
+			return Error("Close: ...");
 		}
-		else
+		delete [] save_core;
+
+		// Save Entries to temp file
+		int total_size = 0;
+		for (C4GroupEntry *entry = p->FirstEntry; entry; entry = entry->Next)
 		{
-			temp_file.Close();
-			return false;
+			total_size += entry->Size;
+		}
+		int size_done = 0;
+		for (C4GroupEntry *entry = p->FirstEntry; entry; entry = entry->Next)
+		{
+			if (AppendEntry2StdFile(entry, temp_file))
+			{
+				size_done += entry->Size;
+				if (total_size && p->ProcessCallback)
+				{
+					p->ProcessCallback(entry->FileName, 100 * size_done / total_size);
+				}
+			}
+			else
+			{
+				temp_file.Close();
+				return false;
+			}
 		}
 	}
 
@@ -1170,6 +1440,157 @@ bool C4Group::Save(bool reopen)
 	return true;
 }
 
+bool C4Group::IsSeekableChildGroup(C4GroupEntry *entry)
+{
+	// Only child groups that can be read by position are checked
+	if (!entry->ChildGroup || !p->RandomAccess || entry->Status != C4GroupEntry::C4GRES_InGroup || (p->Seekable && entry->Packed))
+	{
+		return false;
+	}
+	C4GroupHeader header;
+	if (!ReadAt(p->EntryOffset + entry->Offset, &header, sizeof(C4GroupHeader)))
+	{
+		return false;
+	}
+	MemScramble((BYTE*)&header, sizeof(C4GroupHeader));
+	return header.Ver2 == C4GroupFileVer2Seekable;
+}
+
+bool C4Group::SaveSeekableContents(CStdFile &target)
+{
+	// Header first, the index of all entries goes to the end
+	C4GroupHeader header_buffer = Head;
+	MemScramble((BYTE*)&header_buffer, sizeof(C4GroupHeader));
+	if (!target.Write((BYTE*)&header_buffer, sizeof(C4GroupHeader)))
+	{
+		return Error("Close: Cannot write header");
+	}
+
+	// Save each entry as a block of its own
+	int total_size = 0;
+	for (C4GroupEntry *entry = p->FirstEntry; entry; entry = entry->Next)
+	{
+		total_size += entry->Size;
+	}
+	int size_done = 0;
+	int32_t position = sizeof(C4GroupHeader);
+	std::vector<C4GroupEntryCore> index;
+	std::vector<BYTE> block;
+	for (C4GroupEntry *entry = p->FirstEntry; entry; entry = entry->Next)
+	{
+		if (entry->Status == C4GroupEntry::C4GRES_Deleted) continue;
+		C4GroupEntryCore core = *entry;
+		if (entry->Status == C4GroupEntry::C4GRES_InGroup && p->Seekable)
+		{
+			// Blocks of seekable groups are copied as they are
+			block.resize(entry->PackedSize);
+			if (!ReadAt(entry->Offset, block.data(), block.size()))
+			{
+				return Error("Close: Cannot read entry from group file");
+			}
+		}
+		else
+		{
+			CStdFile entry_file;
+			StdBuf *data;
+			if (!entry_file.Create("", false, false, true) || !AppendEntry2StdFile(entry, entry_file))
+			{
+				entry_file.Close();
+				return false;
+			}
+			entry_file.Close(&data);
+			const BYTE *bytes = static_cast<const BYTE *>(data->getData());
+			core.Size = data->getSize();
+			// Child groups in the seekable format must stay readable by position
+			bool is_seekable_group = false;
+			if (entry->ChildGroup && data->getSize() >= sizeof(C4GroupHeader))
+			{
+				C4GroupHeader child_head;
+				memcpy(&child_head, bytes, sizeof(C4GroupHeader));
+				MemScramble((BYTE*)&child_head, sizeof(C4GroupHeader));
+				is_seekable_group = (child_head.Ver2 == C4GroupFileVer2Seekable);
+			}
+			// Compress unless that does not save anything
+			core.Packed = false;
+			if (!is_seekable_group && data->getSize())
+			{
+				uLongf packed_size = compressBound(data->getSize());
+				block.resize(packed_size);
+				if (compress2(block.data(), &packed_size, bytes, data->getSize(), Z_DEFAULT_COMPRESSION) == Z_OK
+				 && packed_size < data->getSize())
+				{
+					block.resize(packed_size);
+					core.Packed = true;
+				}
+			}
+			if (!core.Packed)
+			{
+				block.assign(bytes, bytes + data->getSize());
+			}
+			delete data;
+		}
+		core.Offset = position;
+		core.PackedSize = block.size();
+		if (!block.empty() && !target.Write(block.data(), block.size()))
+		{
+			return Error("Close: Cannot write entry");
+		}
+		position += block.size();
+		index.push_back(core);
+		size_done += entry->Size;
+		if (total_size && p->ProcessCallback)
+		{
+			p->ProcessCallback(entry->FileName, 100 * size_done / total_size);
+		}
+	}
+
+	// Index
+	if (index.size() != size_t(Head.Entries))
+	{
+		return Error("Close: Entry count mismatch");
+	}
+	if (!index.empty() && !target.Write((BYTE*)index.data(), index.size() * sizeof(C4GroupEntryCore)))
+	{
+		return Error("Close: Cannot write index");
+	}
+	return true;
+}
+
+bool C4Group::SetSeekable(bool seekable)
+{
+	if (p->SourceType != P::ST_Packed)
+	{
+		return Error("SetSeekable: Only packed groups can be converted");
+	}
+	// Convert child groups first, so that they can be read in place
+	for (C4GroupEntry *entry = p->FirstEntry; entry; entry = entry->Next)
+	{
+		if (entry->ChildGroup && entry->Status == C4GroupEntry::C4GRES_InGroup)
+		{
+			C4Group child;
+			if (!child.OpenAsChild(this, entry->FileName))
+			{
+				return Error("SetSeekable: Cannot open child group");
+			}
+			if (!child.SetSeekable(seekable) || !child.Close())
+			{
+				return Error("SetSeekable: Cannot convert child group");
+			}
+		}
+	}
+	if (p->SaveSeekable != seekable)
+	{
+		p->SaveSeekable = seekable;
+		p->Modified = true;
+	}
+	return true;
+}
+
+bool C4Group::IsSeekable() const
+{
+	return p->SaveSeekable;
+}
+
 void C4Group::Clear()
 {
 	if (p)
@@ -1204,6 +1625,25 @@ bool C4Group::AppendEntry2StdFile(C4GroupEntry *entry, CStdFile &target)
 	{
 
 	case C4GroupEntry::C4GRES_InGroup: // Copy from group to std file
+		if (p->RandomAccess)
+		{
+			if (!SetFilePtr2Entry(entry->FileName, !!entry->ChildGroup))
+				return Error("AE2S: Cannot set file pointer");
+			BYTE chunk[16384];
+			for (long current_size = entry->Size; current_size > 0; current_size -= sizeof(chunk))
+			{
+				size_t chunk_size = std::min<size_t>(current_size, sizeof(chunk));
+				if (!Read(chunk, chunk_size))
+				{
+					return Error("AE2S: Cannot read entry from group file");
+				}
+				if (!target.Write(chunk, chunk_size))
+				{
+					return Error("AE2S: Cannot write to target file");
+				}
+			}
+			break;
+		}
 		if (!SetFilePtr(entry->Offset))
 			return Error("AE2S: Cannot set file pointer");
 		for (long current_size = entry->Size; current_size > 0; current_size--)
@@ -1259,7 +1699,9 @@ bool C4Group::AppendEntry2StdFile(C4GroupEntry *entry, CStdFile &target)
 		}
 
 		// Append disk source to target file
-		if (!source.Open(file_source, !!entry->ChildGroup))
+		// (Seekable groups are not compressed as a whole)
+		if (!source.Open(file_source, !!entry->ChildGroup)
+		 && !(entry->ChildGroup && source.Open(file_source, false)))
 		{
 			return Error("AE2S: Cannot open on-disk file");
 		}
@@ -1420,6 +1862,11 @@ bool C4Group::Advance(int offset)
 	}
 	// uncached advance
 	if (p->SourceType == P::ST_Unpacked) return !!p->StdFile.Advance(offset);
+	if (p->RandomAccess)
+	{
+		p->ReadPos += offset;
+		return true;
+	}
 	// FIXME: reading the file one byte at a time sounds just slow.
 	BYTE buf;
 	for (; offset>0; offset--)
@@ -1442,6 +1889,14 @@ bool C4Group::Read(void *buffer, size_t size)
 	switch (p->SourceType)
 	{
 	case P::ST_Packed:
+		// Random access
+		if (p->RandomAccess)
+		{
+			if (!ReadAt(p->ReadPos, buffer, size))
+				return Error("Read:");
+			p->ReadPos += size;
+			break;
+		}
 		// Child group: read from mother group
 		if (p->Mother)
 		{
@@ -1467,6 +1922,10 @@ bool C4Group::Read(void *buffer, size_t size)
 
 bool C4Group::AdvanceFilePtr(int offset)
 {
+	if (p->RandomAccess)
+	{
+		return Advance(offset);
+	}
 	// Child group file: pass command to mother
 	if ((p->SourceType == P::ST_Packed) && p->Mother)
 	{
@@ -1909,7 +2368,7 @@ bool C4Group::ExtractEntry(const char *filename, const char *destination)
 		SCopy(target_file_name, temp_file_name, _MAX_FNAME);
 		MakeTempFilename(temp_file_name);
 		// Create temp target file
-		if (!temp_file.Create(temp_file_name, !!entry->ChildGroup, !!entry->Executable))
+		if (!temp_file.Create(temp_file_name, !!entry->ChildGroup && !IsSeekableChildGroup(entry), !!entry->Executable))
 		{
 			return Error("Extract: Cannot create target file");
 		}
@@ -2017,6 +2476,7 @@ bool C4Group::OpenAsChild(C4Group *mother, const char *entry_name, bool is_exclu
 		{
 			// Create - will be added to mother in Close()
 			p->SourceType = P::ST_Packed;
+			p->SaveSeekable = p->Mother->p->SaveSeekable;
 			p->Modified = true;
 			return true;
 		}
@@ -2051,13 +2511,53 @@ bool C4Group::OpenAsChild(C4Group *mother, const char *entry_name, bool is_exclu
 	// Check Header
 	if (!SEqual(Head.Id, C4GroupFileID)
 	|| (Head.Ver1 != C4GroupFileVer1)
-	|| (Head.Ver2 > C4GroupFileVer2))
+	|| (Head.Ver2 > C4GroupFileVer2Seekable))
 	{
 		CloseExclusiveMother();
 		Clear();
 		return Error("OpenAsChild: Invalid Header");
 	}
 
+	// Seekable groups and all groups inside them are read by position
+	if (Head.Ver2 == C4GroupFileVer2Seekable || p->Mother->p->RandomAccess)
+	{
+		C4Group *mother = p->Mother;
+		bool okay = true;
+		if (mother->p->RandomAccess && !mother->p->pInMemEntry)
+		{
+			// Stored uncompressed in the mother: read from there
+			p->MotherOffset = mother->p->ReadPos - sizeof(C4GroupHeader);
+		}
+		else if (mother->p->SourceType == P::ST_Unpacked && !mother->p->StdFile.IsCompressed())
+		{
+			// Group file in a folder
+			okay = p->StdFile.Open(GetFullName().getData(), false);
+			size = FileSize(GetFullName().getData());
+		}
+		else
+		{
+			// Inside a compressed stream: load into memory
+			if (mother->p->SourceType == P::ST_Unpacked)
+			{
+				size = UncompressedFileSize(GetFullName().getData());
+			}
+			p->GroupData.resize(std::max(size, sizeof(C4GroupHeader)));
+			C4GroupHeader header_buffer = Head;
+			MemScramble((BYTE*)&header_buffer, sizeof(C4GroupHeader));
+			memcpy(p->GroupData.data(), &header_buffer, sizeof(C4GroupHeader));
+			okay = size >= sizeof(C4GroupHeader) && p->Mother->Read(&p->GroupData[sizeof(C4GroupHeader)], size - sizeof(C4GroupHeader));
+		}
+		if (!okay || !OpenRandomAccess(size))
+		{
+			CloseExclusiveMother();
+			Clear();
+			return Error("OpenAsChild: Cannot read group");
+		}
+		ResetSearch();
+		p->SourceType = P::ST_Packed;
+		return true;
+	}
+
 	// Read Entries
 	C4GroupEntryCore buffer;
 	int file_entries = Head.Entries;
@@ -2193,6 +2693,10 @@ bool C4Group::SetFilePtr2Entry(const char *entry_name, bool needs_to_be_a_group)
 		{
 			return false;
 		}
+		if (p->RandomAccess)
+		{
+			return SetFilePtr2RandomAccessEntry(entry);
+		}
 		return SetFilePtr(entry->Offset);
 
 	case P::ST_Unpacked:
@@ -2201,7 +2705,12 @@ bool C4Group::SetFilePtr2Entry(const char *entry_name, bool needs_to_be_a_group)
 		SCopy(GetName(),path, _MAX_FNAME);
 		AppendBackslash(path);
 		SAppend(entry_name, path);
-		return p->StdFile.Open(path, needs_to_be_a_group);
+		if (p->StdFile.Open(path, needs_to_be_a_group))
+		{
+			return true;
+		}
+		// Seekable groups are not compressed as a whole
+		return needs_to_be_a_group && p->StdFile.Open(path, false);
 
 	default: break; // InGrp & Deleted ignored
 	}
@@ -2427,6 +2936,65 @@ bool C4Group::LoadEntry(const char *entry_name, StdBuf * buffer)
 	return true;
 }
 
+bool C4Group::LoadEntryView(const char *entry_name, C4GroupEntryView *view)
+{
+	view->Clear();
+	StdStrBuf name, filename;
+	size_t size, offset;
+	if (!FindEntry(entry_name, &name, &size))
+	{
+		return Error("LoadEntry: Not found");
+	}
+	// Map entries that are stored uncompressed in a file
+	if (size && GetEntryFileRegion(name.getData(), &filename, &offset) && view->Map(filename.getData(), offset, size))
+	{
+		return true;
+	}
+	// Everything else is loaded
+	view->Store = std::make_shared<C4GroupEntryView::Storage>();
+	if (!LoadEntry(name.getData(), &view->Store->Buffer))
+	{
+		view->Clear();
+		return false;
+	}
+	view->Data = static_cast<const BYTE *>(view->Store->Buffer.getData());
+	view->Size = view->Store->Buffer.getSize();
+	return true;
+}
+
+bool C4Group::GetEntryFileRegion(const char *entry_name, StdStrBuf *filename, size_t *offset)
+{
+	// Files in folders
+	if (p->SourceType == P::ST_Unpacked)
+	{
+		filename->Format("%s%c%s", GetName(), DirectorySeparator, entry_name);
+		*offset = 0;
+		return !DirectoryExists(filename->getData());
+	}
+	// Entries stored without compression in groups that are read by position
+	C4GroupEntry *entry = GetEntry(entry_name);
+	if (p->SourceType != P::ST_Packed || !p->RandomAccess || !entry || entry->MemoryBuffer
+	 || entry->Status != C4GroupEntry::C4GRES_InGroup || (p->Seekable && entry->Packed))
+	{
+		return false;
+	}
+	// Find the file the group data is in (see ReadAt)
+	size_t position = p->EntryOffset + entry->Offset;
+	C4Group *group = this;
+	while (group->p->GroupData.empty() && !group->p->StdFile.IsOpen() && group->p->Mother)
+	{
+		position += group->p->MotherOffset;
+		group = group->p->Mother;
+	}
+	if (!group->p->GroupData.empty() || !group->p->StdFile.IsOpen() || group->p->StdFile.IsCompressed())
+	{
+		return false;
+	}
+	filename->Copy(group->p->StdFile.Name);
+	*offset = position;
+	return true;
+}
+
 bool C4Group::LoadEntryString(const char *entry_name, StdStrBuf *buffer)
 {
 	size_t size;
@@ -2841,8 +3409,8 @@ int C4Group::PreCacheEntries(const char *search_pattern, bool cache_previous)
 			continue;
 		}
 		// if desired, cache all entries up to that one to allow rewind in unpacked memory
-		// (only makes sense for groups)
-		if (cache_previous && p->SourceType == P::ST_Packed)
+		// (only makes sense for groups that are not read by position)
+		if (cache_previous && p->SourceType == P::ST_Packed && !p->RandomAccess)
 		{
 			for (C4GroupEntry * e_pre = p->FirstEntry; e_pre != entry; e_pre = e_pre->Next)
 			{
@@ -2869,6 +3437,11 @@ void C4Group::PreCacheEntry(C4GroupEntry * entry)
 	{
 		return;
 	}
+	// groups read by position don't need to avoid rewinds, load when accessed
+	if (p->RandomAccess)
+	{
+		return;
+	}
 	// now load it!
 	StdBuf buffer;
 	if (!this->LoadEntry(entry->FileName, &buffer))
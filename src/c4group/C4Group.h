@@ -41,8 +41,9 @@
 // sort order lists in C4Components.h accordingly, and enforce a reading order for that
 // component.
 //
-// Maybe some day, someone will write a C4Group-implementation that is probably capable of
-// random access...
+// Groups in the seekable format (C4GroupFileVer2Seekable) don't have this problem: Their
+// entries are compressed separately and located through an index at the end of the group,
+// so they are read by position. Child groups of seekable groups are read the same way.
 #ifdef _DEBUG
 extern int iC4GroupRewindFilePtrNoWarn;
 #define C4GRP_DISABLE_REWINDWARN ++iC4GroupRewindFilePtrNoWarn;
@@ -54,6 +55,7 @@ extern int iC4GroupRewindFilePtrNoWarn;
 
 const int C4GroupFileVer1 = 1;
 const int C4GroupFileVer2 = 2;
+const int C4GroupFileVer2Seekable = 3; // uncompressed header, separately compressed entries, index at the end
 
 const int C4GroupMaxError = 100;
 
@@ -96,7 +98,7 @@ struct C4GroupEntryCore
 	int32_t ChildGroup = 0;
 	int32_t Size = 0;
 	int32_t Offset = 0;
-	int32_t Reserved1 = 0;
+	int32_t PackedSize = 0; // seekable groups: size of the entry data in the file
 	int32_t Reserved2 = 0;
 	char Reserved3 = '\0';
 	unsigned int Reserved4 = 0;
@@ -132,6 +134,26 @@ public:
 	void Set(const DirectoryIterator & directories, const char * path);
 };
 
+// Read-only view of the contents of a group entry. Entries stored uncompressed
+// in a file are memory-mapped instead of copied; copies of a view share the data.
+class C4GroupEntryView
+{
+public:
+	const BYTE *getData() const { return Data; }
+	size_t getSize() const { return Size; }
+	bool isMapped() const;
+	StdBuf getBuf() const { return StdBuf(Data, Size); } // reference, valid while the view exists
+	void Clear();
+
+private:
+	struct Storage;
+	std::shared_ptr<Storage> Store;
+	const BYTE *Data = nullptr;
+	size_t Size = 0;
+	bool Map(const char *filename, size_t offset, size_t size);
+	friend class C4Group;
+};
+
 class C4Group : public CStdStream
 {
 	struct P;
@@ -183,6 +205,7 @@ public:
 	bool LoadEntry(const char *entry_name, StdBuf * buffer);
 	bool LoadEntry(const StdStrBuf & name, StdBuf * buffer) { return LoadEntry(name.getData(), buffer); }
 	bool LoadEntryString(const char *entry_name, StdStrBuf * buffer);
+	bool LoadEntryView(const char *entry_name, C4GroupEntryView *view); // zero-copy where possible
 	bool LoadEntryString(const StdStrBuf & name, StdStrBuf * buffer) { return LoadEntryString(name.getData(), buffer); }
 	bool FindEntry(const char *wildcard,
 	               StdStrBuf *filename = nullptr,
@@ -231,6 +254,8 @@ public:
 	bool HasPackedMother() const;
 	bool SetNoSort(bool no_sorting);
 	int PreCacheEntries(const char *search_pattern, bool cache_previous = false); // pre-load entries to memory. return number of loaded entries.
+	bool SetSeekable(bool seekable); // convert group and child groups to or from the seekable format when closed
+	bool IsSeekable() const;
 
 	const C4GroupHeader &GetHeader() const;
 	const C4GroupEntry *GetFirstEntry() const;
@@ -257,6 +282,12 @@ private:
 	              bool buffer_is_stdbuf = false);
 	bool AddEntryOnDisk(const char *filename, const char *entry_name = nullptr, bool move = false);
 	bool SetFilePtr2Entry(const char *entry_name, bool needs_to_be_a_group = false);
+	bool OpenRandomAccess(size_t size);
+	bool ReadAt(size_t position, void *buffer, size_t size);
+	bool SetFilePtr2RandomAccessEntry(C4GroupEntry *entry);
+	bool IsSeekableChildGroup(C4GroupEntry *entry);
+	bool GetEntryFileRegion(const char *entry_name, StdStrBuf *filename, size_t *offset);
+	bool SaveSeekableContents(CStdFile &target);
 	bool AppendEntry2StdFile(C4GroupEntry *entry, CStdFile &target);
 	C4GroupEntry *SearchNextEntry(const char *entry_name);
 	C4GroupEntry *GetNextFolderEntry();
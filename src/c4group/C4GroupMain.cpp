@@ -108,6 +108,7 @@ void PrintGroupInternals(C4Group &grp, int indent_level = 0)
 		printf("%*s  ChildGroup: %d\n", indent, "", p->ChildGroup);
 		printf("%*s  Size: %d\n", indent, "", p->Size);
 		printf("%*s  Offset: %d\n", indent, "", p->Offset);
+		printf("%*s  PackedSize: %d\n", indent, "", p->PackedSize);
 		printf("%*s  Executable: %d\n", indent, "", p->Executable);
 		if (p->ChildGroup != 0)
 		{
@@ -234,6 +235,30 @@ bool ProcessGroup(const char *FilenamePar)
 							fprintf(stderr, "Reopen failed: %s\n", hGroup.GetError());
 						}
 						break;
+						// Convert
+					case 'c':
+						if ((iArg + 1 >= argc) || (!SEqual(argv[iArg + 1], "seekable") && !SEqual(argv[iArg + 1], "legacy")))
+						{
+							fprintf(stderr, "Convert failed: format must be seekable or legacy\n");
+							break;
+						}
+						++iArg;
+						Log("Converting...");
+						if (!hGroup.SetSeekable(SEqual(argv[iArg], "seekable")))
+						{
+							fprintf(stderr, "Convert failed: %s\n", hGroup.GetError());
+						}
+						// Close
+						else if (!hGroup.Close())
+						{
+							fprintf(stderr, "Closing failed: %s\n", hGroup.GetError());
+						}
+						// Reopen
+						else if (!hGroup.Open(szFilename))
+						{
+							fprintf(stderr, "Reopen failed: %s\n", hGroup.GetError());
+						}
+						break;
 						// Unpack
 					case 'u':
 						LogF("Unpacking...");
@@ -548,6 +573,7 @@ int main(int argc, char *argv[])
 		printf("          -u Unpack\n");
 		printf("          -p Pack\n");
 		printf("          -t [filename] Pack To\n");
+		printf("          -c [seekable|legacy] Convert packed group format\n");
 		printf("          -y [ppid] Apply update (waiting for ppid to terminate first)\n");
 		printf("          -g [source] [target] [title] Make update\n");
 		printf("          -s Sort\n");
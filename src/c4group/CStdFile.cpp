@@ -309,6 +309,8 @@ int CStdFile::Seek(long int offset, int whence)
 {
 	// seek in file by offset and stdio-style SEEK_* constants. Only implemented for uncompressed files.
 	assert(!hgzFile);
+	// discard data read ahead from the old position
+	if (!ModeWrite) ClearBuffer();
 	return fseek(hFile, offset, whence);
 }
 
@@ -68,6 +68,8 @@ void C4ConfigGeneral::CompileFunc(StdCompiler *compiler)
 	compiler->Value(mkNamingAdapt(ScreenshotFolder,    "ScreenshotFolder",   "Screenshots",  false, true));
 	compiler->Value(mkNamingAdapt(ModsFolder,          "ModsFolder",         "mods",  false, true));
 	compiler->Value(mkNamingAdapt(ScrollSmooth,        "ScrollSmooth",       4              ));
+	compiler->Value(mkNamingAdapt(ScriptCache,         "ScriptCache",        1              ));
+	compiler->Value(mkNamingAdapt(ScriptTierUp,        "ScriptTierUp",       100            ));
 	compiler->Value(mkNamingAdapt(AlwaysDebug,         "DebugMode",          0              ));
 	compiler->Value(mkNamingAdapt(OpenScenarioInGameMode, "OpenScenarioInGameMode", 0   )); 
 #ifdef _WIN32
@@ -143,6 +145,8 @@ void C4ConfigGraphics::CompileFunc(StdCompiler *compiler)
 	compiler->Value(mkNamingAdapt(MultiSampling,         "MultiSampling",        4             ));
 	compiler->Value(mkNamingAdapt(AutoFrameSkip,         "AutoFrameSkip",        1          ));
 	compiler->Value(mkNamingAdapt(MouseCursorSize,       "MouseCursorSize",      50            ));
+	compiler->Value(mkNamingAdapt(MeshPoseCache,         "MeshPoseCache",        1             ));
+	compiler->Value(mkNamingAdapt(MeshPoseCacheQuantum,  "MeshPoseCacheQuantum", 0             ));
 }
 
 void C4ConfigSound::CompileFunc(StdCompiler *compiler)
@@ -174,6 +178,7 @@ void C4ConfigNetwork::CompileFunc(StdCompiler *compiler)
 	compiler->Value(mkNamingAdapt(ControlMode,             "ControlMode",          0             ));
 	compiler->Value(mkNamingAdapt(Nick,                    "Nick",                 ""            ,false, true));
 	compiler->Value(mkNamingAdapt(MaxLoadFileSize,         "MaxLoadFileSize",      5*1024*1024   ,false, true));
+	compiler->Value(mkNamingAdapt(ResCacheSize,            "ResCacheSize",         1024          ,false, true));
 
 	compiler->Value(mkNamingAdapt(MasterServerSignUp,      "MasterServerSignUp",   1             ));
 	compiler->Value(mkNamingAdapt(MasterServerActive,      "MasterServerActive",   0             ));
@@ -49,6 +49,8 @@ public:
 	int32_t DefRec;
 	int32_t MMTimer;  // use multimedia-timers
 	int32_t ScrollSmooth; // view movement smoothing
+	int32_t ScriptCache; // if nonzero, parsed scripts are kept in the user path and reused while unchanged
+	int32_t ScriptTierUp; // number of calls and loop iterations after which script functions get specialized bytecode; 0 disables
 	int32_t ConfigResetSafety; // safety value: If this value is screwed, the config got corrupted and must be reset
 	// Determined at run-time
 	StdCopyStrBuf ExePath;
@@ -116,6 +118,8 @@ public:
 	int32_t AutoFrameSkip; // if true, gfx frames are skipped when they would slow down the game
 	int32_t DebugOpenGL; // if true, enables OpenGL debugging
 	int32_t MouseCursorSize; // size in pixels
+	int32_t MeshPoseCache; // if true, mesh instances in the same animation state share their bone transformations
+	int32_t MeshPoseCacheQuantum; // animation positions are rounded to multiples of this (ms) for the pose cache; 0 = exact
 
 	void CompileFunc(StdCompiler *compiler);
 };
@@ -155,6 +159,7 @@ public:
 	int32_t ControlMode;
 	ValidatedStdCopyStrBuf<C4InVal::VAL_NameAllowEmpty> Nick;
 	int32_t MaxLoadFileSize;
+	int32_t ResCacheSize; // packed local resources kept between games (MB), 0 to disable
 	char LastPassword[CFG_MaxString+1];
 	char AlternateServerAddress[CFG_MaxString+1];
 	char PuncherAddress[CFG_MaxString+1];
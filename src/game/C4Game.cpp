@@ -146,6 +146,14 @@ bool C4Game::InitDefs()
 	// Load for scenario file - ignore sys group here, because it has been loaded already
 	def_count += ::Definitions.Load(ScenarioFile, C4D_Load_RX, Config.General.LanguageEx,&Application.SoundSystem, true, true, 35, 40, false);
 
+	// startup timing report
+	const C4DefListLoadTimes &times = ::Definitions.LoadTimes;
+	auto ms = [](C4DefListLoadTimes::Duration duration) { return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count()); };
+	LogF("C4DefList definitions - %d loaded in %d ms: read %d ms, materials %d ms, defcore %d ms, sounds %d ms, graphics %d ms, script %d ms",
+		def_count, ms(times.Total), ms(times.Read), ms(times.Materials), ms(times.DefCore), ms(times.Sounds), ms(times.Graphics), ms(times.Script));
+	LogF("C4DefList images - %d of %d used, decoded on %d worker threads in %d ms, read ahead in %d ms, waited for %d ms",
+		times.PrefetchedImageCnt, times.ImageCnt, times.ThreadCnt, ms(times.Decode), ms(times.Prefetch), ms(times.DecodeWait));
+
 	// Absolutely no defs: we don't like that
 	if (!def_count)
 	{
@@ -418,6 +426,10 @@ bool C4Game::Init()
 	// Store a start time that identifies this game on this host
 	StartTime = time(nullptr);
 
+	// Share bone transformations of mesh instances in the same animation state
+	::MeshPoseCache.SetEnabled(!!Config.Graphics.MeshPoseCache);
+	::MeshPoseCache.SetTimeQuantum(Config.Graphics.MeshPoseCacheQuantum / 1000.0f);
+
 	// Get PlayerFilenames from Config, if ParseCommandLine did not fill some in
 	// Must be done here, because InitGame calls PlayerInfos.InitLocal
 	if (!*PlayerFilenames)
@@ -683,6 +695,15 @@ void C4Game::Clear()
 	C4ST_SHOWSTAT
 	// C4ST_RESET
 
+	// mesh pose cache report
+	if (::MeshPoseCache.HitCnt + ::MeshPoseCache.MissCnt)
+	{
+		const unsigned int lookups = ::MeshPoseCache.HitCnt + ::MeshPoseCache.MissCnt;
+		LogF("StdMeshPoseCache - %u of %u bone pose evaluations shared (%u%%), %u entries at most",
+			::MeshPoseCache.HitCnt, lookups, static_cast<unsigned int>(uint64_t(::MeshPoseCache.HitCnt) * 100 / lookups), ::MeshPoseCache.MaxEntryCnt);
+	}
+	::MeshPoseCache.Clear();
+
 	// Evaluation
 	if (GameOver)
 	{
@@ -913,6 +934,7 @@ bool C4Game::Execute() // Returns true if the game is over
 
 	// Game
 
+	::MeshPoseCache.NextFrame();
 	EXEC_S(     ExecObjects();                    , ExecObjectsStat )
 	EXEC_S_DR(  C4Effect::Execute(&ScriptEngine.pGlobalEffects);
 	            C4Effect::Execute(&GameScript.pScenarioEffects);
@@ -1431,7 +1453,7 @@ C4Object* C4Game::FindConstuctionSiteBlock(int32_t x, int32_t y, int32_t wdt, in
 	C4LArea Area(&::Objects.Sectors, x, y, wdt, hgt);
 	C4LSector *sector;
 
-	for (C4ObjectList *objects = Area.FirstObjectShapes(&sector); sector; objects = Area.NextObjectShapes(objects, &sector))
+	for (C4SectorObjectList *objects = Area.FirstObjectShapes(&sector); sector; objects = Area.NextObjectShapes(objects, &sector))
 	{
 		for (C4Object *obj : *objects)
 		{
@@ -2987,6 +3009,14 @@ bool C4Game::InitGameFinal(InitMode init_mode)
 
 bool C4Game::InitScriptEngine()
 {
+	// parsed script cache
+	if (Config.General.ScriptCache)
+		ScriptEngine.ScriptCache.Init(Config.AtUserDataPath(C4CFN_ScriptCache), C4VERSION);
+	else
+		ScriptEngine.ScriptCache.Disable();
+	// specialized bytecode for hot functions
+	ScriptEngine.TierUpThreshold = std::max<int32_t>(Config.General.ScriptTierUp, 0);
+
 	// engine functions
 	InitCoreFunctionMap(&ScriptEngine);
 	InitObjectFunctionMap(&ScriptEngine);
@@ -3042,6 +3072,11 @@ bool C4Game::LinkScriptEngine()
 		ScriptEngine.lineCnt, (ScriptEngine.lineCnt != 1 ? "s" : ""),
 		ScriptEngine.warnCnt, (ScriptEngine.warnCnt != 1 ? "s" : ""),
 		ScriptEngine.errCnt, (ScriptEngine.errCnt != 1 ? "s" : ""));
+	// startup timing report
+	const C4AulScriptCache &cache = ScriptEngine.ScriptCache;
+	LogF("C4AulScriptEngine scripts - %d parsed in %d ms, %d loaded from cache in %d ms",
+		cache.ParsedCnt, static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(cache.ParseTime).count()),
+		cache.LoadedCnt, static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(cache.LoadTime).count()));
 
 	// update material pointers
 	::MaterialMap.UpdateScriptPointers();
@@ -0,0 +1,178 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2019, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Decodes PNG group entries on worker threads before they are needed */
+
+#include "C4Include.h"
+#include "graphics/C4PNGPrefetch.h"
+
+#include "graphics/StdPNG.h"
+#include "platform/C4ThreadPool.h"
+
+// number of images workers may decode ahead of the last requested one
+static const size_t C4PNGPrefetchWindow = 64;
+
+C4PNGPrefetch::C4PNGPrefetch() : DecodedEvent(false), WindowEvent(true) { }
+
+C4PNGPrefetch::~C4PNGPrefetch()
+{
+	Clear();
+}
+
+std::string C4PNGPrefetch::GetKey(C4Group &group, const char *entry_name)
+{
+	std::string key(group.GetFullName().getData());
+	key += DirectorySeparator;
+	key += entry_name;
+	return key;
+}
+
+bool C4PNGPrefetch::Add(C4Group &group, const char *entry_name, int32_t set)
+{
+	assert(!Pool);
+	Image image;
+	image.Set = set;
+	if (!group.LoadEntryView(entry_name, &image.Data)) return false;
+	Index[GetKey(group, entry_name)] = Images.size();
+	Images.push_back(std::move(image));
+	return true;
+}
+
+void C4PNGPrefetch::Start()
+{
+	QueuedCnt = Images.size(); TakenCnt = 0;
+	DecodeTime = WaitTime = Duration::zero();
+	Pool = std::make_unique<C4ThreadPool>();
+	ThreadCnt = Pool->GetThreadCount();
+	// without workers, images are decoded when requested
+	if (Pool->GetThreadCount())
+		Pool->Start(Images.size(), [this](size_t index) { DecodeImage(index); });
+}
+
+void C4PNGPrefetch::Clear()
+{
+	if (Pool)
+	{
+		// let waiting workers skip their remaining images
+		ImageLock.Enter();
+		Aborted = true;
+		WindowEvent.Set();
+		ImageLock.Leave();
+		Pool->Wait();
+		Pool.reset();
+	}
+	Images.clear();
+	Index.clear();
+	Requested = Released = 0;
+	Aborted = false;
+	WindowEvent.Reset();
+}
+
+void C4PNGPrefetch::Decode(Image &image)
+{
+	auto start = std::chrono::steady_clock::now();
+	auto png = std::make_unique<CPNGFile>();
+	if (!png->Load(const_cast<BYTE *>(image.Data.getData()), image.Data.getSize()))
+		png.reset();
+	image.Data.Clear();
+	Duration duration = std::chrono::steady_clock::now() - start;
+	CStdLock lock(&ImageLock);
+	image.PNG = std::move(png);
+	image.State = IS_Decoded;
+	DecodeTime += duration;
+	DecodedEvent.Set();
+}
+
+void C4PNGPrefetch::DecodeImage(size_t index)
+{
+	ImageLock.Enter();
+	Image &image = Images[index];
+	// stay within the window ahead of the requests
+	while (!Aborted && image.State == IS_Queued && index >= Requested + C4PNGPrefetchWindow)
+	{
+		WindowEvent.Reset();
+		ImageLock.Leave();
+		WindowEvent.WaitFor(INFINITE);
+		ImageLock.Enter();
+	}
+	// skip images that have been requested or dropped in the meantime
+	if (Aborted || image.State != IS_Queued)
+	{
+		ImageLock.Leave();
+		return;
+	}
+	image.State = IS_Decoding;
+	ImageLock.Leave();
+	Decode(image);
+}
+
+void C4PNGPrefetch::ReleaseSetsBefore(int32_t set)
+{
+	for (; Released < Images.size() && Images[Released].Set < set; ++Released)
+	{
+		// images being decoded right now are dropped in Clear()
+		Image &image = Images[Released];
+		if (image.State == IS_Decoding) continue;
+		image.PNG.reset();
+		image.Data.Clear();
+		image.State = IS_Done;
+	}
+}
+
+std::unique_ptr<CPNGFile> C4PNGPrefetch::Take(C4Group &group, const char *entry_name)
+{
+	if (Images.empty()) return nullptr;
+	auto it = Index.find(GetKey(group, entry_name));
+	if (it == Index.end()) return nullptr;
+	size_t index = it->second;
+	Image &image = Images[index];
+	ImageLock.Enter();
+	ReleaseSetsBefore(image.Set);
+	if (index >= Requested)
+	{
+		Requested = index + 1;
+		WindowEvent.Set();
+	}
+	if (image.State == IS_Queued)
+	{
+		// no worker got to it yet
+		image.State = IS_Decoding;
+		ImageLock.Leave();
+		Decode(image);
+		ImageLock.Enter();
+	}
+	else if (image.State == IS_Decoding)
+	{
+		auto start = std::chrono::steady_clock::now();
+		while (image.State == IS_Decoding)
+		{
+			ImageLock.Leave();
+			DecodedEvent.WaitFor(INFINITE);
+			ImageLock.Enter();
+		}
+		WaitTime += std::chrono::steady_clock::now() - start;
+	}
+	std::unique_ptr<CPNGFile> png;
+	if (image.State == IS_Decoded && image.PNG)
+	{
+		png = std::move(image.PNG);
+		++TakenCnt;
+	}
+	image.State = IS_Done;
+	ImageLock.Leave();
+	return png;
+}
+
+C4PNGPrefetch PNGPrefetch;
@@ -0,0 +1,85 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2019, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Decodes PNG group entries on worker threads before they are needed */
+
+#ifndef INC_C4PNGPrefetch
+#define INC_C4PNGPrefetch
+
+#include "c4group/C4Group.h"
+#include "platform/StdSync.h"
+
+#include <chrono>
+#include <unordered_map>
+
+class CPNGFile;
+class C4ThreadPool;
+
+// Images are queued in the order they will be requested, in sets (e.g. one set per
+// definition). Workers stay at most a few images ahead of the requests, so only a
+// small number of decoded images is held at a time. Surfaces are still created on
+// the requesting thread.
+class C4PNGPrefetch
+{
+public:
+	typedef std::chrono::steady_clock::duration Duration;
+
+	C4PNGPrefetch();
+	~C4PNGPrefetch();
+
+	// Queue an entry. Reads the raw file data right away, so queue entries in group order.
+	bool Add(C4Group &group, const char *entry_name, int32_t set);
+	void Start(); // begin decoding queued images in the background
+	void Clear(); // cancel decoding and drop all images
+	bool IsActive() const { return !Images.empty(); }
+
+	// Get the decoded image of a queued entry, or nullptr if it wasn't queued or cannot
+	// be decoded. Waits for a worker decoding the image or decodes it right away.
+	// Images of earlier sets are assumed to be unused from then on and dropped.
+	std::unique_ptr<CPNGFile> Take(C4Group &group, const char *entry_name);
+
+	// statistics of the last run
+	int32_t ThreadCnt{0}, QueuedCnt{0}, TakenCnt{0};
+	Duration DecodeTime{0}; // summed over all threads
+	Duration WaitTime{0}; // spent by requests waiting for workers
+
+private:
+	enum ImageState { IS_Queued, IS_Decoding, IS_Decoded, IS_Done };
+	struct Image
+	{
+		int32_t Set;
+		ImageState State{IS_Queued};
+		C4GroupEntryView Data;
+		std::unique_ptr<CPNGFile> PNG;
+	};
+	std::vector<Image> Images;
+	std::unordered_map<std::string, size_t> Index;
+	std::unique_ptr<C4ThreadPool> Pool;
+	CStdCSec ImageLock;
+	CStdEvent DecodedEvent; // set when a worker finished an image
+	CStdEvent WindowEvent; // set when requests proceeded, so workers may go ahead
+	size_t Requested{0}; // index after the last requested image
+	size_t Released{0}; // images before this index have been dropped
+	bool Aborted{false};
+
+	static std::string GetKey(C4Group &group, const char *entry_name);
+	void DecodeImage(size_t index); // worker thread
+	void Decode(Image &image); // with ImageLock left
+	void ReleaseSetsBefore(int32_t set);
+};
+
+extern C4PNGPrefetch PNGPrefetch;
+
+#endif // INC_C4PNGPrefetch
@@ -45,6 +45,7 @@ class CStdGL;
 class CStdGLCtx;
 extern CStdGL *pGL;
 #endif
+class CPNGFile;
 
 const int C4SF_Tileable = 1;
 const int C4SF_MipMap   = 2;
@@ -124,6 +125,8 @@ public:
 	bool SavePNG(const char *szFilename, bool fSaveAlpha, bool fSaveOverlayOnly, bool use_background_thread);
 	bool Read(CStdStream &hGroup, const char * extension, int iFlags);
 	bool ReadPNG(CStdStream &hGroup, int iFlags);
+	bool ReadPNG(const BYTE *pData, size_t iSize, int iFlags);
+	bool ReadPNG(CPNGFile &png, int iFlags); // from a decoded image
 	bool ReadJPEG(CStdStream &hGroup, int iFlags);
 	bool ReadBMP(CStdStream &hGroup, int iFlags);
 
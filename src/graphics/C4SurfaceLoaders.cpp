@@ -22,6 +22,7 @@
 
 #include "c4group/C4GroupSet.h"
 #include "c4group/C4Group.h"
+#include "graphics/C4PNGPrefetch.h"
 #include "graphics/StdPNG.h"
 #include "lib/StdColors.h"
 
@@ -117,13 +118,28 @@ bool C4Surface::Load(C4Group &hGroup, const char *szFilename, bool, bool fNoErrI
 		}
 	}
 	// Access entry
-	if (!hGroup.AccessEntry(szFilename))
+	// PNGs may have been decoded in the background already, otherwise they are
+	// decoded straight from the group where the entry doesn't need to be copied
+	bool fSuccess;
+	C4GroupEntryView view;
+	bool fIsPNG = SEqualNoCase(GetExtension(szFilename), "png");
+	std::unique_ptr<CPNGFile> png;
+	if (fIsPNG) png = ::PNGPrefetch.Take(hGroup, szFilename);
+	if (png)
+		fSuccess = ReadPNG(*png, iFlags);
+	else
 	{
-		// file not found
-		if (!fNoErrIfNotFound) LogF("%s: %s%c%s", LoadResStr("IDS_PRC_FILENOTFOUND"), hGroup.GetFullName().getData(), (char) DirectorySeparator, szFilename);
-		return false;
+		if (fIsPNG ? !hGroup.LoadEntryView(szFilename, &view) : !hGroup.AccessEntry(szFilename))
+		{
+			// file not found
+			if (!fNoErrIfNotFound) LogF("%s: %s%c%s", LoadResStr("IDS_PRC_FILENOTFOUND"), hGroup.GetFullName().getData(), (char) DirectorySeparator, szFilename);
+			return false;
+		}
+		if (fIsPNG)
+			fSuccess = ReadPNG(view.getData(), view.getSize(), iFlags);
+		else
+			fSuccess = Read(hGroup, GetExtension(szFilename), iFlags);
 	}
-	bool fSuccess = Read(hGroup, GetExtension(szFilename), iFlags);
 	// loading error? log!
 	if (!fSuccess)
 		LogF("%s: %s%c%s", LoadResStr("IDS_ERR_NOFILE"), hGroup.GetFullName().getData(), (char) DirectorySeparator, szFilename);
@@ -155,12 +171,22 @@ bool C4Surface::ReadPNG(CStdStream &hGroup, int iFlags)
 	// load file into mem
 	hGroup.Read((void *) pData, iSize);
 	// load as png file
-	CPNGFile png;
-	bool fSuccess=png.Load(pData, iSize);
+	bool fSuccess = ReadPNG(pData, iSize, iFlags);
 	// free data
 	delete [] pData;
-	// abort if loading wasn't successful
-	if (!fSuccess) return false;
+	return fSuccess;
+}
+
+bool C4Surface::ReadPNG(const BYTE *pData, size_t iSize, int iFlags)
+{
+	// load as png file (only read from the buffer)
+	CPNGFile png;
+	if (!png.Load(const_cast<BYTE *>(pData), iSize)) return false;
+	return ReadPNG(png, iFlags);
+}
+
+bool C4Surface::ReadPNG(CPNGFile &png, int iFlags)
+{
 	// create surface(s) - do not create an 8bit-buffer!
 	if (!Create(png.iWdt, png.iHgt, iFlags)) return false;
 	// lock for writing data
@@ -206,8 +232,7 @@ bool C4Surface::ReadPNG(CStdStream &hGroup, int iFlags)
 	// unlock
 	texture->Unlock();
 	Unlock();
-	// return if successful
-	return fSuccess;
+	return true;
 }
 
 bool C4Surface::SavePNG(C4Group &hGroup, const char *szFilename, bool fSaveAlpha, bool fSaveOverlayOnly)
@@ -25,6 +25,7 @@
 #include "graphics/C4GraphicsResource.h"
 #include "gui/C4Gui.h"
 #include "gui/C4GameLobby.h"
+#include "landscape/fow/C4FoW.h"
 #include "object/C4Object.h"
 #include "player/C4Player.h"
 #include "player/C4PlayerList.h"
@@ -760,6 +761,15 @@ bool C4MessageInput::ProcessCommand(const char *szCommand)
 		if (SEqual(szCmdName, "chart"))
 			return Game.ToggleChart();
 
+	// measure fog of war performance
+	if (SEqual(szCmdName, "fowbench"))
+	{
+		if (!Game.IsRunning) return false;
+		int32_t iLights = atoi(pCmdPar);
+		C4FoW::Benchmark(iLights > 0 ? iLights : 64);
+		return true;
+	}
+
 	// whole map screenshot
 	if (SEqual(szCmdName, "screenshot"))
 	{
@@ -39,6 +39,7 @@
 #include "landscape/C4Sky.h"
 #include "landscape/C4SolidMask.h"
 #include "landscape/C4Texture.h"
+#include "landscape/C4TiledSurface8.h"
 #include "landscape/C4Weather.h"
 #include "landscape/fow/C4FoW.h"
 #include "lib/C4Random.h"
@@ -48,11 +49,12 @@
 #include "object/C4GameObjects.h"
 
 #include <array>
+#include <bitset>
 
 struct C4Landscape::P
 {
-	std::unique_ptr<CSurface8> Surface8;
-	std::unique_ptr<CSurface8> Surface8Bkg; // Background material
+	std::unique_ptr<C4TiledSurface8> Surface8;
+	std::unique_ptr<C4TiledSurface8> Surface8Bkg; // Background material
 	std::unique_ptr<CSurface8> Map;
 	std::unique_ptr<CSurface8> MapBkg;
 	std::unique_ptr<C4LandscapeRender> pLandscapeRender;
@@ -79,10 +81,38 @@ struct C4Landscape::P
 	C4Sky Sky;
 	std::unique_ptr<C4MapCreatorS2> pMapCreator; // map creator for script-generated maps
 	bool fMapChanged = false;
-	std::unique_ptr<BYTE[]> pInitial; // Initial landscape after creation - used for diff
-	std::unique_ptr<BYTE[]> pInitialBkg; // Initial bkg landscape after creation - used for diff
 	std::unique_ptr<C4FoW> pFoW;
 
+	// Initial landscape in C4LS_TileSize squares. Each tile takes a copy-on-write
+	// snapshot when it is first changed, so the diff only needs to look at tiles
+	// that have been touched since SaveInitial().
+	struct Tile
+	{
+		std::unique_ptr<BYTE[]> Initial; // initial fg pixels followed by bkg pixels; nullptr while untouched
+		int32_t ChangeFrame = -1; // last frame in which the tile was changed
+	};
+	int32_t TileCntX = 0, TileCntY = 0;
+	std::vector<Tile> Tiles; // empty until SaveInitial - no tracking during landscape creation
+
+	// Materials present in each C4LS_TileSize square, so ExecuteScan can step over squares
+	// without any material that is currently subject to temperature conversion. The scan
+	// sweep collects the materials of a square anew after it has been changed.
+	struct ScanTile
+	{
+		std::bitset<C4MaxMaterial> Mats, NewMats;
+		bool Dirty = true; // changed since Mats was collected
+		bool Collecting = false; // NewMats is being collected by the current sweep
+	};
+	int32_t ScanTileCntX = 0, ScanTileCntY = 0;
+	std::vector<ScanTile> ScanTiles; // NoSave //
+
+	static_assert(C4LS_TileSize == C4TiledSurface8::TileSize, "change tracking relies on tiles matching the surface tiles");
+	void TouchTile(int32_t tx, int32_t ty);
+	void TouchScanTile(int32_t x, int32_t y) { if (!ScanTiles.empty()) ScanTiles[y / C4LS_TileSize * ScanTileCntX + x / C4LS_TileSize].Dirty = true; }
+	void TouchPix(int32_t x, int32_t y) { TouchScanTile(x, y); if (!Tiles.empty()) TouchTile(x / C4LS_TileSize, y / C4LS_TileSize); }
+	void TouchRect(C4Rect rect);
+	BYTE GetInitialPix(const Tile &tile, int32_t x, int32_t y, bool bkg) const;
+
 	void ClearMatCount();
 
 	void ExecuteScan(C4Landscape *);
@@ -113,7 +143,7 @@ struct C4Landscape::P
 	int32_t ForPolygon(C4Landscape *d, int *vtcs, int length, const std::function<bool(int32_t, int32_t)> &callback,
 		C4MaterialList *mats_count = nullptr, uint8_t col = 0, uint8_t colBkg = 0, uint8_t *conversion_table = nullptr);
 
-	std::unique_ptr<CSurface8> CreateDefaultBkgSurface(CSurface8& sfcFg, bool msbAsIft) const;
+	template<class Surface> std::unique_ptr<Surface> CreateDefaultBkgSurface(Surface& sfcFg, bool msbAsIft) const; // for map and landscape surfaces
 	void DigMaterial2Objects(int32_t tx, int32_t ty, C4MaterialList *mat_list, C4Object *pCollect = nullptr);
 	void BlastMaterial2Objects(int32_t tx, int32_t ty, C4MaterialList *mat_list, int32_t caused_by, int32_t str, C4ValueArray *out_objects);
 
@@ -223,24 +253,50 @@ void C4Landscape::P::ExecuteScan(C4Landscape *d)
 
 	// Check: Scan needed?
 	const int32_t iTemperature = ::Weather.GetTemperature();
+	std::bitset<C4MaxMaterial> convertible;
+	bool scan_needed = false;
 	for (mat = 0; mat < ::MaterialMap.Num; mat++)
-		if (MatCount[mat])
+	{
+		const C4Material &material = ::MaterialMap.Map[mat];
+		if ((material.BelowTempConvertTo && iTemperature < material.BelowTempConvert) ||
+			(material.AboveTempConvertTo && iTemperature > material.AboveTempConvert))
 		{
-			if (::MaterialMap.Map[mat].BelowTempConvertTo &&
-				iTemperature < ::MaterialMap.Map[mat].BelowTempConvert)
-				break;
-			else if (::MaterialMap.Map[mat].AboveTempConvertTo &&
-				iTemperature > ::MaterialMap.Map[mat].AboveTempConvert)
-				break;
+			convertible.set(mat);
+			if (MatCount[mat]) scan_needed = true;
 		}
-	if (mat >= ::MaterialMap.Num)
+	}
+	if (!scan_needed)
 		return;
 
 	if (DEBUGREC_MATSCAN && Config.General.DebugRec)
 		AddDbgRec(RCT_MatScan, &ScanX, sizeof(ScanX));
 
+	if (ScanTiles.empty())
+	{
+		ScanTileCntX = (Width + C4LS_TileSize - 1) / C4LS_TileSize;
+		ScanTileCntY = (Height + C4LS_TileSize - 1) / C4LS_TileSize;
+		ScanTiles.resize(ScanTileCntX * ScanTileCntY);
+	}
+
 	for (int32_t cnt = 0; cnt < ScanSpeed; cnt++)
 	{
+		const int32_t tx = ScanX / C4LS_TileSize;
+
+		// Collect materials of changed tiles, starting at their left edge
+		for (int32_t ty = 0; ty < ScanTileCntY; ty++)
+		{
+			ScanTile &tile = ScanTiles[ty * ScanTileCntX + tx];
+			if (!(ScanX % C4LS_TileSize) && (tile.Dirty || tile.Collecting))
+			{
+				tile.NewMats.reset();
+				tile.Dirty = false;
+				tile.Collecting = true;
+			}
+			if (tile.Collecting)
+				for (cy = ty * C4LS_TileSize; cy < std::min(Height, (ty + 1) * C4LS_TileSize); cy++)
+					if (MatValid(mat = d->_GetMat(ScanX, cy)))
+						tile.NewMats.set(mat);
+		}
 
 		// Scan landscape column: sectors down
 		int32_t last_mat = -1;
@@ -258,8 +314,30 @@ void C4Landscape::P::ExecuteScan(C4Landscape *d)
 					cy += DoScan(d, ScanX, cy, mat, 0);
 			}
 			last_mat = mat;
+			// Skip the rest of a tile without convertible materials. DoScan would not do
+			// anything at material changes in there, so the result is the same.
+			const int32_t ty = cy / C4LS_TileSize, tile_end = std::min(Height, (ty + 1) * C4LS_TileSize) - 1;
+			if (cy < tile_end && !(MatValid(last_mat) && convertible[last_mat]))
+			{
+				const ScanTile &tile = ScanTiles[ty * ScanTileCntX + tx];
+				if (!tile.Dirty && !tile.Collecting && !(tile.Mats & convertible).any())
+				{
+					cy = tile_end;
+					last_mat = d->_GetMat(ScanX, cy);
+				}
+			}
 		}
 
+		// Tiles are done collecting at their right edge unless changed meanwhile
+		if (ScanX % C4LS_TileSize == C4LS_TileSize - 1 || ScanX == Width - 1)
+			for (int32_t ty = 0; ty < ScanTileCntY; ty++)
+			{
+				ScanTile &tile = ScanTiles[ty * ScanTileCntX + tx];
+				if (tile.Collecting && !tile.Dirty)
+					tile.Mats = tile.NewMats;
+				tile.Collecting = false;
+			}
+
 		// Scan advance & rewind
 		ScanX++;
 		if (ScanX >= Width)
@@ -375,10 +453,20 @@ void C4Landscape::Draw(C4TargetFacet &cgo, C4FoWRegion *pLight)
 		clrMod = p->Modulation;
 	}
 	// blit landscape
-	if (::GraphicsSystem.Show8BitSurface == 1)
-		pDraw->Blit8Fast(p->Surface8.get(), cgo.TargetX, cgo.TargetY, cgo.Surface, cgo.X, cgo.Y, cgo.Wdt, cgo.Hgt);
-	else if (::GraphicsSystem.Show8BitSurface == 2)
-		pDraw->Blit8Fast(p->Surface8Bkg.get(), cgo.TargetX, cgo.TargetY, cgo.Surface, cgo.X, cgo.Y, cgo.Wdt, cgo.Hgt);
+	if (::GraphicsSystem.Show8BitSurface == 1 || ::GraphicsSystem.Show8BitSurface == 2)
+	{
+		// Copy the visible part of the tiled surface into a plain 8 bit surface
+		const C4TiledSurface8 &sfcSrc = (::GraphicsSystem.Show8BitSurface == 1) ? *p->Surface8 : *p->Surface8Bkg;
+		C4Rect rcView(cgo.TargetX, cgo.TargetY, cgo.Wdt, cgo.Hgt);
+		rcView.Intersect(C4Rect(0, 0, GetWidth(), GetHeight()));
+		if (rcView.Wdt > 0 && rcView.Hgt > 0)
+		{
+			CSurface8 sfcView(rcView.Wdt, rcView.Hgt);
+			*sfcView.pPal = *sfcSrc.pPal;
+			sfcSrc.CopyRect(rcView.x, rcView.y, rcView.Wdt, rcView.Hgt, sfcView.Bits, sfcView.Pitch);
+			pDraw->Blit8Fast(&sfcView, cgo.TargetX - rcView.x, cgo.TargetY - rcView.y, cgo.Surface, cgo.X, cgo.Y, cgo.Wdt, cgo.Hgt);
+		}
+	}
 	else if (p->pLandscapeRender)
 	{
 		DoRelights();
@@ -863,6 +951,7 @@ bool C4Landscape::_SetPix2(int32_t x, int32_t y, BYTE fgPix, BYTE bgPix)
 		}
 	}
 	// set 8bpp-surface only!
+	p->TouchPix(x, y);
 	p->Surface8->SetPix(x, y, fgPix);
 	p->Surface8Bkg->SetPix(x, y, bgPix);
 	// note for relight
@@ -887,6 +976,7 @@ void C4Landscape::_SetPix2Tmp(int32_t x, int32_t y, BYTE fgPix, BYTE bgPix)
 {
 	// set 8bpp-surface only!
 	assert(x >= 0 && y >= 0 && x < GetWidth() && y < GetHeight());
+	p->TouchScanTile(x, y);
 	if (fgPix != Transparent) p->Surface8->SetPix(x, y, fgPix);
 	if (bgPix != Transparent) p->Surface8Bkg->SetPix(x, y, bgPix);
 }
@@ -1098,13 +1188,13 @@ BYTE C4Landscape::P::DefaultBkgMat(BYTE fg) const
 	return ::TextureMap.DefaultBkgMatTex(fg);
 }
 
-std::unique_ptr<CSurface8> C4Landscape::P::CreateDefaultBkgSurface(CSurface8& sfcFg, bool msbAsIft) const
+template<class Surface> std::unique_ptr<Surface> C4Landscape::P::CreateDefaultBkgSurface(Surface& sfcFg, bool msbAsIft) const
 {
-	auto sfcBg = std::make_unique<CSurface8>();
-	if (!sfcBg->Create(sfcFg.Wdt, sfcFg.Hgt))
+	if (!sfcFg.Wdt || !sfcFg.Hgt)
 	{
 		return nullptr;
 	}
+	auto sfcBg = std::make_unique<Surface>(sfcFg.Wdt, sfcFg.Hgt);
 
 	for (int32_t y = 0; y < sfcFg.Hgt; ++y)
 	{
@@ -1370,8 +1460,10 @@ void C4Landscape::Clear(bool fClearMapCreator, bool fClearSky, bool fClearRender
 	p->Map.reset();
 	p->MapBkg.reset();
 	// clear initial landscape
-	p->pInitial.reset();
-	p->pInitialBkg.reset();
+	p->Tiles.clear();
+	p->TileCntX = p->TileCntY = 0;
+	p->ScanTiles.clear();
+	p->ScanTileCntX = p->ScanTileCntY = 0;
 	p->pFoW.reset();
 	// clear relight array
 	for (auto &relight : p->Relights)
@@ -1423,6 +1515,13 @@ static std::unique_ptr<CSurface8> GroupReadSurface8(C4Group &hGroup, const char
 	return pSfc;
 }
 
+static std::unique_ptr<C4TiledSurface8> GroupReadTiledSurface8(C4Group &hGroup, const char *szWildCard)
+{
+	if (!hGroup.AccessEntry(szWildCard))
+		return nullptr;
+	return C4TiledSurface8::Read(hGroup);
+}
+
 bool C4Landscape::Init(C4Group &hGroup, bool fOverloadCurrent, bool fLoadSky, bool &rfLoaded, bool fSavegame)
 {
 	// set map seed, if not pre-assigned
@@ -1597,12 +1696,10 @@ bool C4Landscape::Init(C4Group &hGroup, bool fOverloadCurrent, bool fLoadSky, bo
 
 		// Create landscape surfaces
 		{
-			auto sf8 = std::make_unique<CSurface8>();
-			auto sfb8 = std::make_unique<CSurface8>();
-			if (!sf8->Create(GetWidth(), GetHeight()) || !sfb8->Create(GetWidth(), GetHeight()))
+			if (!GetWidth() || !GetHeight())
 				return false;
-			p->Surface8 = std::move(sf8);
-			p->Surface8Bkg = std::move(sfb8);
+			p->Surface8 = std::make_unique<C4TiledSurface8>(GetWidth(), GetHeight());
+			p->Surface8Bkg = std::make_unique<C4TiledSurface8>(GetWidth(), GetHeight());
 			if (!p->Mat2Pal())
 				return false;
 		}
@@ -1614,6 +1711,9 @@ bool C4Landscape::Init(C4Group &hGroup, bool fOverloadCurrent, bool fLoadSky, bo
 		bool map2landscape_success = MapToLandscape();
 		lsrender_backup.swap(p->pLandscapeRender);
 		if (!map2landscape_success) return false;
+		// Share all tiles the map left uniform
+		p->Surface8->Compact();
+		p->Surface8Bkg->Compact();
 	}
 
 	// Init out-of-landscape pixels for bottom
@@ -1623,11 +1723,14 @@ bool C4Landscape::Init(C4Group &hGroup, bool fOverloadCurrent, bool fLoadSky, bo
 
 	if (Config.General.DebugRec)
 	{
+		std::vector<BYTE> Pix(GetWidth() * GetHeight());
 		AddDbgRec(RCT_Block, "|---LANDSCAPE---|", 18);
-		AddDbgRec(RCT_Map, p->Surface8->Bits, p->Surface8->Pitch * p->Surface8->Hgt);
+		p->Surface8->CopyRect(0, 0, GetWidth(), GetHeight(), Pix.data(), GetWidth());
+		AddDbgRec(RCT_Map, Pix.data(), Pix.size());
 
 		AddDbgRec(RCT_Block, "|---LANDSCAPE BKG---|", 22);
-		AddDbgRec(RCT_Map, p->Surface8Bkg->Bits, p->Surface8Bkg->Pitch * p->Surface8Bkg->Hgt);
+		p->Surface8Bkg->CopyRect(0, 0, GetWidth(), GetHeight(), Pix.data(), GetWidth());
+		AddDbgRec(RCT_Map, Pix.data(), Pix.size());
 	}
 
 	// Create FoW
@@ -1741,62 +1844,70 @@ bool C4Landscape::SaveDiff(C4Group &hGroup, bool fSyncSave) const
 
 bool C4Landscape::P::SaveDiffInternal(const C4Landscape *d, C4Group &hGroup, bool fSyncSave) const
 {
-	assert(pInitial && pInitialBkg);
-	if (!pInitial || !pInitialBkg) return false;
-
-	// If it shouldn't be sync-save: Clear all bytes that have not changed, i.e.
-	// set them to C4M_MaxTexIndex
-	bool fChanged = false, fChangedBkg = false;;
-	if (!fSyncSave)
-		for (int y = 0; y < Height; y++)
-			for (int x = 0; x < Width; x++)
-			{
-				if (pInitial[y * Width + x] == Surface8->_GetPix(x, y))
-					Surface8->SetPix(x, y, C4M_MaxTexIndex);
-				else
-					fChanged = true;
-
-				if (pInitialBkg[y * Width + x] == Surface8Bkg->_GetPix(x, y))
-					Surface8Bkg->SetPix(x, y, C4M_MaxTexIndex);
-				else
-					fChangedBkg = true;
-			}
+	assert(!Tiles.empty());
+	if (Tiles.empty()) return false;
 
-	if (fSyncSave || fChanged)
+	if (fSyncSave)
 	{
-		// Save landscape surface
+		// Sync save: Store complete landscape
 		if (!Surface8->Save(Config.AtTempPath(C4CFN_TempLandscape)))
 			return false;
-
-		// Move temp file to group
-		if (!hGroup.Move(Config.AtTempPath(C4CFN_TempLandscape),
-			C4CFN_DiffLandscape))
+		if (!hGroup.Move(Config.AtTempPath(C4CFN_TempLandscape), C4CFN_DiffLandscape))
 			return false;
-	}
-
-	if (fSyncSave || fChangedBkg)
-	{
-		// Save landscape surface
 		if (!Surface8Bkg->Save(Config.AtTempPath(C4CFN_TempLandscapeBkg)))
 			return false;
-
-		// Move temp file to group
-		if (!hGroup.Move(Config.AtTempPath(C4CFN_TempLandscapeBkg),
-			C4CFN_DiffLandscapeBkg))
+		if (!hGroup.Move(Config.AtTempPath(C4CFN_TempLandscapeBkg), C4CFN_DiffLandscapeBkg))
 			return false;
 	}
-
-	// Restore landscape pixels
-	if (!fSyncSave)
-		for (int y = 0; y < Height; y++)
-			for (int x = 0; x < Width; x++)
+	else
+	{
+		// Otherwise, all bytes that have not changed are set to C4M_MaxTexIndex.
+		// Only tiles touched since SaveInitial can contain changes; all others
+		// stay shared in the diff surfaces.
+		C4TiledSurface8 Diff(Width, Height, C4M_MaxTexIndex), DiffBkg(Width, Height, C4M_MaxTexIndex);
+		bool fChanged = false, fChangedBkg = false;
+		for (int32_t ty = 0; ty < TileCntY; ++ty)
+			for (int32_t tx = 0; tx < TileCntX; ++tx)
 			{
-				if (Surface8->_GetPix(x, y) == C4M_MaxTexIndex)
-					Surface8->SetPix(x, y, pInitial[y * Width + x]);
-				if (Surface8Bkg->_GetPix(x, y) == C4M_MaxTexIndex)
-					Surface8Bkg->SetPix(x, y, pInitialBkg[y * Width + x]);
+				const Tile &tile = Tiles[ty * TileCntX + tx];
+				if (!tile.Initial) continue;
+				const int32_t x0 = tx * C4LS_TileSize, y0 = ty * C4LS_TileSize;
+				const int32_t x1 = std::min(x0 + C4LS_TileSize, Width), y1 = std::min(y0 + C4LS_TileSize, Height);
+				for (int32_t y = y0; y < y1; ++y)
+					for (int32_t x = x0; x < x1; ++x)
+					{
+						BYTE byPix = Surface8->_GetPix(x, y);
+						if (byPix != GetInitialPix(tile, x, y, false))
+						{
+							Diff._SetPix(x, y, byPix);
+							fChanged = true;
+						}
+						byPix = Surface8Bkg->_GetPix(x, y);
+						if (byPix != GetInitialPix(tile, x, y, true))
+						{
+							DiffBkg._SetPix(x, y, byPix);
+							fChangedBkg = true;
+						}
+					}
 			}
 
+		if (fChanged)
+		{
+			if (!Diff.Save(Config.AtTempPath(C4CFN_TempLandscape), Surface8->pPal.get()))
+				return false;
+			if (!hGroup.Move(Config.AtTempPath(C4CFN_TempLandscape), C4CFN_DiffLandscape))
+				return false;
+		}
+
+		if (fChangedBkg)
+		{
+			if (!DiffBkg.Save(Config.AtTempPath(C4CFN_TempLandscapeBkg), Surface8Bkg->pPal.get()))
+				return false;
+			if (!hGroup.Move(Config.AtTempPath(C4CFN_TempLandscapeBkg), C4CFN_DiffLandscapeBkg))
+				return false;
+		}
+	}
+
 	// Save changed map, too
 	if (fMapChanged && Map)
 		if (!d->SaveMap(hGroup)) return false;
@@ -1809,23 +1920,62 @@ bool C4Landscape::P::SaveDiffInternal(const C4Landscape *d, C4Group &hGroup, boo
 
 bool C4Landscape::SaveInitial()
 {
+	// The current landscape becomes the initial landscape. Nothing is copied
+	// here: tiles take their snapshot when they are first changed.
+	p->TileCntX = (GetWidth() + C4LS_TileSize - 1) / C4LS_TileSize;
+	p->TileCntY = (GetHeight() + C4LS_TileSize - 1) / C4LS_TileSize;
+	p->Tiles.clear();
+	p->Tiles.resize(p->TileCntX * p->TileCntY);
+	return true;
+}
 
-	// Create array
-	p->pInitial = std::make_unique<BYTE[]>(GetWidth() * GetHeight());
-	p->pInitialBkg = std::make_unique<BYTE[]>(GetWidth() * GetHeight());
+void C4Landscape::P::TouchTile(int32_t tx, int32_t ty)
+{
+	Tile &tile = Tiles[ty * TileCntX + tx];
+	tile.ChangeFrame = Game.FrameCounter;
+	if (tile.Initial) return;
+	// First change in this tile: Remember initial pixels
+	tile.Initial = std::make_unique<BYTE[]>(2 * C4LS_TileSize * C4LS_TileSize);
+	const int32_t x0 = tx * C4LS_TileSize, y0 = ty * C4LS_TileSize;
+	const int32_t wdt = std::min(C4LS_TileSize, Width - x0), hgt = std::min(C4LS_TileSize, Height - y0);
+	BYTE *pFg = tile.Initial.get(), *pBkg = pFg + C4LS_TileSize * C4LS_TileSize;
+	memcpy(pFg, Surface8->GetTile(tx, ty), C4LS_TileSize * C4LS_TileSize);
+	memcpy(pBkg, Surface8Bkg->GetTile(tx, ty), C4LS_TileSize * C4LS_TileSize);
+	// Solid masks may be put when called from _SetPix2: Take the material underneath from
+	// their buffers. Pixels that a mask is currently restoring in Remove are no vehicle anymore.
+	for (C4SolidMask *pSolid = C4SolidMask::First; pSolid; pSolid = pSolid->Next)
+	{
+		if (!pSolid->MaskPut || !pSolid->pSolidMaskMatBuff) continue;
+		C4Rect where(x0, y0, wdt, hgt);
+		where.Intersect(pSolid->MaskPutRect);
+		for (int32_t y = where.y; y < where.y + where.Hgt; ++y)
+			for (int32_t x = where.x; x < where.x + where.Wdt; ++x)
+			{
+				BYTE byPix = pSolid->pSolidMaskMatBuff[(y - pSolid->MaskPutRect.y + pSolid->MaskPutRect.ty) * pSolid->MatBuffPitch + x - pSolid->MaskPutRect.x + pSolid->MaskPutRect.tx];
+				if (!IsSomeVehicle(byPix) && IsSomeVehicle(Surface8->_GetPix(x, y)))
+					pFg[(y - y0) * C4LS_TileSize + x - x0] = byPix;
+			}
+	}
+}
 
-	// Save material data
-	for (int y = 0; y < GetHeight(); y++)
-	{
-		const int pitch = y * GetWidth();
-		for (int x = 0; x < GetWidth(); x++)
+void C4Landscape::P::TouchRect(C4Rect rect)
+{
+	if (Tiles.empty() && ScanTiles.empty()) return;
+	rect.Intersect(C4Rect(0, 0, Width, Height));
+	if (rect.Wdt <= 0 || rect.Hgt <= 0) return;
+	const int32_t tx1 = (rect.x + rect.Wdt - 1) / C4LS_TileSize, ty1 = (rect.y + rect.Hgt - 1) / C4LS_TileSize;
+	for (int32_t ty = rect.y / C4LS_TileSize; ty <= ty1; ++ty)
+		for (int32_t tx = rect.x / C4LS_TileSize; tx <= tx1; ++tx)
 		{
-			p->pInitial[pitch + x] = p->Surface8->_GetPix(x, y);
-			p->pInitialBkg[pitch + x] = p->Surface8Bkg->_GetPix(x, y);
+			if (!ScanTiles.empty()) ScanTiles[ty * ScanTileCntX + tx].Dirty = true;
+			if (!Tiles.empty()) TouchTile(tx, ty);
 		}
-	}
+}
 
-	return true;
+BYTE C4Landscape::P::GetInitialPix(const Tile &tile, int32_t x, int32_t y, bool bkg) const
+{
+	assert(tile.Initial);
+	return tile.Initial[(bkg ? C4LS_TileSize * C4LS_TileSize : 0) + (y % C4LS_TileSize) * C4LS_TileSize + (x % C4LS_TileSize)];
 }
 
 bool C4Landscape::Load(C4Group &hGroup, bool fLoadSky, bool fSavegame)
@@ -1833,10 +1983,10 @@ bool C4Landscape::Load(C4Group &hGroup, bool fLoadSky, bool fSavegame)
 	assert(!p->Surface8 && !p->Surface8Bkg);
 
 	// Load exact landscape from group
-	if ((p->Surface8 = GroupReadSurface8(hGroup, C4CFN_Landscape)) == nullptr)
+	if ((p->Surface8 = GroupReadTiledSurface8(hGroup, C4CFN_Landscape)) == nullptr)
 	{
-		if ((p->Surface8 = GroupReadSurface8(hGroup, C4CFN_LandscapeFg)) == nullptr) return false;
-		p->Surface8Bkg = GroupReadSurface8(hGroup, C4CFN_LandscapeBg);
+		if ((p->Surface8 = GroupReadTiledSurface8(hGroup, C4CFN_LandscapeFg)) == nullptr) return false;
+		p->Surface8Bkg = GroupReadTiledSurface8(hGroup, C4CFN_LandscapeBg);
 
 		if (p->Surface8Bkg)
 		{
@@ -1851,6 +2001,7 @@ bool C4Landscape::Load(C4Group &hGroup, bool fLoadSky, bool fSavegame)
 			// LandscapeFg.bmp loaded: Assume full 8bit mat-tex values
 			// when creating background surface.
 			p->Surface8Bkg = p->CreateDefaultBkgSurface(*p->Surface8, false);
+			p->Surface8Bkg->Compact();
 		}
 	}
 	else
@@ -1858,6 +2009,8 @@ bool C4Landscape::Load(C4Group &hGroup, bool fLoadSky, bool fSavegame)
 		// Landscape.bmp loaded: Assume msb is IFT flag when creating
 		// background surface.
 		p->Surface8Bkg = p->CreateDefaultBkgSurface(*p->Surface8, true);
+		p->Surface8->Compact();
+		p->Surface8Bkg->Compact();
 	}
 
 	int iWidth, iHeight;
@@ -1900,29 +2053,73 @@ bool C4Landscape::Load(C4Group &hGroup, bool fLoadSky, bool fSavegame)
 }
 bool C4Landscape::ApplyDiff(C4Group &hGroup)
 {
-	std::unique_ptr<CSurface8> pDiff, pDiffBkg;
+	std::unique_ptr<C4TiledSurface8> pDiff, pDiffBkg;
 	// Load diff landscape from group
-	pDiff = GroupReadSurface8(hGroup, C4CFN_DiffLandscape);
-	pDiffBkg = GroupReadSurface8(hGroup, C4CFN_DiffLandscapeBkg);
+	pDiff = GroupReadTiledSurface8(hGroup, C4CFN_DiffLandscape);
+	pDiffBkg = GroupReadTiledSurface8(hGroup, C4CFN_DiffLandscapeBkg);
 	if (pDiff == nullptr && pDiffBkg == nullptr) return false;
 
+	// Diff tiles that are uniformly C4M_MaxTexIndex hold no changes
+	auto fnUnchanged = [](const std::unique_ptr<C4TiledSurface8> &pSfc, int32_t tx, int32_t ty)
+	{
+		return !pSfc || tx >= pSfc->TileCntX || ty >= pSfc->TileCntY || pSfc->IsUniformTile(tx, ty, C4M_MaxTexIndex);
+	};
+
 	// convert all pixels: keep if same material; re-set if different material
 	BYTE byPix;
-	for (int32_t y = 0; y < GetHeight(); ++y) for (int32_t x = 0; x < GetWidth(); ++x)
+	for (int32_t ty = 0; ty < p->Surface8->TileCntY; ++ty) for (int32_t tx = 0; tx < p->Surface8->TileCntX; ++tx)
 	{
-		if (pDiff && pDiff->GetPix(x, y) != C4M_MaxTexIndex)
-			if (p->Surface8->_GetPix(x, y) != (byPix = pDiff->_GetPix(x, y)))
-				// material has changed here: readjust with new texture
-				p->Surface8->SetPix(x, y, byPix);
-		if (pDiffBkg && pDiffBkg->GetPix(x, y) != C4M_MaxTexIndex)
-			if (p->Surface8Bkg->_GetPix(x, y) != (byPix = pDiffBkg->_GetPix(x, y)))
-				p->Surface8Bkg->_SetPix(x, y, byPix);
+		if (fnUnchanged(pDiff, tx, ty) && fnUnchanged(pDiffBkg, tx, ty)) continue;
+		const int32_t x0 = tx * C4LS_TileSize, y0 = ty * C4LS_TileSize;
+		const int32_t x1 = std::min(x0 + C4LS_TileSize, GetWidth()), y1 = std::min(y0 + C4LS_TileSize, GetHeight());
+		for (int32_t y = y0; y < y1; ++y) for (int32_t x = x0; x < x1; ++x)
+		{
+			if (pDiff && pDiff->GetPix(x, y) != C4M_MaxTexIndex)
+				if (p->Surface8->_GetPix(x, y) != (byPix = pDiff->_GetPix(x, y)))
+				{
+					// material has changed here: readjust with new texture
+					p->TouchPix(x, y);
+					p->Surface8->SetPix(x, y, byPix);
+				}
+			if (pDiffBkg && pDiffBkg->GetPix(x, y) != C4M_MaxTexIndex)
+				if (p->Surface8Bkg->_GetPix(x, y) != (byPix = pDiffBkg->_GetPix(x, y)))
+				{
+					p->TouchPix(x, y);
+					p->Surface8Bkg->_SetPix(x, y, byPix);
+				}
+		}
 	}
 
 	// done
 	return true;
 }
 
+int32_t C4Landscape::GetChangedRects(int32_t iSinceFrame, std::vector<C4Rect> &rRects) const
+{
+	// Merge horizontal runs of changed tiles into one rect each
+	const int32_t iOldCnt = rRects.size();
+	const int32_t iMinFrame = std::max<int32_t>(iSinceFrame, 0);
+	const C4Rect rcLandscape(0, 0, GetWidth(), GetHeight());
+	for (int32_t ty = 0; ty < p->TileCntY; ++ty)
+	{
+		int32_t iRunStart = -1;
+		for (int32_t tx = 0; tx <= p->TileCntX; ++tx)
+		{
+			const bool fChanged = tx < p->TileCntX && p->Tiles[ty * p->TileCntX + tx].ChangeFrame >= iMinFrame;
+			if (fChanged && iRunStart < 0)
+				iRunStart = tx;
+			else if (!fChanged && iRunStart >= 0)
+			{
+				C4Rect rcRun(iRunStart * C4LS_TileSize, ty * C4LS_TileSize, (tx - iRunStart) * C4LS_TileSize, C4LS_TileSize);
+				rcRun.Intersect(rcLandscape);
+				rRects.push_back(rcRun);
+				iRunStart = -1;
+			}
+		}
+	}
+	return rRects.size() - iOldCnt;
+}
+
 void C4Landscape::Default()
 {
 	p = std::make_unique<P>();
@@ -3660,7 +3857,7 @@ bool C4Landscape::DrawPolygon(int *vtcs, int length, const char *szMaterial, con
 
 CStdPalette * C4Landscape::GetPal() const
 {
-	return p->Surface8 ? p->Surface8->pPal : nullptr;
+	return p->Surface8 ? p->Surface8->pPal.get() : nullptr;
 }
 
 int32_t C4Landscape::GetWidth() const
@@ -3922,6 +4119,8 @@ void C4Landscape::P::PrepareChange(const C4Landscape *d, const C4Rect &BoundingB
 		pSolid->RemoveTemporary(SolidMaskRect);
 	}
 	if (updateMatCnt) UpdateMatCnt(d, BoundingBox, false);
+	// snapshot initial landscape before anything is drawn
+	TouchRect(BoundingBox);
 }
 
 void C4Landscape::P::FinishChange(C4Landscape *d, C4Rect BoundingBox, const bool updateMatAndPixCnt)
@@ -4231,6 +4430,9 @@ void C4Landscape::UpdatePixMaps()
 	for (i = 0; i < C4M_MaxTexIndex; i++) p->Pix2Place[i] = MatValid(p->Pix2Mat[i]) ? ::MaterialMap.Map[p->Pix2Mat[i]].Placement : 0;
 	for (i = 0; i < C4M_MaxTexIndex; i++) p->Pix2Light[i] = MatValid(p->Pix2Mat[i]) && (::MaterialMap.Map[p->Pix2Mat[i]].Light>0);
 	p->Pix2Place[0] = 0;
+	// material of pixels may have changed
+	for (auto &tile : p->ScanTiles)
+		tile.Dirty = true;
 	// clear bridge mat conversion buffers
 	std::fill(p->BridgeMatConversion.begin(), p->BridgeMatConversion.end(), nullptr);
 }
@@ -26,6 +26,8 @@ const int32_t C4MaxMaterial = 125;
 
 const int32_t C4LS_MaxRelights = 50;
 
+const int32_t C4LS_TileSize = 64; // edge length of squares in which landscape changes are tracked
+
 enum class LandscapeMode
 {
 	Undefined = 0,
@@ -72,6 +74,7 @@ public:
 	bool HasMap() const;
 	bool MapToLandscape();
 	bool ApplyDiff(C4Group &hGroup);
+	int32_t GetChangedRects(int32_t iSinceFrame, std::vector<C4Rect> &rRects) const; // get tile-aligned rects changed in or after given frame; returns number of rects
 	
 	void SetMode(LandscapeMode iMode);
 	LandscapeMode GetMode() const;
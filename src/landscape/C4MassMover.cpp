@@ -25,6 +25,7 @@
 #include "landscape/C4Material.h"
 #include "landscape/C4Landscape.h"
 #include "lib/C4Random.h"
+#include "lib/C4Stat.h"
 
 // Note: creation optimized using advancing CreatePtr, so sequential
 // creation does not keep rescanning the complete set for a free
@@ -36,6 +37,13 @@
 // a mathematical triangular shape with no delays! Since masses are
 // running slower and smoother, overall MM counts are much lower,
 // hardly ever exceeding 1000.                          October 1997
+//
+// The set is now a growable pool with a free list. Each pass executes the
+// movers that exist at its start, ordered by landscape tile for locality,
+// so movers created during a pass still wait for the next one.
+
+C4ST_NEW(MassMoverExecStat,  "C4MassMoverSet::Execute executed movers")
+C4ST_NEW(MassMoverDeferStat, "C4MassMoverSet::Execute deferred movers")
 
 C4MassMoverSet::C4MassMoverSet()
 {
@@ -49,48 +57,110 @@ C4MassMoverSet::~C4MassMoverSet()
 
 void C4MassMoverSet::Clear()
 {
-
+	Set.clear();
+	FreeSlots.clear();
+	Order.clear();
+	TileStart.clear();
 }
 
 void C4MassMoverSet::Execute()
 {
-	C4MassMover *cmm;
-	// Init counts
-	Count=0;
-	// Execute & count
+	ExecuteCnt = DeferCnt = 0;
+	// Execute
 	for (int32_t speed = 2; speed>0; speed--)
 	{
-		cmm = &(Set[C4MassMoverChunk-1]);
-		for (int32_t cnt = 0; cnt<C4MassMoverChunk; cnt++,cmm--)
-			if (cmm->Mat!=MNone)
-				{ Count++; cmm->Execute(); }
+		SortByTile();
+		const int32_t iOrderCnt = Order.size(), iExecCnt = std::min(iOrderCnt, C4MassMoverBudget);
+		// Find the cursor in the new order. Slots within a tile are sorted in descending order.
+		int32_t iStart = 0;
+		if (iOrderCnt)
+		{
+			const int32_t iTile = std::min<int32_t>(ExecuteTile, TileStart.size() - 2);
+			iStart = std::lower_bound(Order.begin() + TileStart[iTile], Order.begin() + TileStart[iTile + 1], ExecuteSlot, std::greater<int32_t>()) - Order.begin();
+		}
+		for (int32_t cnt = 0; cnt<iExecCnt; cnt++)
+		{
+			const int32_t slot = Order[(iStart + cnt) % iOrderCnt];
+			Set[slot].Execute();
+			ExecuteCnt++;
+			// Slots of ceased movers have been passed in Order already and can be reused right away
+			if (Set[slot].Mat==MNone) FreeSlots.push_back(slot);
+		}
+		if (iExecCnt < iOrderCnt)
+		{
+			// Remember the first mover that was not executed. It may have ceased meanwhile,
+			// in which case its slot still marks the position within its tile.
+			DeferCnt += iOrderCnt - iExecCnt;
+			const int32_t iNext = (iStart + iExecCnt) % iOrderCnt;
+			ExecuteTile = std::upper_bound(TileStart.begin(), TileStart.end() - 1, iNext) - TileStart.begin() - 1;
+			ExecuteSlot = Order[iNext];
+		}
+		else
+			ResetExecuteCursor();
 	}
+	C4ST_ADD(MassMoverExecStat, ExecuteCnt)
+	C4ST_ADD(MassMoverDeferStat, DeferCnt)
+}
+
+int32_t C4MassMoverSet::GetTile(const C4MassMover &mm) const
+{
+	const int32_t iTileCntX = (::Landscape.GetWidth() + C4LS_TileSize - 1) / C4LS_TileSize,
+	              iTileCntY = (::Landscape.GetHeight() + C4LS_TileSize - 1) / C4LS_TileSize;
+	return Clamp<int32_t>(mm.y / C4LS_TileSize, 0, iTileCntY - 1) * iTileCntX + Clamp<int32_t>(mm.x / C4LS_TileSize, 0, iTileCntX - 1);
+}
+
+void C4MassMoverSet::SortByTile()
+{
+	// Counting sort of live slots by landscape tile. Each tile is filled from its end
+	// while slots are visited in ascending order, so slots end up in descending order
+	// within a tile, which is the execution order. Afterwards, TileStart[tile] is the
+	// first entry of the tile.
+	const int32_t iTileCnt = ((::Landscape.GetWidth() + C4LS_TileSize - 1) / C4LS_TileSize) * ((::Landscape.GetHeight() + C4LS_TileSize - 1) / C4LS_TileSize);
+	TileStart.assign(iTileCnt + 1, 0);
+	for (const C4MassMover &mm : Set)
+		if (mm.Mat!=MNone)
+			TileStart[GetTile(mm)]++;
+	for (size_t i = 1; i < TileStart.size(); i++)
+		TileStart[i] += TileStart[i - 1];
+	Order.resize(TileStart.back());
+	for (int32_t slot = 0; slot < int32_t(Set.size()); slot++)
+		if (Set[slot].Mat!=MNone)
+			Order[--TileStart[GetTile(Set[slot])]] = slot;
 }
 
 bool C4MassMoverSet::Create(int32_t x, int32_t y, bool fExecute)
 {
-	if (Count == C4MassMoverChunk) return false;
+	if (Count >= C4MassMoverMax) return false;
 	if (Config.General.DebugRec)
 	{
 		C4RCMassMover rc;
 		rc.x=x; rc.y=y;
 		AddDbgRec(RCT_MMC, &rc, sizeof(rc));
 	}
-	int32_t cptr=CreatePtr;
-	do
+	int32_t slot;
+	if (!FreeSlots.empty())
 	{
-		cptr++;
-		if (cptr>=C4MassMoverChunk) cptr=0;
-		if (Set[cptr].Mat==MNone)
-		{
-			if (!Set[cptr].Init(x,y)) return false;
-			CreatePtr=cptr;
-			if (fExecute) Set[cptr].Execute();
-			return true;
-		}
+		slot = FreeSlots.back();
+		FreeSlots.pop_back();
 	}
-	while (cptr!=CreatePtr);
-	return false;
+	else
+	{
+		slot = Set.size();
+		Set.emplace_back();
+	}
+	if (!Set[slot].Init(x,y))
+	{
+		FreeSlots.push_back(slot);
+		return false;
+	}
+	Count++;
+	CreatePtr=slot;
+	if (fExecute)
+	{
+		Set[slot].Execute();
+		if (Set[slot].Mat==MNone) FreeSlots.push_back(slot);
+	}
+	return true;
 }
 
 void C4MassMoverSet::Draw()
@@ -105,7 +175,6 @@ bool C4MassMover::Init(int32_t tx, int32_t ty)
 	// Check mat
 	Mat=GBackMat(tx,ty);
 	x=tx; y=ty;
-	::MassMover.Count++;
 	return (Mat!=MNone);
 }
 
@@ -182,22 +251,18 @@ bool C4MassMover::Corrosion(int32_t dx, int32_t dy)
 
 void C4MassMoverSet::Default()
 {
-	int32_t cnt;
-	for (cnt=0; cnt<C4MassMoverChunk; cnt++) Set[cnt].Mat=MNone;
+	Set.clear();
+	FreeSlots.clear();
 	Count=0;
 	CreatePtr=0;
+	ExecuteCnt=DeferCnt=0;
+	ResetExecuteCursor();
 }
 
 bool C4MassMoverSet::Save(C4Group &hGroup)
 {
-	int32_t cnt;
 	// Consolidate
 	Consolidate();
-	// Recount
-	Count=0;
-	for (cnt=0; cnt<C4MassMoverChunk; cnt++)
-		if (Set[cnt].Mat!=MNone)
-			Count++;
 	// All empty: delete component
 	if (!Count)
 	{
@@ -205,7 +270,10 @@ bool C4MassMoverSet::Save(C4Group &hGroup)
 		return true;
 	}
 	// Save set
-	if (!hGroup.Add(C4CFN_MassMover,Set,Count*sizeof(C4MassMover)))
+	StdBuf Buf;
+	Buf.New(Count*sizeof(C4MassMover));
+	std::copy(Set.begin(), Set.end(), getMBufPtr<C4MassMover>(Buf));
+	if (!hGroup.Add(C4CFN_MassMover,Buf,false,true))
 		return false;
 	// Success
 	return true;
@@ -218,40 +286,24 @@ bool C4MassMoverSet::Load(C4Group &hGroup)
 	size_t iBinSize,iMoverSize=sizeof(C4MassMover);
 	if (!hGroup.AccessEntry(C4CFN_MassMover,&iBinSize)) return false;
 	if ((iBinSize % iMoverSize)!=0) return false;
+	if (iBinSize / iMoverSize > size_t(C4MassMoverMax)) return false;
 	// load new
-	Count = iBinSize / iMoverSize;
-	if (!hGroup.Read(Set,iBinSize)) return false;
+	std::vector<C4MassMover> Buf(iBinSize / iMoverSize);
+	if (!hGroup.Read(Buf.data(),iBinSize)) return false;
+	Set.assign(Buf.begin(), Buf.end());
+	Consolidate();
 	return true;
 }
 
 void C4MassMoverSet::Consolidate()
 {
-	// Consolidate set
-	int32_t iSpot,iPtr,iConsolidated;
-	for (iSpot=-1,iPtr=0,iConsolidated=0; iPtr<C4MassMoverChunk; iPtr++)
-	{
-		// Empty: set new spot if needed
-		if (Set[iPtr].Mat==MNone)
-		{
-			if (iSpot==-1) iSpot=iPtr;
-		}
-		// Full: move down to empty spot if possible
-		else if (iSpot!=-1)
-		{
-			// Move to spot
-			Set[iSpot]=Set[iPtr];
-			Set[iPtr].Mat=MNone;
-			iConsolidated++;
-			// Advance empty spot (as far as ptr)
-			for (; iSpot<iPtr; iSpot++)
-				if (Set[iSpot].Mat==MNone)
-					break;
-			// No empty spot below ptr
-			if (iSpot==iPtr) iSpot=-1;
-		}
-	}
+	// Move live movers to the front, keeping their order
+	Set.erase(std::remove_if(Set.begin(), Set.end(), [](const C4MassMover &mm) { return mm.Mat==MNone; }), Set.end());
+	FreeSlots.clear();
+	Count=Set.size();
 	// Reset create ptr
 	CreatePtr=0;
+	ResetExecuteCursor();
 }
 
 void C4MassMoverSet::Synchronize()
@@ -264,7 +316,10 @@ void C4MassMoverSet::Copy(C4MassMoverSet &rSet)
 	Clear();
 	Count=rSet.Count;
 	CreatePtr=rSet.CreatePtr;
-	for (int32_t cnt=0; cnt<C4MassMoverChunk; cnt++) Set[cnt]=rSet.Set[cnt];
+	ExecuteTile=rSet.ExecuteTile;
+	ExecuteSlot=rSet.ExecuteSlot;
+	Set=rSet.Set;
+	FreeSlots=rSet.FreeSlots;
 }
 
 C4MassMoverSet MassMover;
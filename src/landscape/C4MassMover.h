@@ -20,13 +20,21 @@
 #ifndef INC_C4MassMover
 #define INC_C4MassMover
 
-const int32_t C4MassMoverChunk = 10000;
+#include "config/C4Constants.h"
+
+#include <deque>
+
+// Upper bound for the number of mass movers. Storage grows on demand up to this number.
+const int32_t C4MassMoverMax = 100000;
+
+// Mover executions per pass. Movers beyond are executed in the following frames.
+const int32_t C4MassMoverBudget = 20000;
 
 class C4MassMover
 {
 	friend class C4MassMoverSet;
 protected:
-	int32_t Mat,x,y;
+	int32_t Mat{MNone},x{0},y{0};
 protected:
 	void Cease();
 	bool Execute();
@@ -41,9 +49,18 @@ public:
 	~C4MassMoverSet();
 public:
 	int32_t Count;
-	int32_t CreatePtr;
+	int32_t CreatePtr; // slot of the last created mover
+	int32_t ExecuteCnt, DeferCnt; // movers executed and deferred in the last frame
 protected:
-	C4MassMover Set[C4MassMoverChunk];
+	// Slots with Mat==MNone are free. A deque keeps movers in place when the set grows, because
+	// material reactions of an executing mover can create new movers while its members are referenced.
+	std::deque<C4MassMover> Set;
+	std::vector<int32_t> FreeSlots; // reused last in, first out
+	std::vector<int32_t> Order; // live slots sorted by landscape tile for execution
+	std::vector<int32_t> TileStart; // first entry of each tile in Order, followed by the total
+	// Where to continue if the budget was exceeded: the first mover in ExecuteTile with a slot
+	// not above ExecuteSlot. Unlike a position in Order, this stays valid when Order is rebuilt.
+	int32_t ExecuteTile, ExecuteSlot;
 public:
 	void Copy(C4MassMoverSet &rSet);
 	void Synchronize();
@@ -56,6 +73,9 @@ public:
 	bool Save(C4Group &hGroup);
 protected:
 	void Consolidate();
+	void SortByTile();
+	int32_t GetTile(const C4MassMover &mm) const;
+	void ResetExecuteCursor() { ExecuteTile = 0; ExecuteSlot = C4MassMoverMax; }
 };
 
 extern C4MassMoverSet MassMover;
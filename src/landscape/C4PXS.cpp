@@ -30,36 +30,49 @@
 
 static const C4Real WindDrift_Factor = itofix(1, 800);
 
-bool C4PXS::Execute()
+// Record layout of PXS in savegames
+struct C4PXSRecord
 {
+	int32_t Mat;
+	C4Real x, y, xdir, ydir;
+};
+
+bool C4PXSSystem::ExecutePXS(size_t i)
+{
+	// Work on copies: material reactions may create new PXS, which can
+	// reallocate the PXS arrays.
+	int32_t mat = Mat[i];
+	C4Real x = X[i], y = Y[i], xdir = XDir[i], ydir = YDir[i];
+	auto store = [&]() { Mat[i] = mat; X[i] = x; Y[i] = y; XDir[i] = xdir; YDir[i] = ydir; };
+
 	if (DEBUGREC_PXS && Config.General.DebugRec)
 	{
 		C4RCExecPXS rc;
-		rc.x=x; rc.y=y; rc.iMat=Mat;
+		rc.x=x; rc.y=y; rc.iMat=mat;
 		rc.pos = 0;
 		AddDbgRec(RCT_ExecPXS, &rc, sizeof(rc));
 	}
 	int32_t inmat;
 
 	// Safety
-	if (!MatValid(Mat))
-		{ Deactivate(); return false; }
+	if (!MatValid(mat))
+		{ Deactivate(i); return false; }
 
 	// Out of bounds
 	if ((x<0) || (x>=::Landscape.GetWidth()) || (y<-10) || (y>=::Landscape.GetHeight()))
-		{ Deactivate(); return false; }
+		{ Deactivate(i); return false; }
 
 	// Material conversion
 	int32_t iX = fixtoi(x), iY = fixtoi(y);
 	inmat=GBackMat(iX,iY);
-	C4MaterialReaction *pReact = ::MaterialMap.GetReactionUnsafe(Mat, inmat);
-	if (pReact && (*pReact->pFunc)(pReact, iX,iY, iX,iY, xdir,ydir, Mat,inmat, meePXSPos, nullptr))
-		{ Deactivate(); return false; }
+	C4MaterialReaction *pReact = ::MaterialMap.GetReactionUnsafe(mat, inmat);
+	if (pReact && (*pReact->pFunc)(pReact, iX,iY, iX,iY, xdir,ydir, mat,inmat, meePXSPos, nullptr))
+		{ store(); Deactivate(i); return false; }
 
 	// Gravity
 	ydir+=GravAccel;
 
-	if (GBackDensity(iX, iY + 1) < ::MaterialMap.Map[Mat].Density)
+	if (GBackDensity(iX, iY + 1) < ::MaterialMap.Map[mat].Density)
 	{
 		// Air speed: Wind plus some random
 		int32_t iWind = Weather.GetWind(iX, iY);
@@ -67,7 +80,7 @@ bool C4PXS::Execute()
 		C4Real tydir = C4REAL256(Random(1200) - 600);
 
 		// Air friction, based on WindDrift. MaxSpeed is ignored.
-		int32_t iWindDrift = std::max(::MaterialMap.Map[Mat].WindDrift - 20, 0);
+		int32_t iWindDrift = std::max(::MaterialMap.Map[mat].WindDrift - 20, 0);
 		xdir += ((txdir - xdir) * iWindDrift) * WindDrift_Factor;
 		ydir += ((tydir - ydir) * iWindDrift) * WindDrift_Factor;
 	}
@@ -83,6 +96,7 @@ bool C4PXS::Execute()
 		if (::Landscape._PathFree(iX, iY, iToX, iToY))
 		{
 			x=ctcox; y=ctcoy;
+			store();
 			return true;
 		}
 
@@ -95,13 +109,14 @@ bool C4PXS::Execute()
 		int32_t inX = iX + Sign(iToX - iX), inY = iY + Sign(iToY - iY);
 		// Contact?
 		inmat = GBackMat(inX, inY);
-		C4MaterialReaction *pReact = ::MaterialMap.GetReactionUnsafe(Mat, inmat);
+		C4MaterialReaction *pReact = ::MaterialMap.GetReactionUnsafe(mat, inmat);
 		if (pReact)
 		{
-			if ((*pReact->pFunc)(pReact, iX,iY, inX,inY, xdir,ydir, Mat,inmat, meePXSMove, &fStopMovement))
+			if ((*pReact->pFunc)(pReact, iX,iY, inX,inY, xdir,ydir, mat,inmat, meePXSMove, &fStopMovement))
 			{
 				// destructive contact
-				Deactivate();
+				store();
+				Deactivate(i);
 				return false;
 			}
 			else
@@ -112,6 +127,7 @@ bool C4PXS::Execute()
 					// But keep fractional positions to allow proper movement on moving ground
 					if (iX != iX0) x = itofix(iX);
 					if (iY != iY0) y = itofix(iY);
+					store();
 					return true;
 				}
 				// there was a reaction func, but it didn't do anything - continue movement
@@ -123,26 +139,27 @@ bool C4PXS::Execute()
 
 	// No contact? Free movement
 	x=ctcox; y=ctcoy;
+	store();
 	if (DEBUGREC_PXS && Config.General.DebugRec)
 	{
 		C4RCExecPXS rc;
-		rc.x=x; rc.y=y; rc.iMat=Mat;
+		rc.x=x; rc.y=y; rc.iMat=mat;
 		rc.pos = 1;
 		AddDbgRec(RCT_ExecPXS, &rc, sizeof(rc));
 	}
 	return true;
 }
 
-void C4PXS::Deactivate()
+void C4PXSSystem::Deactivate(size_t i)
 {
 	if (DEBUGREC_PXS && Config.General.DebugRec)
 	{
 		C4RCExecPXS rc;
-		rc.x=x; rc.y=y; rc.iMat=Mat;
+		rc.x=X[i]; rc.y=Y[i]; rc.iMat=Mat[i];
 		rc.pos = 2;
 		AddDbgRec(RCT_ExecPXS, &rc, sizeof(rc));
 	}
-	Mat=MNone;
+	Mat[i]=MNone;
 }
 
 C4PXSSystem::C4PXSSystem()
@@ -158,28 +175,53 @@ C4PXSSystem::~C4PXSSystem()
 void C4PXSSystem::Default()
 {
 	Count=0;
+	GridValid=false;
 }
 
 void C4PXSSystem::Clear()
 {
 	Count=0;
+	GridValid=false;
+	// release storage
+	Mat.clear(); Mat.shrink_to_fit();
+	X.clear(); X.shrink_to_fit();
+	Y.clear(); Y.shrink_to_fit();
+	XDir.clear(); XDir.shrink_to_fit();
+	YDir.clear(); YDir.shrink_to_fit();
+	GridStart.clear(); GridStart.shrink_to_fit();
+	GridIndex.clear(); GridIndex.shrink_to_fit();
 }
 
-C4PXS* C4PXSSystem::New()
+void C4PXSSystem::Reserve(size_t iCount)
 {
-	if (Count < PXSMax)
-		return &PXS[Count++];
-	return nullptr;
+	if (iCount <= Mat.size()) return;
+	// grow geometrically to keep the number of reallocations low
+	iCount = std::min(std::max(iCount, Mat.size() * 2), PXSMax);
+	Mat.resize(iCount, MNone);
+	X.resize(iCount, Fix0); Y.resize(iCount, Fix0);
+	XDir.resize(iCount, Fix0); YDir.resize(iCount, Fix0);
+}
+
+void C4PXSSystem::Remove(size_t i)
+{
+	assert(i < Count);
+	--Count;
+	Mat[i] = Mat[Count];
+	X[i] = X[Count]; Y[i] = Y[Count];
+	XDir[i] = XDir[Count]; YDir[i] = YDir[Count];
+	GridValid = false;
 }
 
 bool C4PXSSystem::Create(int32_t mat, C4Real ix, C4Real iy, C4Real ixdir, C4Real iydir)
 {
-	C4PXS *pxp;
 	if (!MatValid(mat)) return false;
-	if (!(pxp=New())) return false;
-	pxp->Mat=mat;
-	pxp->x=ix; pxp->y=iy;
-	pxp->xdir=ixdir; pxp->ydir=iydir;
+	if (Count >= PXSMax) return false;
+	Reserve(Count + 1);
+	size_t i = Count++;
+	Mat[i]=mat;
+	X[i]=ix; Y[i]=iy;
+	XDir[i]=ixdir; YDir[i]=iydir;
+	GridValid = false;
 	return true;
 }
 
@@ -187,12 +229,57 @@ void C4PXSSystem::Execute()
 {
 	for (size_t i = 0; i < Count; i++)
 	{
-		if (!PXS[i].Execute())
+		if (!ExecutePXS(i))
 		{
-			assert(PXS[i].Mat == MNone);
-			PXS[i--] = PXS[--Count];
+			assert(Mat[i] == MNone);
+			Remove(i--);
 		}
 	}
+	// everything has moved
+	GridValid = false;
+}
+
+int32_t C4PXSSystem::GetGridCell(size_t i) const
+{
+	// PXS may be slightly out of the landscape; those are put into border cells
+	int32_t cx = Clamp<int32_t>(fixtoi(X[i]) / PXSGridSize, 0, GridWdt - 1);
+	int32_t cy = Clamp<int32_t>(fixtoi(Y[i]) / PXSGridSize, 0, GridHgt - 1);
+	return cy * GridWdt + cx;
+}
+
+void C4PXSSystem::UpdateGrid() const
+{
+	if (GridValid) return;
+	GridWdt = std::max<int32_t>((::Landscape.GetWidth() + PXSGridSize - 1) / PXSGridSize, 1);
+	GridHgt = std::max<int32_t>((::Landscape.GetHeight() + PXSGridSize - 1) / PXSGridSize, 1);
+	// counting sort of PXS indices by cell
+	GridStart.assign(GridWdt * GridHgt + 1, 0);
+	for (size_t i = 0; i < Count; ++i)
+		++GridStart[GetGridCell(i) + 1];
+	for (size_t c = 1; c < GridStart.size(); ++c)
+		GridStart[c] += GridStart[c - 1];
+	GridIndex.resize(Count);
+	std::vector<uint32_t> fill(GridStart.begin(), GridStart.end() - 1);
+	for (size_t i = 0; i < Count; ++i)
+		GridIndex[fill[GetGridCell(i)]++] = i;
+	GridValid = true;
+}
+
+template<class Fn> void C4PXSSystem::ForEachInRect(const C4Rect &rect, Fn fn) const
+{
+	UpdateGrid();
+	// one pixel of margin for rounding in GetGridCell
+	int32_t cx1 = Clamp<int32_t>((rect.x - 1) / PXSGridSize, 0, GridWdt - 1);
+	int32_t cy1 = Clamp<int32_t>((rect.y - 1) / PXSGridSize, 0, GridHgt - 1);
+	int32_t cx2 = Clamp<int32_t>((rect.x + rect.Wdt + 1) / PXSGridSize, 0, GridWdt - 1);
+	int32_t cy2 = Clamp<int32_t>((rect.y + rect.Hgt + 1) / PXSGridSize, 0, GridHgt - 1);
+	for (int32_t cy = cy1; cy <= cy2; ++cy)
+		for (int32_t cx = cx1; cx <= cx2; ++cx)
+		{
+			int32_t c = cy * GridWdt + cx;
+			for (uint32_t j = GridStart[c]; j < GridStart[c + 1]; ++j)
+				fn(GridIndex[j]);
+		}
 }
 
 void C4PXSSystem::Draw(C4TargetFacet &cgo)
@@ -211,13 +298,14 @@ void C4PXSSystem::Draw(C4TargetFacet &cgo)
 
 	float cgox = cgo.X - cgo.TargetX, cgoy = cgo.Y - cgo.TargetY;
 	// First pass: draw simple PXS (lines/pixels)
-	for (size_t i = 0; i < Count; i++)
+	ForEachInRect(VisibleRect, [&](size_t i)
 	{
-		C4PXS *pxp = &PXS[i];
-		if (pxp->Mat != MNone && VisibleRect.Contains(fixtoi(pxp->x), fixtoi(pxp->y)))
+		const int32_t mat = Mat[i];
+		const C4Real &x = X[i], &y = Y[i], &xdir = XDir[i], &ydir = YDir[i];
+		if (mat != MNone && VisibleRect.Contains(fixtoi(x), fixtoi(y)))
 		{
-			C4Material *pMat = &::MaterialMap.Map[pxp->Mat];
-			const DWORD dwMatClr = ::Landscape.GetPal()->GetClr((BYTE) (Mat2PixColDefault(pxp->Mat)));
+			C4Material *pMat = &::MaterialMap.Map[mat];
+			const DWORD dwMatClr = ::Landscape.GetPal()->GetClr((BYTE) (Mat2PixColDefault(mat)));
 			if(pMat->PXSFace.Surface)
 			{
 				int32_t pnx, pny;
@@ -231,8 +319,8 @@ void C4PXSSystem::Draw(C4TargetFacet &cgo)
 
 				const float w = z;
 				const float h = z * fcHgt / fcWdt;
-				const float x1 = fixtof(pxp->x) + cgox + z * pMat->PXSGfxRt.tx / fcWdt;
-				const float y1 = fixtof(pxp->y) + cgoy + z * pMat->PXSGfxRt.ty / fcHgt;
+				const float x1 = fixtof(x) + cgox + z * pMat->PXSGfxRt.tx / fcWdt;
+				const float y1 = fixtof(y) + cgoy + z * pMat->PXSGfxRt.ty / fcHgt;
 				const float x2 = x1 + w;
 				const float y2 = y1 + h;
 
@@ -255,7 +343,7 @@ void C4PXSSystem::Draw(C4TargetFacet &cgo)
 				vtx[4] = vtx[2];
 				vtx[5] = vtx[0];
 
-				std::vector<C4BltVertex>& vec = bltVtx[pxp->Mat];
+				std::vector<C4BltVertex>& vec = bltVtx[mat];
 				vec.push_back(vtx[0]);
 				vec.push_back(vtx[1]);
 				vec.push_back(vtx[2]);
@@ -266,14 +354,14 @@ void C4PXSSystem::Draw(C4TargetFacet &cgo)
 			else
 			{
 				// old-style: unicolored pixels or lines
-				if (fixtoi(pxp->xdir) || fixtoi(pxp->ydir))
+				if (fixtoi(xdir) || fixtoi(ydir))
 				{
 					// lines for stuff that goes whooosh!
-					int len = fixtoi(Abs(pxp->xdir) + Abs(pxp->ydir));
+					int len = fixtoi(Abs(xdir) + Abs(ydir));
 					const DWORD dwMatClrLen = uint32_t(std::max<int>(dwMatClr >> 24, 195 - (195 - (dwMatClr >> 24)) / len)) << 24 | (dwMatClr & 0xffffff);
 					C4BltVertex begin, end;
-					begin.ftx = fixtof(pxp->x - pxp->xdir) + cgox; begin.fty = fixtof(pxp->y - pxp->ydir) + cgoy;
-					end.ftx = fixtof(pxp->x) + cgox; end.fty = fixtof(pxp->y) + cgoy;
+					begin.ftx = fixtof(x - xdir) + cgox; begin.fty = fixtof(y - ydir) + cgoy;
+					end.ftx = fixtof(x) + cgox; end.fty = fixtof(y) + cgoy;
 					DwTo4UB(dwMatClrLen, begin.color);
 					DwTo4UB(dwMatClrLen, end.color);
 					lineVtx.push_back(begin);
@@ -283,14 +371,14 @@ void C4PXSSystem::Draw(C4TargetFacet &cgo)
 				{
 					// single pixels for slow stuff
 					C4BltVertex vtx;
-					vtx.ftx = fixtof(pxp->x) + cgox;
-					vtx.fty = fixtof(pxp->y) + cgoy;
+					vtx.ftx = fixtof(x) + cgox;
+					vtx.fty = fixtof(y) + cgoy;
 					DwTo4UB(dwMatClr, vtx.color);
 					pixVtx.push_back(vtx);
 				}
 			}
 		}
-	}
+	});
 
 	if(!pixVtx.empty()) pDraw->PerformMultiPix(cgo.Surface, &pixVtx[0], pixVtx.size(), nullptr);
 	if(!lineVtx.empty()) pDraw->PerformMultiLines(cgo.Surface, &lineVtx[0], lineVtx.size(), 1.0f, nullptr);
@@ -341,7 +429,10 @@ bool C4PXSSystem::Save(C4Group &hGroup)
 #endif
 	if (!hTempFile.Write(&iNumFormat, sizeof (iNumFormat)))
 		return false;
-	if (!hTempFile.Write(PXS, Count * sizeof(C4PXS)))
+	std::vector<C4PXSRecord> records(Count);
+	for (size_t i = 0; i < Count; i++)
+		records[i] = { Mat[i], X[i], Y[i], XDir[i], YDir[i] };
+	if (!hTempFile.Write(&records[0], Count * sizeof(C4PXSRecord)))
 		return false;
 
 	if (!hTempFile.Close())
@@ -364,24 +455,23 @@ bool C4PXSSystem::Load(C4Group &hGroup)
 	Clear();
 	// using C4Real or float?
 	int32_t iNumForm = 1;
-	if (iBinSize % sizeof(C4PXS) == 4)
+	if (iBinSize % sizeof(C4PXSRecord) == 4)
 	{
 		if (!hGroup.Read(&iNumForm, sizeof (iNumForm))) return false;
 		if (!Inside<int32_t>(iNumForm, 1, 2)) return false;
 		iBinSize -= 4;
 	}
 	// old pxs-files have no tag for the number format
-	else if (iBinSize % sizeof(C4PXS) != 0) return false;
+	else if (iBinSize % sizeof(C4PXSRecord) != 0) return false;
 	// calc chunk count
-	PXSNum = iBinSize / sizeof(C4PXS);
+	PXSNum = iBinSize / sizeof(C4PXSRecord);
 	if (PXSNum > PXSMax) return false;
-	if (!hGroup.Read(PXS, iBinSize)) return false;
-	// count the PXS, Peter!
-	Count = PXSNum;
-	// convert num format, if neccessary
-	for (size_t i = 0; i < Count; i++)
+	std::vector<C4PXSRecord> records(PXSNum);
+	if (PXSNum && !hGroup.Read(&records[0], iBinSize)) return false;
+	Reserve(PXSNum);
+	for (size_t i = 0; i < PXSNum; i++)
 	{
-		C4PXS *pxp = &PXS[i];
+		C4PXSRecord *pxp = &records[i];
 		if (pxp->Mat != MNone)
 		{
 			// convert number format
@@ -391,7 +481,13 @@ bool C4PXSSystem::Load(C4Group &hGroup)
 			if (iNumForm == 1) { FIXED_TO_FLOAT(&pxp->x); FIXED_TO_FLOAT(&pxp->y); FIXED_TO_FLOAT(&pxp->xdir); FIXED_TO_FLOAT(&pxp->ydir); }
 #endif
 		}
+		Mat[i] = pxp->Mat;
+		X[i] = pxp->x; Y[i] = pxp->y;
+		XDir[i] = pxp->xdir; YDir[i] = pxp->ydir;
 	}
+	// count the PXS, Peter!
+	Count = PXSNum;
+	GridValid = false;
 	return true;
 }
 
@@ -401,7 +497,7 @@ int32_t C4PXSSystem::GetCount(int32_t mat) const
 	int32_t result = 0;
 	for (size_t i = 0; i < Count; i++)
 	{
-		if (PXS[i].Mat == mat) ++result;
+		if (Mat[i] == mat) ++result;
 	}
 	return result;
 }
@@ -410,13 +506,12 @@ int32_t C4PXSSystem::GetCount(int32_t mat, int32_t x, int32_t y, int32_t wdt, in
 {
 	// count PXS of given material in given area
 	int32_t result = 0;
-	for (size_t i = 0; i < Count; i++)
+	ForEachInRect(C4Rect(x, y, wdt, hgt), [&](size_t i)
 	{
-		const C4PXS *pxp = &PXS[i];
-		if (pxp->Mat == mat || mat == MNone)
-			if (Inside(pxp->x, x, x + wdt - 1) && Inside(pxp->y, y, y + hgt - 1))
+		if (Mat[i] == mat || mat == MNone)
+			if (Inside(X[i], x, x + wdt - 1) && Inside(Y[i], y, y + hgt - 1))
 				++result;
-	}
+	});
 	return result;
 }
 
@@ -22,18 +22,11 @@
 
 #include "landscape/C4Material.h"
 
-class C4PXS
-{
-	friend class C4PXSSystem;
-protected:
-	int32_t Mat{MNone};
-	C4Real x{Fix0}, y{Fix0}, xdir{Fix0}, ydir{Fix0};
-protected:
-	bool Execute();
-	void Deactivate();
-};
+// Upper bound for the number of PXS. Storage grows on demand up to this number.
+const size_t PXSMax = 100000;
 
-const size_t PXSMax = 10000;
+// Size of the grid cells by which PXS are bucketed for area queries and drawing
+const int32_t PXSGridSize = 64;
 
 class C4PXSSystem
 {
@@ -43,7 +36,17 @@ public:
 public:
 	size_t Count;
 protected:
-	C4PXS PXS[PXSMax];
+	// PXS data as structure of arrays. Entries [0, Count) are alive.
+	std::vector<int32_t> Mat;
+	std::vector<C4Real> X, Y, XDir, YDir;
+
+	// Coarse grid index into the PXS arrays. Rebuilt lazily whenever PXS have
+	// moved, been created or been removed since the last query.
+	mutable bool GridValid = false;
+	mutable int32_t GridWdt = 0, GridHgt = 0;
+	mutable std::vector<uint32_t> GridStart; // first entry of each cell in GridIndex; one extra entry at the end
+	mutable std::vector<uint32_t> GridIndex; // PXS indices sorted by cell
+
 public:
 	void Default();
 	void Clear();
@@ -57,7 +60,13 @@ public:
 	int32_t GetCount(int32_t mat) const; // count PXS of given material
 	int32_t GetCount(int32_t mat, int32_t x, int32_t y, int32_t wdt, int32_t hgt) const; // count PXS of given material in given area. mat==-1 for all materials.
 protected:
-	C4PXS *New();
+	bool ExecutePXS(size_t i); // returns false if the PXS has been deactivated
+	void Deactivate(size_t i);
+	void Remove(size_t i); // move last PXS into slot i
+	void Reserve(size_t iCount);
+	void UpdateGrid() const;
+	int32_t GetGridCell(size_t i) const;
+	template<class Fn> void ForEachInRect(const C4Rect &rect, Fn fn) const; // call fn(i) for PXS in grid cells overlapping rect
 };
 
 extern C4PXSSystem PXS;
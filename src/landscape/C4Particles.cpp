@@ -29,6 +29,7 @@
 #include "landscape/C4Weather.h"
 #include "object/C4MeshAnimation.h"	
 #include "object/C4Object.h"
+#include "platform/C4ThreadPool.h"
 #include "script/C4Aul.h"
 #include "script/C4Value.h"
 #include "script/C4ValueArray.h"
@@ -985,17 +986,37 @@ void C4ParticleChunk::DeleteAndReplaceParticle(size_t indexToReplace, size_t ind
 	delete oldParticle;
 }
 
-bool C4ParticleChunk::Exec(C4Object *obj, float timeDelta)
+void C4ParticleChunk::PrepareExec()
 {
-	for (size_t i = 0; i < particleCount; ++i)
-	{
+	deadParticles.assign(particleCount, 0);
+}
+
+void C4ParticleChunk::Exec(C4Object *obj, float timeDelta, size_t begin, size_t end)
+{
+	// particles only touch their own data and vertices, so this does not need any lock besides the list's shared one
+	for (size_t i = begin; i < end; ++i)
 		if (!particles[i]->Exec(obj, timeDelta, sourceDefinition))
+			deadParticles[i] = 1;
+}
+
+void C4ParticleChunk::RemoveDeadParticles()
+{
+	// no particles can be added between PrepareExec and this
+	assert(deadParticles.size() == particleCount);
+	for (size_t i = 0; i < particleCount; )
+	{
+		if (deadParticles[i])
 		{
+			// the last particle takes the place of the dead one and is checked next
 			DeleteAndReplaceParticle(i, particleCount - 1);
+			deadParticles[i] = deadParticles[particleCount - 1];
 			--particleCount;
 		}
+		else
+		{
+			++i;
+		}
 	}
-	return particleCount > 0;
 }
 
 void C4ParticleChunk::Draw(C4TargetFacet cgo, C4Object *obj, C4ShaderCall& call, int texUnit, const StdProjectionMatrix& modelview)
@@ -1133,21 +1154,6 @@ C4Particle *C4ParticleChunk::AddNewParticle()
 	return newParticle;
 }
 
-void C4ParticleList::Exec(float timeDelta)
-{
-	if (particleChunks.empty()) return;
-
-	accessMutex.Enter();
-
-	for (std::list<C4ParticleChunk*>::iterator iter = particleChunks.begin(); iter != particleChunks.end();++iter)
-	{
-		C4ParticleChunk *chunk = *iter;
-		chunk->Exec(targetObject, timeDelta);
-	}
-
-	accessMutex.Leave();
-}
-
 void C4ParticleList::Draw(C4TargetFacet cgo, C4Object *obj)
 {
 	if (particleChunks.empty()) return;
@@ -1256,6 +1262,12 @@ void C4ParticleSystem::CalculationThread::Execute()
 	Particles.ExecuteCalculation();
 }
 
+// Number of particles of one chunk that are executed as one piece of work
+const size_t C4ParticleCalculationRangeSize = 1024;
+
+// Minimum number of ranges for the calculation to spread the work over worker threads
+const size_t C4ParticleMinParallelRanges = 2;
+
 C4ParticleSystem::C4ParticleSystem() : frameCounterAdvancedEvent(false)
 {
 	currentSimulationTime = 0;
@@ -1285,14 +1297,49 @@ void C4ParticleSystem::ExecuteCalculation()
 			timeDelta = (float)(gameTime - currentSimulationTime);
 		currentSimulationTime = gameTime;
 
+		// Split the chunks into ranges. The lists stay locked shared until their chunks are done,
+		// so only Create, Draw and Clear on the same list have to wait for the calculation.
+		calculationRanges.clear();
+		calculationChunks.clear();
 		particleListAccessMutex.Enter();
-
-		for (std::list<C4ParticleList>::iterator iter = particleLists.begin(); iter != particleLists.end(); ++iter)
+		for (C4ParticleList &list : particleLists)
 		{
-			iter->Exec(timeDelta);
+			list.accessMutex.Enter();
+			for (C4ParticleChunk *chunk : list.particleChunks)
+			{
+				const size_t count = chunk->GetParticleCount();
+				if (!count) continue;
+				chunk->PrepareExec();
+				list.accessMutex.EnterShared();
+				calculationChunks.push_back({&list, chunk, 0, count});
+				for (size_t begin = 0; begin < count; begin += C4ParticleCalculationRangeSize)
+					calculationRanges.push_back({&list, chunk, begin, std::min(begin + C4ParticleCalculationRangeSize, count)});
+			}
+			list.accessMutex.Leave();
 		}
-
 		particleListAccessMutex.Leave();
+
+		auto exec_range = [this, timeDelta](size_t i)
+		{
+			const CalculationRange &range = calculationRanges[i];
+			range.chunk->Exec(range.list->targetObject, timeDelta, range.begin, range.end);
+		};
+		auto remove_dead = [this](size_t i)
+		{
+			const CalculationRange &range = calculationChunks[i];
+			range.chunk->RemoveDeadParticles();
+			range.list->accessMutex.LeaveShared();
+		};
+		if (calculationRanges.size() < C4ParticleMinParallelRanges)
+		{
+			for (size_t i = 0; i < calculationRanges.size(); ++i) exec_range(i);
+			for (size_t i = 0; i < calculationChunks.size(); ++i) remove_dead(i);
+			return;
+		}
+		if (!calculationPool)
+			calculationPool = std::make_unique<C4ThreadPool>();
+		calculationPool->Run(calculationRanges.size(), exec_range);
+		calculationPool->Run(calculationChunks.size(), remove_dead);
 	}
 }
 #endif
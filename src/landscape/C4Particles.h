@@ -65,6 +65,7 @@ class C4ParticleChunk;
 class C4Particle;
 class C4ParticleProperties;
 class C4ParticleValueProvider;
+class C4ThreadPool;
 
 // core for particle defs
 class C4ParticleDefCore
@@ -351,6 +352,9 @@ private:
 	std::vector<C4Particle::DrawingData::Vertex> vertexCoordinates;
 	size_t particleCount;
 
+	// particles that died during the last Exec, removed by RemoveDeadParticles
+	std::vector<uint8_t> deadParticles;
+
 	// OpenGL optimizations
 	GLuint drawingDataVertexBufferObject;
 	unsigned int drawingDataVertexArraysObject;
@@ -373,10 +377,14 @@ public:
 	}
 	// removes all particles
 	void Clear();
-	bool Exec(C4Object *obj, float timeDelta);
+	// executes the particles in [begin, end) and marks the dead ones; different ranges can be executed in parallel after PrepareExec
+	void PrepareExec();
+	void Exec(C4Object *obj, float timeDelta, size_t begin, size_t end);
+	void RemoveDeadParticles();
 	void Draw(C4TargetFacet cgo, C4Object *obj, C4ShaderCall& call, int texUnit, const StdProjectionMatrix& modelview);
 	bool IsOfType(C4ParticleDef *def, uint32_t _blitMode, uint32_t attachment) const;
 	bool IsEmpty() const { return !particleCount; }
+	size_t GetParticleCount() const { return particleCount; }
 
 	// before adding a particle, you should ReserveSpace for it
 	C4Particle *AddNewParticle();
@@ -384,6 +392,7 @@ public:
 	void ReserveSpace(uint32_t forAmount);
 
 	friend class C4ParticleList;
+	friend class C4ParticleSystem;
 };
 
 // this class must not be copied, because deleting the contained CStdCSec twice would be fatal
@@ -399,7 +408,8 @@ private:
 	C4ParticleChunk *lastAccessedChunk;
 
 	// for making sure that the list is not drawn and calculated at the same time
-	CStdCSec accessMutex;
+	// the calculation holds it shared while the chunks are executed, everything else exclusively
+	CStdCSecEx accessMutex;
 
 public:
 	C4ParticleList(C4Object *obj = nullptr) : targetObject(obj), lastAccessedChunk(nullptr)
@@ -419,10 +429,11 @@ public:
 	// deletes all the particles
 	void Clear();
 
-	void Exec(float timeDelta = 1.f);
 	void Draw(C4TargetFacet cgo, C4Object *obj);
 	C4ParticleChunk *GetFittingParticleChunk(C4ParticleDef *def, uint32_t blitMode, uint32_t attachment, bool alreadyLocked);
 	C4Particle *AddNewParticle(C4ParticleDef *def, uint32_t blitMode, uint32_t attachment, bool alreadyLocked, int remaining = 0);
+
+	friend class C4ParticleSystem;
 };
 #endif
 
@@ -462,6 +473,19 @@ private:
 
 	CStdCSec particleListAccessMutex;
 	CStdEvent frameCounterAdvancedEvent;
+
+	// one piece of work for the pool: a range of particles of one chunk
+	struct CalculationRange
+	{
+		C4ParticleList *list;
+		C4ParticleChunk *chunk;
+		size_t begin, end;
+	};
+	std::vector<CalculationRange> calculationRanges;
+	std::vector<CalculationRange> calculationChunks; // whole chunks, for removing dead particles
+	// the calculation thread spreads the ranges over the pool
+	std::unique_ptr<C4ThreadPool> calculationPool;
+	// stopped in its destructor, so it has to be declared after the pool and the ranges
 	CalculationThread calculationThread;
 
 	int currentSimulationTime; // in game time
@@ -20,6 +20,7 @@
 #include "landscape/C4SolidMask.h"
 
 #include "graphics/C4DrawGL.h"
+#include "graphics/C4PNGPrefetch.h"
 #include "graphics/CSurface8.h"
 #include "graphics/StdPNG.h"
 #include "landscape/C4Landscape.h"
@@ -292,7 +293,7 @@ void C4SolidMask::Remove(bool fBackupAttachment)
 		// Search in area slightly larger than SolidMask because objects might have vertices slightly outside their shape
 		C4LArea SolidArea(&::Objects.Sectors, MaskPutRect.x-1, MaskPutRect.y-4, MaskPutRect.Wdt+2, MaskPutRect.Hgt+2);
 		C4LSector *pSct;
-		for (C4ObjectList *pLst=SolidArea.FirstObjectShapes(&pSct); pLst; pLst=SolidArea.NextObjectShapes(pLst, &pSct))
+		for (C4SectorObjectList *pLst=SolidArea.FirstObjectShapes(&pSct); pLst; pLst=SolidArea.NextObjectShapes(pLst, &pSct))
 			for (C4Object *pObj : *pLst)
 				if (pObj && pObj != pForObject && pObj->IsMoveableBySolidMask(pForObject->GetSolidMaskPlane()) && !pObj->Shape.CheckContact(pObj->GetX(),pObj->GetY()))
 				{
@@ -489,14 +490,18 @@ CSurface8 *C4SolidMask::LoadMaskFromFile(class C4Group &hGroup, const char *szFi
 {
 	// Construct SolidMask surface from PNG bitmap:
 	// All pixels that are more than 50% transparent are not solid
-	CPNGFile png;
-	StdBuf png_buf;
-	if (!hGroup.LoadEntry(szFilename, &png_buf)) return nullptr; // error messages done by caller
-	if (!png.Load((BYTE*)png_buf.getMData(), png_buf.getSize())) return nullptr;
-	CSurface8 *result = new CSurface8(png.iWdt, png.iHgt);
-	for (size_t y=0u; y<png.iHgt; ++y)
-		for (size_t x=0u; x<png.iWdt; ++x)
-			result->SetPix(x,y,((png.GetPix(x,y)>>24)<128) ? 0x00 : 0xff);
+	std::unique_ptr<CPNGFile> png = ::PNGPrefetch.Take(hGroup, szFilename);
+	if (!png)
+	{
+		StdBuf png_buf;
+		if (!hGroup.LoadEntry(szFilename, &png_buf)) return nullptr; // error messages done by caller
+		png = std::make_unique<CPNGFile>();
+		if (!png->Load((BYTE*)png_buf.getMData(), png_buf.getSize())) return nullptr;
+	}
+	CSurface8 *result = new CSurface8(png->iWdt, png->iHgt);
+	for (size_t y=0u; y<png->iHgt; ++y)
+		for (size_t x=0u; x<png->iWdt; ++x)
+			result->SetPix(x,y,((png->GetPix(x,y)>>24)<128) ? 0x00 : 0xff);
 	return result;
 }
 
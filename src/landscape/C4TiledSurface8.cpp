@@ -0,0 +1,219 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2016, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* 8 bpp landscape surface stored in square tiles */
+
+#include "C4Include.h"
+#include "landscape/C4TiledSurface8.h"
+
+#include "c4group/CStdFile.h"
+#include "graphics/Bitmap256.h"
+
+#include <array>
+
+C4TiledSurface8::C4TiledSurface8(int iWdt, int iHgt, BYTE byCol)
+{
+	Wdt = iWdt; Hgt = iHgt;
+	TileCntX = (Wdt + TileSize - 1) / TileSize;
+	TileCntY = (Hgt + TileSize - 1) / TileSize;
+	pPal = std::make_unique<CStdPalette>();
+	memset(pPal->Colors, 0, sizeof(pPal->Colors));
+	Tiles.resize(TileCntX * TileCntY);
+	const BYTE *pUniform = UniformTile(byCol);
+	for (Tile &tile : Tiles) tile.Pix = pUniform;
+	NoClip();
+}
+
+const BYTE *C4TiledSurface8::UniformTile(BYTE byCol)
+{
+	// one read-only tile per color, created on first use and never freed
+	static std::array<std::unique_ptr<BYTE[]>, 256> Uniform;
+	std::unique_ptr<BYTE[]> &pTile = Uniform[byCol];
+	if (!pTile)
+	{
+		pTile = std::make_unique<BYTE[]>(TileSize * TileSize);
+		memset(pTile.get(), byCol, TileSize * TileSize);
+	}
+	return pTile.get();
+}
+
+BYTE *C4TiledSurface8::Detach(Tile &tile)
+{
+	assert(!tile.Own);
+	tile.Own = std::make_unique<BYTE[]>(TileSize * TileSize);
+	memcpy(tile.Own.get(), tile.Pix, TileSize * TileSize);
+	tile.Pix = tile.Own.get();
+	return tile.Own.get();
+}
+
+bool C4TiledSurface8::IsUniformTile(int tx, int ty, BYTE byCol) const
+{
+	const Tile &tile = Tiles[ty * TileCntX + tx];
+	return !tile.Own && tile.Pix[0] == byCol;
+}
+
+void C4TiledSurface8::CompactRow(int ty)
+{
+	const int hgt = std::min(TileSize, Hgt - ty * TileSize);
+	for (int tx = 0; tx < TileCntX; ++tx)
+	{
+		Tile &tile = Tiles[ty * TileCntX + tx];
+		if (!tile.Own) continue;
+		// only pixels inside the surface count for edge tiles
+		const int wdt = std::min(TileSize, Wdt - tx * TileSize);
+		const BYTE byCol = tile.Own[0];
+		bool fUniform = true;
+		for (int y = 0; y < hgt && fUniform; ++y)
+		{
+			const BYTE *pRow = tile.Own.get() + y * TileSize;
+			for (int x = 0; x < wdt; ++x)
+				if (pRow[x] != byCol) { fUniform = false; break; }
+		}
+		if (!fUniform) continue;
+		tile.Pix = UniformTile(byCol);
+		tile.Own.reset();
+	}
+}
+
+void C4TiledSurface8::Compact()
+{
+	for (int ty = 0; ty < TileCntY; ++ty) CompactRow(ty);
+}
+
+void C4TiledSurface8::NoClip()
+{
+	ClipX=0; ClipY=0; ClipX2=Wdt-1; ClipY2=Hgt-1;
+}
+
+void C4TiledSurface8::Clip(int iX, int iY, int iX2, int iY2)
+{
+	ClipX=Clamp(iX,0,Wdt-1); ClipY=Clamp(iY,0,Hgt-1);
+	ClipX2=Clamp(iX2,0,Wdt-1); ClipY2=Clamp(iY2,0,Hgt-1);
+}
+
+void C4TiledSurface8::HLine(int iX, int iX2, int iY, int iCol)
+{
+	for (int cx=iX; cx<=iX2; cx++) SetPix(cx,iY,iCol);
+}
+
+void C4TiledSurface8::Box(int iX, int iY, int iX2, int iY2, int iCol)
+{
+	for (int cy=iY; cy<=iY2; cy++) HLine(iX,iX2,cy,iCol);
+}
+
+void C4TiledSurface8::Circle(int x, int y, int r, BYTE col)
+{
+	for (int ycnt=-r; ycnt<r; ycnt++)
+	{
+		int lwdt = (int) sqrt(float(r*r-ycnt*ycnt));
+		for (int xcnt = 2 * lwdt - 1; xcnt >= 0; xcnt--)
+			SetPix(x - lwdt + xcnt, y + ycnt, col);
+	}
+}
+
+void C4TiledSurface8::ClearBox8Only(int iX, int iY, int iWdt, int iHgt)
+{
+	// clear rect; assume clip already
+	for (int y=iY; y<iY+iHgt; ++y)
+		for (int x=iX; x<iX+iWdt; ++x)
+			_SetPix(x, y, 0);
+}
+
+void C4TiledSurface8::GetSurfaceSize(int &irX, int &irY) const
+{
+	irX=Wdt;
+	irY=Hgt;
+}
+
+void C4TiledSurface8::CopyRect(int iX, int iY, int iWdt, int iHgt, BYTE *pTo, int iToPitch) const
+{
+	assert(iX >= 0 && iY >= 0 && iX + iWdt <= Wdt && iY + iHgt <= Hgt);
+	for (int y = iY; y < iY + iHgt; ++y)
+	{
+		BYTE *pRow = pTo + (y - iY) * iToPitch;
+		// copy the row in tile-wide segments
+		for (int x = iX; x < iX + iWdt; )
+		{
+			const int len = std::min(TileSize - (x & (TileSize - 1)), iX + iWdt - x);
+			memcpy(pRow + x - iX, Tiles[(y >> TileShift) * TileCntX + (x >> TileShift)].Pix + PixOffset(x, y), len);
+			x += len;
+		}
+	}
+}
+
+std::unique_ptr<C4TiledSurface8> C4TiledSurface8::Read(CStdStream &hGroup)
+{
+	C4BMP256Info BitmapInfo;
+	// read bmpinfo-header
+	if (!hGroup.Read(&BitmapInfo,sizeof(C4BMPInfo))) return nullptr;
+	// only 8bpp can be read into a landscape
+	if (BitmapInfo.Info.biBitCount != 8) return nullptr;
+	if (!hGroup.Read(((BYTE *) &BitmapInfo)+sizeof(C4BMPInfo),sizeof(BitmapInfo)-sizeof(C4BMPInfo))) return nullptr;
+	if (!hGroup.Advance(BitmapInfo.FileBitsOffset())) return nullptr;
+	if (BitmapInfo.Info.biWidth <= 0 || BitmapInfo.Info.biHeight <= 0) return nullptr;
+
+	auto pSfc = std::make_unique<C4TiledSurface8>(BitmapInfo.Info.biWidth, BitmapInfo.Info.biHeight);
+	for (int cnt=0; cnt<256; cnt++)
+	{
+		pSfc->pPal->Colors[cnt] = C4RGB(BitmapInfo.Colors[cnt].rgbRed,
+		                                BitmapInfo.Colors[cnt].rgbGreen,
+		                                BitmapInfo.Colors[cnt].rgbBlue);
+	}
+
+	// Read lines bottom-up. Each row of tiles is compacted as soon as it is
+	// complete, so uniform areas never need more than one row of own tiles.
+	std::vector<BYTE> Buf(DWordAligned(pSfc->Wdt));
+	for (int y = pSfc->Hgt - 1; y >= 0; --y)
+	{
+		if (!hGroup.Read(Buf.data(), Buf.size())) return nullptr;
+		for (int tx = 0; tx < pSfc->TileCntX; ++tx)
+		{
+			Tile &tile = pSfc->Tiles[(y >> TileShift) * pSfc->TileCntX + tx];
+			BYTE *pPix = tile.Own ? tile.Own.get() : pSfc->Detach(tile);
+			const int x0 = tx * TileSize;
+			memcpy(pPix + PixOffset(0, y), Buf.data() + x0, std::min(TileSize, pSfc->Wdt - x0));
+		}
+		if (!(y & (TileSize - 1))) pSfc->CompactRow(y >> TileShift);
+	}
+	return pSfc;
+}
+
+bool C4TiledSurface8::Save(const char *szFilename, CStdPalette *bpPalette) const
+{
+	C4BMP256Info BitmapInfo;
+	BitmapInfo.Set(Wdt,Hgt, bpPalette ? bpPalette : pPal.get());
+
+	// Create file & write info
+	CStdFile hFile;
+
+	if ( !hFile.Create(szFilename)
+	     || !hFile.Write(&BitmapInfo,sizeof(BitmapInfo)) )
+		{ return false; }
+
+	// Write lines, padded with zeros
+	std::vector<BYTE> Buf(DWordAligned(Wdt));
+	for (int y=Hgt-1; y>=0; y--)
+	{
+		CopyRect(0, y, Wdt, 1, Buf.data(), Buf.size());
+		if (!hFile.Write(Buf.data(), Buf.size()))
+			{ return false; }
+	}
+
+	// Close file
+	hFile.Close();
+
+	// Success
+	return true;
+}
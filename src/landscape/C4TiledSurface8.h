@@ -0,0 +1,99 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2016, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* 8 bpp landscape surface stored in square tiles */
+
+#ifndef INC_C4TiledSurface8
+#define INC_C4TiledSurface8
+
+#include "lib/StdColors.h"
+
+// Pixels are kept in TileSize x TileSize tiles. A tile filled with a single
+// color points to a read-only buffer shared by all surfaces and only gets its
+// own copy when a pixel in it is changed to another color, so the large
+// uniform areas of a landscape (sky, solid rock) cost a pointer per tile.
+class C4TiledSurface8
+{
+public:
+	static const int TileShift = 6;
+	static const int TileSize = 1 << TileShift;
+
+	C4TiledSurface8(int iWdt, int iHgt, BYTE byCol = 0); // create new surface filled with given color
+	C4TiledSurface8(const C4TiledSurface8 &) = delete;
+	C4TiledSurface8 &operator=(const C4TiledSurface8 &) = delete;
+
+	int Wdt, Hgt; // size of surface
+	int TileCntX, TileCntY;
+	int ClipX, ClipY, ClipX2, ClipY2;
+	std::unique_ptr<CStdPalette> pPal;
+
+	void SetPix(int iX, int iY, BYTE byCol)
+	{
+		// clip
+		if ((iX<ClipX) || (iX>ClipX2) || (iY<ClipY) || (iY>ClipY2)) return;
+		_SetPix(iX, iY, byCol);
+	}
+	void _SetPix(int x, int y, BYTE byCol) // set pixel (bounds not checked)
+	{
+		Tile &tile = Tiles[(y >> TileShift) * TileCntX + (x >> TileShift)];
+		BYTE *pPix = tile.Own.get();
+		if (!pPix)
+		{
+			// shared tile: only copy it if the color actually changes
+			if (tile.Pix[PixOffset(x, y)] == byCol) return;
+			pPix = Detach(tile);
+		}
+		pPix[PixOffset(x, y)] = byCol;
+	}
+	BYTE GetPix(int iX, int iY) const // get pixel
+	{
+		if (iX<0 || iY<0 || iX>=Wdt || iY>=Hgt) return 0;
+		return _GetPix(iX, iY);
+	}
+	inline BYTE _GetPix(int x, int y) const // get pixel (bounds not checked)
+	{
+		return Tiles[(y >> TileShift) * TileCntX + (x >> TileShift)].Pix[PixOffset(x, y)];
+	}
+	const BYTE *GetTile(int tx, int ty) const { return Tiles[ty * TileCntX + tx].Pix; } // TileSize rows of TileSize pixels
+	bool IsUniformTile(int tx, int ty, BYTE byCol) const; // whether tile is shared and filled with given color
+
+	void HLine(int iX, int iX2, int iY, int iCol);
+	void Box(int iX, int iY, int iX2, int iY2, int iCol);
+	void Circle(int x, int y, int r, BYTE col);
+	void ClearBox8Only(int iX, int iY, int iWdt, int iHgt); // clear box; assumes clipping has been done
+	void Clip(int iX, int iY, int iX2, int iY2);
+	void NoClip();
+	void GetSurfaceSize(int &irX, int &irY) const; // get surface size
+	void CopyRect(int iX, int iY, int iWdt, int iHgt, BYTE *pTo, int iToPitch) const; // copy pixels out; rect must be inside the surface
+	void Compact(); // share tiles that have become uniform again
+
+	static std::unique_ptr<C4TiledSurface8> Read(class CStdStream &hGroup);
+	bool Save(const char *szFilename, CStdPalette * = nullptr) const;
+
+private:
+	struct Tile
+	{
+		const BYTE *Pix; // TileSize*TileSize pixels; either Own or a shared uniform tile
+		std::unique_ptr<BYTE[]> Own;
+	};
+	std::vector<Tile> Tiles;
+
+	static int PixOffset(int x, int y) { return ((y & (TileSize - 1)) << TileShift) | (x & (TileSize - 1)); }
+	static const BYTE *UniformTile(BYTE byCol);
+	BYTE *Detach(Tile &tile);
+	void CompactRow(int ty);
+};
+
+#endif
@@ -17,14 +17,35 @@
 #include "C4ForbidLibraryCompilation.h"
 #include "landscape/fow/C4FoW.h"
 #include "graphics/C4Draw.h"
+#include "landscape/C4Landscape.h"
+#include "object/C4GameObjects.h"
+#include "platform/C4ThreadPool.h"
 
 #include <cfloat>
+#include <chrono>
+#include <random>
 
+// Minimum number of light sections for Update to spread the work over worker threads
+const size_t C4FoWMinParallelSections = 8;
+
+// Number of rectangles Invalidate collects before merging them with the nearest one
+const size_t C4FoWMaxInvalidations = 16;
+
+// Size of the lights placed by Benchmark
+const int32_t C4FoWBenchmarkReach = 300, C4FoWBenchmarkFadeout = 50;
 
 C4FoW::C4FoW() = default;
 
 C4FoW::~C4FoW()
 {
+#ifndef USE_CONSOLE
+	while (pLights)
+	{
+		C4FoWLight *light = pLights;
+		pLights = pLights->getNext();
+		delete light;
+	}
+#endif
 	if (deleted_lights)
 	{
 		ClearDeletedLights();
@@ -221,17 +242,106 @@ void C4FoW::Remove(C4Object *pObj)
 void C4FoW::Invalidate(C4Rect r)
 {
 #ifndef USE_CONSOLE
-	for (C4FoWLight *pLight = pLights; pLight; pLight = pLight->getNext())
-		pLight->Invalidate(r);
+	// Digging changes the landscape pixel by pixel. Collect the changes, so the
+	// lights look at each affected area only once.
+	for (C4Rect &rect : Invalidations)
+		if (rect.Overlap(r))
+		{
+			rect.Add(r);
+			return;
+		}
+	if (Invalidations.size() < C4FoWMaxInvalidations)
+	{
+		Invalidations.push_back(r);
+		return;
+	}
+	// Too many: Merge with the rectangle that grows least
+	auto GetGrowth = [&r](C4Rect rect) { int32_t size = rect.Wdt * rect.Hgt; rect.Add(r); return rect.Wdt * rect.Hgt - size; };
+	std::min_element(Invalidations.begin(), Invalidations.end(),
+		[&GetGrowth](const C4Rect &r1, const C4Rect &r2) { return GetGrowth(r1) < GetGrowth(r2); })->Add(r);
+#endif
+}
+
+void C4FoW::ApplyInvalidations()
+{
+#ifndef USE_CONSOLE
+	for (const C4Rect &r : Invalidations)
+		for (C4FoWLight *pLight = pLights; pLight; pLight = pLight->getNext())
+			pLight->Invalidate(r);
+	Invalidations.clear();
 #endif
 }
 
 void C4FoW::Update(C4Rect r, C4Player *pPlr)
 {
 #ifndef USE_CONSOLE
+	ApplyInvalidations();
+	// Light positions are taken from the objects on the main thread
+	UpdateSections.clear();
 	for (C4FoWLight *pLight = pLights; pLight; pLight = pLight->getNext())
 		if (pLight->IsVisibleForPlayer(pPlr))
-			pLight->Update(r);
+		{
+			pLight->UpdatePosition();
+			UpdateSections.insert(UpdateSections.end(), pLight->sections.begin(), pLight->sections.end());
+		}
+	if (UpdateSections.size() < C4FoWMinParallelSections)
+	{
+		for (C4FoWLightSection *section : UpdateSections)
+			section->Update(r);
+		return;
+	}
+	// Sections are independent and only read the landscape, which cannot change while we wait for them
+	if (!UpdatePool)
+		UpdatePool = std::make_unique<C4ThreadPool>();
+	UpdatePool->Run(UpdateSections.size(), [this, r](size_t i) { UpdateSections[i]->Update(r); });
+#endif
+}
+
+void C4FoW::Benchmark(int32_t light_count)
+{
+#ifndef USE_CONSOLE
+	std::vector<C4Object *> objects;
+	for (C4Object *obj : ::Objects)
+		if (obj->Status)
+			objects.push_back(obj);
+	if (objects.empty() || light_count <= 0)
+	{
+		Log("FoW benchmark: No objects to attach lights to.");
+		return;
+	}
+	C4FoW fow;
+	for (int32_t i = 0; i < light_count; ++i)
+	{
+		C4FoWLight *light = new C4FoWLight(objects[i % objects.size()]);
+		light->SetReach(C4FoWBenchmarkReach, C4FoWBenchmarkFadeout);
+		light->pNext = fow.pLights;
+		fow.pLights = light;
+	}
+	typedef std::chrono::duration<double, std::milli> Milliseconds;
+	const C4Rect landscape(0, 0, ::Landscape.GetWidth(), ::Landscape.GetHeight());
+	auto start = std::chrono::steady_clock::now();
+	fow.Update(landscape, nullptr);
+	const double initial_time = Milliseconds(std::chrono::steady_clock::now() - start).count();
+	// Invalidate pixel by pixel as if a short tunnel was dug at a random place and update again.
+	// Not using the game's random generator, which is synchronized.
+	std::mt19937 rng(1);
+	const int32_t rounds = 100, tunnel_length = 40;
+	double invalidate_time = 0, update_time = 0;
+	for (int32_t i = 0; i < rounds; ++i)
+	{
+		const int32_t x = rng() % landscape.Wdt, y = rng() % landscape.Hgt;
+		start = std::chrono::steady_clock::now();
+		for (int32_t dx = 0; dx < tunnel_length; ++dx)
+			for (int32_t dy = 0; dy < 10; ++dy)
+				fow.Invalidate(C4Rect(x + dx - 2, y + dy - 2, 5, 5));
+		invalidate_time += Milliseconds(std::chrono::steady_clock::now() - start).count();
+		start = std::chrono::steady_clock::now();
+		fow.Update(landscape, nullptr);
+		update_time += Milliseconds(std::chrono::steady_clock::now() - start).count();
+	}
+	LogF("FoW benchmark: %d lights, %d threads: first update %.2f ms, per tunnel: invalidate %.3f ms, update %.3f ms",
+	     light_count, fow.UpdatePool ? fow.UpdatePool->GetThreadCount() + 1 : 1,
+	     initial_time, invalidate_time / rounds, update_time / rounds);
 #endif
 }
 
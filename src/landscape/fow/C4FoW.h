@@ -25,6 +25,8 @@
 #include "lib/C4Rect.h"
 #include "object/C4Object.h"
 
+class C4ThreadPool;
+
 /** Simple transformation class which allows translation and scales in x and y.
  * This is typically used to initialize shader uniforms to transform fragment
  * coordinates to some texture coordinates (e.g. landscape coordinates or
@@ -128,12 +130,27 @@ public:
 
 	/** Update all light beams within the given rectangle */
 	void Update(C4Rect r, C4Player *player);
-	/** Triggers the recalculation of all light beams within the given rectangle because the landscape changed. */
+	/** Triggers the recalculation of all light beams within the given rectangle because the landscape changed.
+	    The rectangles are collected and passed on to the lights in the next Update. */
 	void Invalidate(C4Rect r);
 
 	void Render(class C4FoWRegion *pRegion, const C4TargetFacet *pOnScreen, C4Player *pPlr, const StdProjectionMatrix& projectionMatrix);
 
+	/** Logs the time taken by Update and Invalidate with the given number of lights. The lights are attached to the
+	    objects of the running game in turn, but not registered anywhere, so the game is not affected. */
+	static void Benchmark(int32_t light_count);
+
 private:
+	/** Worker threads updating the light sections in parallel; created on first use */
+	std::unique_ptr<C4ThreadPool> UpdatePool;
+	/** Sections to be updated in the current call to Update */
+	std::vector<class C4FoWLightSection *> UpdateSections;
+	/** Landscape changes since the last Update. Overlapping rectangles are merged. */
+	std::vector<C4Rect> Invalidations;
+
+	/** Pass the collected landscape changes on to the lights */
+	void ApplyInvalidations();
+
 #ifndef USE_CONSOLE
 	// Shader for updating the frame buffer
 	C4Shader FramebufShader;
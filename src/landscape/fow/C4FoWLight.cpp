@@ -51,6 +51,12 @@ C4FoWLight::~C4FoWLight()
 
 void C4FoWLight::Invalidate(C4Rect r)
 {
+	// Out of reach of all beams?
+	const int32_t reach = std::max<int32_t>(getTotalReach(), 1) + 1;
+	C4Rect bounds(iX - reach, iY - reach, 2 * reach + 1, 2 * reach + 1);
+	if (!bounds.Overlap(r))
+		return;
+
 	for(auto & section : sections)
 		section->Invalidate(r);
 }
@@ -95,6 +101,14 @@ void C4FoWLight::SetColor(uint32_t iValue)
 }
 
 void C4FoWLight::Update(C4Rect Rec)
+{
+	UpdatePosition();
+
+	for(auto & section : sections)
+		section->Update(Rec);
+}
+
+void C4FoWLight::UpdatePosition()
 {
 	// Update position from object.
 	int32_t iNX = fixtoi(pObj->fix_x), iNY = fixtoi(pObj->fix_y);
@@ -112,9 +126,6 @@ void C4FoWLight::Update(C4Rect Rec)
 			section->Prune(0);
 		iX = iNX; iY = iNY;
 	}
-
-	for(auto & section : sections)
-		section->Update(Rec);
 }
 
 void C4FoWLight::Render(C4FoWRegion *region, const C4TargetFacet *onScreen, C4ShaderCall& call)
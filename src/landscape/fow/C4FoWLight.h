@@ -82,6 +82,8 @@ public:
 	void Invalidate(C4Rect r);
 	/** Update all light beams within the given rectangle for this light */
 	void Update(C4Rect r);
+	/** Follow the associated object. Clears all beams if it moved. Part of Update that must run on the main thread. */
+	void UpdatePosition();
 	/** Render this light*/
 	void Render(class C4FoWRegion *pRegion, const C4TargetFacet *pOnScreen, C4ShaderCall& call);
 
@@ -89,6 +89,7 @@ template <class T> T C4FoWLightSection::rtransY(T x, T y) const { return rtransD
 
 void C4FoWLightSection::ClearBeams()
 {
+	BeamIndexValid = false;
 	while (C4FoWBeam *beam = pBeams)
 	{
 		pBeams = beam->getNext();
@@ -122,13 +123,18 @@ C4FoWBeam *C4FoWLightSection::FindBeamLeftOf(int32_t x, int32_t y) const
 	y = std::max(y, 0);
 	if (!pBeams || !pBeams->isRight(x, y))
 		return nullptr;
-	// Go through list
-	// Note: In case this turns out expensive, one might think about implementing
-	// a skip-list. But I highly doubt it.
-	C4FoWBeam *beam = pBeams;
-	while (beam->getNext() && beam->getNext()->isRight(x, y))
-		beam = beam->getNext();
-	return beam;
+	// Binary search. Beams are ordered from left to right, so the point is
+	// right of all beams up to the one we are looking for.
+	if (!BeamIndexValid)
+	{
+		BeamIndex.clear();
+		for (C4FoWBeam *beam = pBeams; beam; beam = beam->getNext())
+			BeamIndex.push_back(beam);
+		BeamIndexValid = true;
+	}
+	auto it = std::partition_point(BeamIndex.begin(), BeamIndex.end(),
+		[x, y](const C4FoWBeam *beam) { return beam->isRight(x, y); });
+	return *(it - 1);
 }
 
 void C4FoWLightSection::Update(C4Rect RectIn)
@@ -194,6 +200,9 @@ void C4FoWLightSection::Update(C4Rect RectIn)
 	if (!endBeam)
 		return;
 
+	// Beams are going to be split and merged
+	BeamIndexValid = false;
+
 	// Update right end coordinates
 #ifdef LIGHT_DEBUG
 	LogSilentF("End beam is %s", endBeam->getDesc().getData());
@@ -353,12 +362,21 @@ void C4FoWLightSection::Invalidate(C4Rect r)
 {
 	// Assume normalized rectangle
 	assert(r.Wdt > 0 && r.Hgt > 0);
-	
+
+	// Transform rectangle into our coordinate system
+	C4Rect Rect = rtransRect(r);
+
+	// Behind the light, out of reach or outside of our quarter?
+	if (Rect.y + Rect.Hgt < 0 || Rect.y > pLight->getTotalReach())
+		return;
+	if (Rect.x > Rect.y + Rect.Hgt || Rect.x + Rect.Wdt < -(Rect.y + Rect.Hgt))
+		return;
+
 	// Get rectangle corners that bound the possibly affected pBeams
-	int32_t ly = RectLeftMostY(r),
-	        lx = RectLeftMostX(r),
-	        ry = RectRightMostY(r),
-	        rx = RectRightMostX(r);
+	int32_t ly = RectLeftMostY(Rect),
+	        lx = RectLeftMostX(Rect),
+	        ry = RectRightMostY(Rect),
+	        rx = RectRightMostX(Rect);
 	C4FoWBeam *lastBeam = FindBeamLeftOf(lx, ly);
 	C4FoWBeam *beam = lastBeam ? lastBeam->getNext() : pBeams;
 
@@ -366,13 +384,14 @@ void C4FoWLightSection::Invalidate(C4Rect r)
 	while (beam && !beam->isLeft(rx, ry))
 	{
 		// Dirty beam?
-		if (beam->getLeftEndY() > r.y || beam->getRightEndY() > r.y)
-			beam->Dirty(r.y);
+		if (beam->getLeftEndY() > Rect.y || beam->getRightEndY() > Rect.y)
+			beam->Dirty(Rect.y);
 
 		// Merge with last beam?
 		if (lastBeam && lastBeam->isDirty() && beam->isDirty())
 		{
 			lastBeam->MergeDirty();
+			BeamIndexValid = false;
 			beam = lastBeam->getNext();
 		}
 		else		// Advance otherwise
@@ -384,7 +403,10 @@ void C4FoWLightSection::Invalidate(C4Rect r)
 
 	// Final check for merging dirty pBeams on the right end
 	if (lastBeam && beam && lastBeam->isDirty() && beam->isDirty())
+	{
 		lastBeam->MergeDirty();
+		BeamIndexValid = false;
+	}
 
 }
 
@@ -51,6 +51,10 @@ private:
 
 	/* This section's beams */
 	C4FoWBeam *pBeams;
+
+	/* The beams in list order for binary search by angle. Rebuilt on demand after beams were added or removed. */
+	mutable std::vector<C4FoWBeam *> BeamIndex;
+	mutable bool BeamIndexValid{false};
 	
 public:
 	
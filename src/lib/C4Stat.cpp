@@ -131,7 +131,11 @@ void C4MainStat::Show()
 		pAkt = StatArray[i];
 
 		// output it!
-		if (pAkt->iCount)
+		if (pAkt->iCount && pAkt->iValueSum)
+			LogSilentF("%s: n = %u, v = %u, vd = %.2f",
+			           pAkt->strName, pAkt->iCount, pAkt->iValueSum,
+			           double(pAkt->iValueSum) / pAkt->iCount);
+		else if (pAkt->iCount)
 			LogSilentF("%s: n = %u, t = %u, td = %.2f",
 			           pAkt->strName, pAkt->iCount, pAkt->tTimeSum,
 			           double(pAkt->tTimeSum) / pAkt->iCount * 1000);
@@ -153,7 +157,10 @@ void C4MainStat::ShowPart(int FrameCounter)
 
 	// insert all stats
 	for (pAkt = pFirst; pAkt; pAkt = pAkt->pNext)
-		LogSilentF("%s: n=%u, t=%u", pAkt->strName, pAkt->iCountPart, pAkt->tTimeSumPart);
+		if (pAkt->iValueSumPart)
+			LogSilentF("%s: n=%u, v=%u", pAkt->strName, pAkt->iCountPart, pAkt->iValueSumPart);
+		else
+			LogSilentF("%s: n=%u, t=%u", pAkt->strName, pAkt->iCountPart, pAkt->tTimeSumPart);
 
 	// insert part stat end idtf
 	LogSilentF("** PartStat end\n");
@@ -179,6 +186,7 @@ void C4Stat::Reset()
 
 	tTimeSum = 0;
 	iCount = 0;
+	iValueSum = 0;
 
 	ResetPart();
 }
@@ -187,6 +195,7 @@ void C4Stat::ResetPart()
 {
 	tTimeSumPart = 0;
 	iCountPart = 0;
+	iValueSumPart = 0;
 }
 
 C4MainStat *C4Stat::getMainStat()
@@ -76,6 +76,15 @@ public:
 		}
 	}
 
+	// counts a value instead of a time, e.g. the amount of work done in one frame
+	inline void Add(uint32_t iValue)
+	{
+		iCount ++;
+		iCountPart ++;
+		iValueSum += iValue;
+		iValueSumPart += iValue;
+	}
+
 	void Reset();
 	void ResetPart();
 
@@ -101,6 +110,9 @@ protected:
 	// number of starts called
 	unsigned int iCount;
 
+	// sum of added values
+	uint32_t iValueSum;
+
 	// ** statistic data (partial stat)
 
 	// sum of times
@@ -109,6 +121,9 @@ protected:
 	// number of starts called
 	unsigned int iCountPart;
 
+	// sum of added values
+	uint32_t iValueSumPart;
+
 
 	// name of statistic
 	const char* strName;
@@ -133,6 +148,9 @@ protected:
 // used to stop an existing C4Stat object
 #define C4ST_STOP(StatName) StatName.Stop();
 
+// used to add a value to an existing C4Stat object
+#define C4ST_ADD(StatName, Value) StatName.Add(Value);
+
 // shows the statistic (to log)
 #define C4ST_SHOWSTAT C4Stat::getMainStat()->Show();
 
@@ -151,6 +169,7 @@ protected:
 #define C4ST_NEW(StatName, strName)
 #define C4ST_START(StatName)
 #define C4ST_STOP(StatName)
+#define C4ST_ADD(StatName, Value)
 #define C4ST_SHOWSTAT
 #define C4ST_SHOWPARTSTAT(FrameCounter)
 #define C4ST_RESET
@@ -259,6 +259,17 @@ namespace
 		}
 	}
 
+	// Poses used while evaluating animation trees, kept to avoid allocations in every frame
+	std::deque<StdMeshPose> PoseScratch;
+	// Pose cache key of the instance being updated, kept for the same reason
+	std::string PoseKey;
+
+	template<typename T>
+	void AppendKey(std::string& key, const T& value)
+	{
+		key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
 	// Mirror is wrt Z axis
 	void MirrorKeyFrame(StdMeshKeyFrame& frame, const StdMeshTransformation& old_bone_transformation, const StdMeshTransformation& new_inverse_bone_transformation)
 	{
@@ -290,47 +301,75 @@ namespace
 
 StdMeshTransformation StdMeshTrack::GetTransformAt(float time, float length) const
 {
-	std::map<float, StdMeshKeyFrame>::const_iterator iter = Frames.lower_bound(time);
+	unsigned int cursor = 0;
+	return GetTransformAt(time, length, cursor);
+}
+
+StdMeshTransformation StdMeshTrack::GetTransformAt(float time, float length, unsigned int& cursor) const
+{
+	// Find the first keyframe at or after time. Animations usually advance only a little
+	// between calls, so try the keyframe found last time and the one after it first.
+	const unsigned int count = Times.size();
+	auto is_next = [this, time, count](unsigned int i)
+	{
+		return i <= count && (i == 0 || Times[i - 1] < time) && (i == count || Times[i] >= time);
+	};
+	unsigned int next = cursor;
+	if (!is_next(next) && !is_next(++next))
+		next = std::lower_bound(Times.begin(), Times.end(), time) - Times.begin();
+	cursor = next;
 
 	// We are at or before the first keyframe. This short typically not
 	// happen, since all animations have a keyframe 0. Simply return the
 	// first keyframe.
-	if (iter == Frames.begin())
-		return iter->second.Transformation;
+	if (next == 0)
+		return Frames[0].Transformation;
 
-	std::map<float, StdMeshKeyFrame>::const_iterator prev_iter = iter;
-	--prev_iter;
+	const unsigned int prev = next - 1;
 
-	float iter_pos;
-	if (iter == Frames.end())
+	float next_pos;
+	if (next == count)
 	{
 		// We are beyond the last keyframe.
 		// Interpolate between the last and the first keyframe.
 		// See also bug #1406.
-		iter = Frames.begin();
-		iter_pos = length;
+		next = 0;
+		next_pos = length;
 	}
 	else
 	{
-		iter_pos = iter->first;
+		next_pos = Times[next];
 	}
 
 	// No two keyframes with the same position:
-	assert(iter_pos > prev_iter->first);
+	assert(next_pos > Times[prev]);
 
 	// Requested position is between the two selected keyframes:
-	assert(time >= prev_iter->first);
-	assert(iter_pos >= time);
+	assert(time >= Times[prev]);
+	assert(next_pos >= time);
 
-	float dt = iter_pos - prev_iter->first;
-	float weight1 = (time - prev_iter->first) / dt;
-	float weight2 = (iter_pos - time) / dt;
+	float dt = next_pos - Times[prev];
+	float weight1 = (time - Times[prev]) / dt;
+	float weight2 = (next_pos - time) / dt;
 	(void)weight2; // used in assertion only
 
 	assert(weight1 >= 0 && weight2 >= 0 && weight1 <= 1 && weight2 <= 1);
 	assert(fabs(weight1 + weight2 - 1) < 1e-6);
 
-	return StdMeshTransformation::Nlerp(prev_iter->second.Transformation, iter->second.Transformation, weight1);
+	return StdMeshTransformation::Nlerp(Frames[prev].Transformation, Frames[next].Transformation, weight1);
+}
+
+StdMeshKeyFrame& StdMeshTrack::InsertFrame(float time)
+{
+	// Loaders usually add keyframes in order
+	auto iter = std::lower_bound(Times.begin(), Times.end(), time);
+	const size_t index = iter - Times.begin();
+	if (iter == Times.end() || *iter != time)
+	{
+		Times.insert(iter, time);
+		Frames.insert(Frames.begin() + index, StdMeshKeyFrame());
+	}
+	return Frames[index];
 }
 
 StdMeshAnimation::StdMeshAnimation(const StdMeshAnimation& other):
@@ -346,6 +385,7 @@ StdMeshAnimation::StdMeshAnimation(const StdMeshAnimation& other):
 
 StdMeshAnimation::~StdMeshAnimation()
 {
+	StdMeshPoseCache::SkeletonsChanged();
 	for (auto & Track : Tracks)
 		delete Track;
 }
@@ -353,6 +393,7 @@ StdMeshAnimation::~StdMeshAnimation()
 StdMeshAnimation& StdMeshAnimation::operator=(const StdMeshAnimation& other)
 {
 	if (this == &other) return *this;
+	StdMeshPoseCache::SkeletonsChanged();
 
 	Name = other.Name;
 	Length = other.Length;
@@ -373,6 +414,7 @@ StdMeshSkeleton::StdMeshSkeleton() = default;
 
 StdMeshSkeleton::~StdMeshSkeleton()
 {
+	StdMeshPoseCache::SkeletonsChanged();
 	for (auto & Bone : Bones)
 		delete Bone;
 }
@@ -449,11 +491,11 @@ void StdMeshSkeleton::MirrorAnimation(const StdMeshAnimation& animation)
 				// Mirror all the keyframes of both tracks
 				if (new_anim.Tracks[i] != nullptr)
 					for (auto & Frame : new_anim.Tracks[i]->Frames)
-						MirrorKeyFrame(Frame.second, own_trans, StdMeshTransformation::Inverse(other_own_trans));
+						MirrorKeyFrame(Frame, own_trans, StdMeshTransformation::Inverse(other_own_trans));
 
 				if (new_anim.Tracks[other_bone->Index] != nullptr)
 					for (auto & Frame : new_anim.Tracks[other_bone->Index]->Frames)
-						MirrorKeyFrame(Frame.second, other_own_trans, StdMeshTransformation::Inverse(own_trans));
+						MirrorKeyFrame(Frame, other_own_trans, StdMeshTransformation::Inverse(own_trans));
 			}
 		}
 		else if (bone.Name.Compare_(".N", bone.Name.getLength() - 2) != 0)
@@ -464,7 +506,7 @@ void StdMeshSkeleton::MirrorAnimation(const StdMeshAnimation& animation)
 				if (bone.GetParent()) own_trans = bone.GetParent()->InverseTransformation * bone.Transformation;
 
 				for (auto & Frame : new_anim.Tracks[i]->Frames)
-					MirrorKeyFrame(Frame.second, own_trans, StdMeshTransformation::Inverse(own_trans));
+					MirrorKeyFrame(Frame, own_trans, StdMeshTransformation::Inverse(own_trans));
 			}
 		}
 	}
@@ -829,35 +871,73 @@ StdMeshInstanceAnimationNode::~StdMeshInstanceAnimationNode()
 	}
 }
 
-bool StdMeshInstanceAnimationNode::GetBoneTransform(unsigned int bone, StdMeshTransformation& transformation)
+float StdMeshInstanceAnimationNode::GetQuantizedPosition(float time_quantum) const
 {
-	StdMeshTransformation combine_with;
-	StdMeshTrack* track;
+	const float position = fixtof(Leaf.Position->Value);
+	if (time_quantum <= 0.0f) return position;
+	return std::min(std::floor(position / time_quantum + 0.5f) * time_quantum, Leaf.Animation->Length);
+}
 
+void StdMeshInstanceAnimationNode::AppendPoseKey(std::string& key, float time_quantum) const
+{
+	AppendKey(key, static_cast<uint8_t>(Type));
 	switch (Type)
 	{
 	case LeafNode:
-		track = Leaf.Animation->Tracks[bone];
-		if (!track) return false;
-		transformation = track->GetTransformAt(fixtof(Leaf.Position->Value), Leaf.Animation->Length);
-		return true;
+		AppendKey(key, Leaf.Animation);
+		AppendKey(key, GetQuantizedPosition(time_quantum));
+		break;
 	case CustomNode:
-		if(bone == Custom.BoneIndex)
-			transformation = *Custom.Transformation;
-		else
-			return false;
-		return true;
+		AppendKey(key, Custom.BoneIndex);
+		AppendKey(key, Custom.Transformation->translate.x); AppendKey(key, Custom.Transformation->translate.y); AppendKey(key, Custom.Transformation->translate.z);
+		AppendKey(key, Custom.Transformation->rotate.w); AppendKey(key, Custom.Transformation->rotate.x); AppendKey(key, Custom.Transformation->rotate.y); AppendKey(key, Custom.Transformation->rotate.z);
+		AppendKey(key, Custom.Transformation->scale.x); AppendKey(key, Custom.Transformation->scale.y); AppendKey(key, Custom.Transformation->scale.z);
+		break;
 	case LinearInterpolationNode:
-		if (!LinearInterpolation.ChildLeft->GetBoneTransform(bone, transformation))
-			return LinearInterpolation.ChildRight->GetBoneTransform(bone, transformation);
-		if (!LinearInterpolation.ChildRight->GetBoneTransform(bone, combine_with))
-			return true; // First Child affects bone
+		AppendKey(key, fixtof(LinearInterpolation.Weight->Value));
+		LinearInterpolation.ChildLeft->AppendPoseKey(key, time_quantum);
+		LinearInterpolation.ChildRight->AppendPoseKey(key, time_quantum);
+		break;
+	default:
+		assert(false);
+	}
+}
 
-		transformation = StdMeshTransformation::Nlerp(transformation, combine_with, fixtof(LinearInterpolation.Weight->Value));
-		return true;
+void StdMeshInstanceAnimationNode::GetBoneTransforms(StdMeshPose& pose, std::deque<StdMeshPose>& scratch, float time_quantum, size_t depth)
+{
+	const size_t bone_count = pose.GetBoneCount();
+	pose.Reset(bone_count);
+
+	switch (Type)
+	{
+	case LeafNode:
+	{
+		const std::vector<StdMeshTrack*>& tracks = Leaf.Animation->Tracks;
+		if (TrackCursors.size() != tracks.size()) TrackCursors.assign(tracks.size(), 0);
+		const float position = GetQuantizedPosition(time_quantum);
+		const size_t count = std::min(tracks.size(), bone_count);
+		for (size_t i = 0; i < count; ++i)
+			if (tracks[i])
+				pose.Set(i, tracks[i]->GetTransformAt(position, Leaf.Animation->Length, TrackCursors[i]));
+		break;
+	}
+	case CustomNode:
+		if (Custom.BoneIndex < bone_count)
+			pose.Set(Custom.BoneIndex, *Custom.Transformation);
+		break;
+	case LinearInterpolationNode:
+	{
+		// Blend the right child into the left one; bones affected by only one child keep its transformation
+		if (scratch.size() <= depth) scratch.resize(depth + 1);
+		StdMeshPose& right = scratch[depth];
+		right.Reset(bone_count);
+		LinearInterpolation.ChildLeft->GetBoneTransforms(pose, scratch, time_quantum, depth + 1);
+		LinearInterpolation.ChildRight->GetBoneTransforms(right, scratch, time_quantum, depth + 1);
+		pose.Blend(right, fixtof(LinearInterpolation.Weight->Value));
+		break;
+	}
 	default:
 		assert(false);
-		return false;
 	}
 }
 
@@ -1472,34 +1552,44 @@ bool StdMeshInstance::UpdateBoneTransforms()
 {
 	bool was_dirty = BoneTransformsDirty;
 
+	// Instances in the same animation state share their bone matrices
+	const StdMeshPoseCache::BoneMatrices* cached = nullptr;
+	const bool use_cache = BoneTransformsDirty && ::MeshPoseCache.IsEnabled() && !AnimationStack.empty();
+	const float time_quantum = use_cache ? ::MeshPoseCache.GetTimeQuantum() : 0.0f;
+	if (use_cache)
+	{
+		GetPoseKey(PoseKey, time_quantum);
+		cached = ::MeshPoseCache.Lookup(PoseKey);
+	}
+
 	// Nothing changed since last time
-	if (BoneTransformsDirty)
+	if (cached)
 	{
-		// Compute transformation matrix for each bone.
-		for (unsigned int i = 0; i < BoneTransforms.size(); ++i)
+		BoneTransforms = *cached;
+	}
+	else if (BoneTransformsDirty)
+	{
+		// Evaluate the animation stack for all bones at once
+		const size_t bone_count = BoneTransforms.size();
+		if (PoseScratch.size() < 2) PoseScratch.resize(2);
+		StdMeshPose& pose = PoseScratch[0];
+		StdMeshPose& slot_pose = PoseScratch[1];
+		pose.Reset(bone_count);
+		slot_pose.Reset(bone_count);
+		for (auto & node : AnimationStack)
 		{
-			StdMeshTransformation Transformation;
+			node->GetBoneTransforms(slot_pose, PoseScratch, time_quantum, 2);
+			pose.Blend(slot_pose, 1.0f); // TODO: Allow custom weighing for slot combination
+		}
 
+		// Compute transformation matrix for each bone.
+		for (unsigned int i = 0; i < bone_count; ++i)
+		{
 			const StdMeshBone& bone = Mesh->GetSkeleton().GetBone(i);
 			const StdMeshBone* parent = bone.GetParent();
 			assert(!parent || parent->Index < i);
 
-			bool have_transform = false;
-			for (auto & j : AnimationStack)
-			{
-				if (have_transform)
-				{
-					StdMeshTransformation other;
-					if (j->GetBoneTransform(i, other))
-						Transformation = StdMeshTransformation::Nlerp(Transformation, other, 1.0f); // TODO: Allow custom weighing for slot combination
-				}
-				else
-				{
-					have_transform = j->GetBoneTransform(i, Transformation);
-				}
-			}
-
-			if (!have_transform)
+			if (!pose.IsSet(i))
 			{
 				if (parent)
 					BoneTransforms[i] = BoneTransforms[parent->Index];
@@ -1508,10 +1598,14 @@ bool StdMeshInstance::UpdateBoneTransforms()
 			}
 			else
 			{
+				StdMeshTransformation Transformation;
+				pose.Get(i, Transformation);
 				BoneTransforms[i] = StdMeshMatrix::Transform(bone.Transformation * Transformation * bone.InverseTransformation);
 				if (parent) BoneTransforms[i] = BoneTransforms[parent->Index] * BoneTransforms[i];
 			}
 		}
+
+		if (use_cache) ::MeshPoseCache.Store(PoseKey, BoneTransforms);
 	}
 
 	// Update attachment's attach transformations. Note this is done recursively.
@@ -1549,6 +1643,16 @@ bool StdMeshInstance::UpdateBoneTransforms()
 	return was_dirty;
 }
 
+void StdMeshInstance::GetPoseKey(std::string& key, float time_quantum) const
+{
+	// The bone matrices depend on the skeleton and on the complete animation stack
+	key.clear();
+	AppendKey(key, &Mesh->GetSkeleton());
+	AppendKey(key, BoneTransforms.size());
+	for (auto node : AnimationStack)
+		node->AppendPoseKey(key, time_quantum);
+}
+
 void StdMeshInstance::ReorderFaces(StdMeshMatrix* global_trans)
 {
 #ifndef USE_CONSOLE
@@ -20,6 +20,9 @@
 #include "C4ForbidLibraryCompilation.h"
 #include "lib/StdMeshMaterial.h"
 #include "lib/StdMeshMath.h"
+#include "lib/StdMeshPose.h"
+
+#include <deque>
 
 class StdMeshBone
 {
@@ -75,9 +78,15 @@ class StdMeshTrack
 	friend class StdMeshSkeletonLoader;
 public:
 	StdMeshTransformation GetTransformAt(float time, float length) const;
+	// cursor is the keyframe index found by the previous call, to be continued from
+	StdMeshTransformation GetTransformAt(float time, float length, unsigned int& cursor) const;
 
 private:
-	std::map<float, StdMeshKeyFrame> Frames;
+	StdMeshKeyFrame& InsertFrame(float time); // returns existing frame at time
+
+	// Sorted by time, in contiguous arrays so lookups don't chase pointers
+	std::vector<float> Times;
+	std::vector<StdMeshKeyFrame> Frames;
 };
 
 // Animation, consists of one Track for each animated Bone
@@ -340,7 +349,12 @@ public:
 	StdMeshInstanceAnimationNode(AnimationNode* child_left, AnimationNode* child_right, ValueProvider* weight);
 	~StdMeshInstanceAnimationNode();
 
-	bool GetBoneTransform(unsigned int bone, StdMeshTransformation& transformation);
+	// Evaluate the transformations of all bones affected by this node. scratch holds
+	// temporary poses of child nodes, indexed by depth. Positions are rounded to multiples
+	// of time_quantum, if nonzero.
+	void GetBoneTransforms(StdMeshPose& pose, std::deque<StdMeshPose>& scratch, float time_quantum, size_t depth = 0);
+	// Append everything the result of GetBoneTransforms depends on to key
+	void AppendPoseKey(std::string& key, float time_quantum) const;
 
 	int GetSlot() const { return Slot; }
 	unsigned int GetNumber() const { return Number; }
@@ -365,6 +379,9 @@ protected:
 	unsigned int Number;
 	NodeType Type{LeafNode};
 	AnimationNode* Parent{nullptr}; // NoSave
+	std::vector<unsigned int> TrackCursors; // NoSave, leaf nodes: keyframe index last used per track
+
+	float GetQuantizedPosition(float time_quantum) const;
 
 	union
 	{
@@ -643,6 +660,7 @@ protected:
 	bool ExecuteAnimationNode(AnimationNode* node);
 	void ApplyBoneTransformToVertices(const std::vector<StdSubMesh::Vertex>& mesh_vertices, std::vector<StdMeshVertex>& instance_vertices);
 	void SetBoneTransformsDirty(bool value);
+	void GetPoseKey(std::string& key, float time_quantum) const;
 
 	const StdMesh *Mesh;
 
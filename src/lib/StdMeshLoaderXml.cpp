@@ -494,7 +494,7 @@ void StdMeshSkeletonLoader::LoadSkeletonXml(const char* groupname, const char* f
 				for (TiXmlElement* keyframe_elem = keyframes_elem->FirstChildElement("keyframe"); keyframe_elem != nullptr; keyframe_elem = keyframe_elem->NextSiblingElement("keyframe"))
 				{
 					float time = skeleton->RequireFloatAttribute(keyframe_elem, "time");
-					StdMeshKeyFrame& frame = track->Frames[time];
+					StdMeshKeyFrame& frame = track->InsertFrame(time);
 
 					TiXmlElement* translate_elem = keyframe_elem->FirstChildElement("translate");
 					TiXmlElement* rotate_elem = keyframe_elem->FirstChildElement("rotate");
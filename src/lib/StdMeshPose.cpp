@@ -0,0 +1,149 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2016, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4Include.h"
+#include "lib/StdMeshPose.h"
+
+void StdMeshPose::Reset(size_t bone_count)
+{
+	Valid.assign(bone_count, 0);
+	for (std::vector<float>* component : { &TX, &TY, &TZ, &RW, &RX, &RY, &RZ, &SX, &SY, &SZ })
+		component->resize(bone_count);
+}
+
+void StdMeshPose::Get(size_t bone, StdMeshTransformation& transformation) const
+{
+	transformation.translate.x = TX[bone]; transformation.translate.y = TY[bone]; transformation.translate.z = TZ[bone];
+	transformation.rotate.w = RW[bone]; transformation.rotate.x = RX[bone]; transformation.rotate.y = RY[bone]; transformation.rotate.z = RZ[bone];
+	transformation.scale.x = SX[bone]; transformation.scale.y = SY[bone]; transformation.scale.z = SZ[bone];
+}
+
+void StdMeshPose::Set(size_t bone, const StdMeshTransformation& transformation)
+{
+	Valid[bone] = 1;
+	TX[bone] = transformation.translate.x; TY[bone] = transformation.translate.y; TZ[bone] = transformation.translate.z;
+	RW[bone] = transformation.rotate.w; RX[bone] = transformation.rotate.x; RY[bone] = transformation.rotate.y; RZ[bone] = transformation.rotate.z;
+	SX[bone] = transformation.scale.x; SY[bone] = transformation.scale.y; SZ[bone] = transformation.scale.z;
+}
+
+void StdMeshPose::Blend(const StdMeshPose& other, float w)
+{
+	assert(other.GetBoneCount() == GetBoneCount());
+	const size_t count = GetBoneCount();
+	const float v = 1 - w;
+	// Branch-free loops over all bones: blend everything, then select per bone.
+	// The operations match StdMeshTransformation::Nlerp exactly.
+	auto blend_linear = [count, v, w, this, &other](std::vector<float>& lhs_vec, const std::vector<float>& rhs_vec)
+	{
+		float* lhs = &lhs_vec[0]; const float* rhs = &rhs_vec[0];
+		const uint8_t* lhs_valid = &Valid[0]; const uint8_t* rhs_valid = &other.Valid[0];
+		for (size_t i = 0; i < count; ++i)
+		{
+			const float blended = v * lhs[i] + w * rhs[i];
+			lhs[i] = rhs_valid[i] ? (lhs_valid[i] ? blended : rhs[i]) : lhs[i];
+		}
+	};
+	if (!count) return;
+	blend_linear(TX, other.TX); blend_linear(TY, other.TY); blend_linear(TZ, other.TZ);
+	blend_linear(SX, other.SX); blend_linear(SY, other.SY); blend_linear(SZ, other.SZ);
+
+	float* rw = &RW[0]; float* rx = &RX[0]; float* ry = &RY[0]; float* rz = &RZ[0];
+	const float* ow = &other.RW[0]; const float* ox = &other.RX[0]; const float* oy = &other.RY[0]; const float* oz = &other.RZ[0];
+	uint8_t* valid = &Valid[0]; const uint8_t* other_valid = &other.Valid[0];
+	for (size_t i = 0; i < count; ++i)
+	{
+		// Quaternion nlerp along the shorter arc
+		const float c = rw[i] * ow[i] + rx[i] * ox[i] + ry[i] * oy[i] + rz[i] * oz[i];
+		const float sign = c < 0.0f ? -1.0f : 1.0f;
+		float qw = rw[i] + w * (sign * ow[i] - rw[i]);
+		float qx = rx[i] + w * (sign * ox[i] - rx[i]);
+		float qy = ry[i] + w * (sign * oy[i] - ry[i]);
+		float qz = rz[i] + w * (sign * oz[i] - rz[i]);
+		const float length = sqrt(qw*qw + qx*qx + qy*qy + qz*qz);
+		qw /= length; qx /= length; qy /= length; qz /= length;
+		const bool both = valid[i] && other_valid[i];
+		const bool take_other = other_valid[i] && !valid[i];
+		rw[i] = both ? qw : take_other ? ow[i] : rw[i];
+		rx[i] = both ? qx : take_other ? ox[i] : rx[i];
+		ry[i] = both ? qy : take_other ? oy[i] : ry[i];
+		rz[i] = both ? qz : take_other ? oz[i] : rz[i];
+		valid[i] |= other_valid[i];
+	}
+}
+
+unsigned int StdMeshPoseCache::SkeletonGeneration = 0;
+StdMeshPoseCache MeshPoseCache;
+
+void StdMeshPoseCache::SetEnabled(bool enabled)
+{
+	Enabled = enabled;
+	if (!Enabled) Entries.clear();
+}
+
+void StdMeshPoseCache::SetTimeQuantum(float quantum)
+{
+	// Entries were evaluated at positions rounded differently
+	if (quantum != TimeQuantum) Entries.clear();
+	TimeQuantum = std::max(quantum, 0.0f);
+}
+
+void StdMeshPoseCache::CheckGeneration()
+{
+	if (Generation == SkeletonGeneration) return;
+	Entries.clear();
+	Generation = SkeletonGeneration;
+}
+
+const StdMeshPoseCache::BoneMatrices* StdMeshPoseCache::Lookup(const std::string& key)
+{
+	CheckGeneration();
+	auto iter = Entries.find(key);
+	if (iter == Entries.end())
+	{
+		++MissCnt;
+		return nullptr;
+	}
+	++HitCnt;
+	iter->second.LastUsed = Frame;
+	return &iter->second.BoneTransforms;
+}
+
+void StdMeshPoseCache::Store(const std::string& key, const BoneMatrices& bone_transforms)
+{
+	CheckGeneration();
+	Entry& entry = Entries[key];
+	entry.BoneTransforms = bone_transforms;
+	entry.LastUsed = Frame;
+	MaxEntryCnt = std::max<unsigned int>(MaxEntryCnt, Entries.size());
+}
+
+void StdMeshPoseCache::NextFrame()
+{
+	// Entries of animations that advanced are never hit again
+	for (auto iter = Entries.begin(); iter != Entries.end(); )
+	{
+		if (iter->second.LastUsed != Frame)
+			iter = Entries.erase(iter);
+		else
+			++iter;
+	}
+	++Frame;
+}
+
+void StdMeshPoseCache::Clear()
+{
+	Entries.clear();
+	HitCnt = MissCnt = MaxEntryCnt = 0;
+}
@@ -0,0 +1,90 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2016, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#ifndef INC_StdMeshPose
+#define INC_StdMeshPose
+
+#include "lib/StdMeshMath.h"
+
+#include <unordered_map>
+
+// Transformations of all bones of a skeleton, stored component-wise so that
+// animation blending runs over plain float arrays that the compiler can vectorize.
+class StdMeshPose
+{
+public:
+	size_t GetBoneCount() const { return Valid.size(); }
+	void Reset(size_t bone_count); // no bone transformed
+	bool IsSet(size_t bone) const { return Valid[bone] != 0; }
+	void Get(size_t bone, StdMeshTransformation& transformation) const;
+	void Set(size_t bone, const StdMeshTransformation& transformation);
+	// Nlerp towards other for bones set in both poses, take bones only set in other.
+	// Same result as StdMeshTransformation::Nlerp per bone.
+	void Blend(const StdMeshPose& other, float w);
+
+private:
+	std::vector<uint8_t> Valid;
+	std::vector<float> TX, TY, TZ; // translate
+	std::vector<float> RW, RX, RY, RZ; // rotate
+	std::vector<float> SX, SY, SZ; // scale
+};
+
+// Bone matrices of recently evaluated animation states, shared by all instances of a
+// skeleton that play the same animations at the same positions (e.g. a forest of idle
+// trees). Entries are keyed by the complete animation stack, so a hit always yields
+// the matrices the instance would have computed itself.
+class StdMeshPoseCache
+{
+public:
+	typedef std::vector<StdMeshMatrix> BoneMatrices;
+
+	void SetEnabled(bool enabled);
+	bool IsEnabled() const { return Enabled; }
+	// Animation positions are rounded to multiples of quantum (in seconds) before evaluation,
+	// so that instances at nearby positions share a pose. 0 shares identical positions only.
+	void SetTimeQuantum(float quantum);
+	float GetTimeQuantum() const { return TimeQuantum; }
+
+	const BoneMatrices* Lookup(const std::string& key);
+	void Store(const std::string& key, const BoneMatrices& bone_transforms);
+	void NextFrame(); // drop entries not used since the previous call; call once per game frame
+	void Clear(); // drop all entries and reset statistics
+
+	// Skeletons or animations were modified or deleted, so keys may refer to stale pointers.
+	// Only bumps a counter, so this is safe to call from destructors of static objects.
+	static void SkeletonsChanged() { ++SkeletonGeneration; }
+
+	// statistics
+	unsigned int HitCnt{0}, MissCnt{0}, MaxEntryCnt{0};
+
+private:
+	struct Entry
+	{
+		BoneMatrices BoneTransforms;
+		unsigned int LastUsed;
+	};
+	std::unordered_map<std::string, Entry> Entries;
+	unsigned int Frame{0};
+	unsigned int Generation{0}; // value of SkeletonGeneration the entries belong to
+	bool Enabled{true};
+	float TimeQuantum{0.0f};
+
+	static unsigned int SkeletonGeneration;
+	void CheckGeneration();
+};
+
+extern StdMeshPoseCache MeshPoseCache;
+
+#endif
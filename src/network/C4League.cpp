@@ -121,6 +121,7 @@ void C4LeagueResponseHeadStart::CompileFunc(StdCompiler *pComp)
 	// League name
 	pComp->Value(mkNamingAdapt(League, "League", ""));
 	pComp->Value(mkNamingAdapt(StreamingAddr, "StreamTo", ""));
+	pComp->Value(mkNamingAdapt(StreamingCodecs, "StreamCodecs", ""));
 	pComp->Value(mkNamingCountAdapt(fHaveSeed, "Seed"));
 	if (fHaveSeed)
 		pComp->Value(mkNamingAdapt(iSeed, "Seed", (int32_t)0));
@@ -309,7 +310,7 @@ bool C4LeagueClient::Start(const C4Network2Reference &Ref)
 	return Query(QueryText.getData(), false);
 }
 
-bool C4LeagueClient::GetStartReply(StdStrBuf *pMessage, StdStrBuf *pLeague, StdStrBuf *pStreamingAddr, int32_t *pSeed, int32_t *pMaxPlayers)
+bool C4LeagueClient::GetStartReply(StdStrBuf *pMessage, StdStrBuf *pLeague, StdStrBuf *pStreamingAddr, StdStrBuf *pStreamingCodecs, int32_t *pSeed, int32_t *pMaxPlayers)
 {
 	if (!isSuccess() || eCurrAction != C4LA_Start) return false;
 	// Parse response head
@@ -323,6 +324,8 @@ bool C4LeagueClient::GetStartReply(StdStrBuf *pMessage, StdStrBuf *pLeague, StdS
 		pLeague->Copy(Head.getLeague());
 	if (pStreamingAddr)
 		pStreamingAddr->Copy(Head.getStreamingAddr());
+	if (pStreamingCodecs)
+		pStreamingCodecs->Copy(Head.getStreamingCodecs());
 	if (pSeed && Head.haveSeed())
 		*pSeed = Head.getSeed();
 	if (pMaxPlayers)
@@ -133,6 +133,7 @@ class C4LeagueResponseHeadStart : public C4LeagueResponseHead
 private:
 	StdCopyStrBuf League;
 	StdCopyStrBuf StreamingAddr;
+	StdCopyStrBuf StreamingCodecs; // comma-separated codec names accepted for streaming; zlib if empty
 	int32_t fHaveSeed;
 	int32_t iSeed;
 	int32_t iMaxPlayers;
@@ -140,6 +141,7 @@ private:
 public:
 	const char *getLeague() const { return League.getData(); }
 	const char *getStreamingAddr() const { return StreamingAddr.getData(); }
+	const char *getStreamingCodecs() const { return StreamingCodecs.getData(); }
 	bool haveSeed() const { return !!fHaveSeed; }
 	int32_t getSeed() const { return iSeed; }
 	int32_t getMaxPlayers() const { return iMaxPlayers; }
@@ -218,7 +220,7 @@ public:
 
 	// Action "Start"
 	bool Start(const C4Network2Reference &Ref);
-	bool GetStartReply(StdStrBuf *pMessage, StdStrBuf *pLeague, StdStrBuf *pStreamingAddr, int32_t *pSeed, int32_t *pMaxPlayers);
+	bool GetStartReply(StdStrBuf *pMessage, StdStrBuf *pLeague, StdStrBuf *pStreamingAddr, StdStrBuf *pStreamingCodecs, int32_t *pSeed, int32_t *pMaxPlayers);
 
 	// Action "Update"
 	bool Update(const C4Network2Reference &Ref);
@@ -1243,9 +1243,14 @@ void C4Network2::HandleConn(const C4PacketConn &Pkt, C4Network2IOConnection *pCo
 
 	// check engine version
 	bool fWrongPassword = false;
-	if (Pkt.getVer() != C4XVER1*100 + C4XVER2)
+	if (C4PacketConn::GetEngineVer(Pkt.getVer()) != C4XVER1*100 + C4XVER2)
 	{
-		reply.Format("wrong engine (%d.%d, I have %d.%d)", Pkt.getVer()/100, Pkt.getVer()%100, C4XVER1, C4XVER2);
+		reply.Format("wrong engine (%d.%d, I have %d.%d)", C4PacketConn::GetEngineVer(Pkt.getVer())/100, C4PacketConn::GetEngineVer(Pkt.getVer())%100, C4XVER1, C4XVER2);
+		fOK = false;
+	}
+	else if (Pkt.getVer() != C4PacketConn::GetLocalVer())
+	{
+		reply.Format("wrong network protocol (revision %d, I have %d)", C4PacketConn::GetProtocolRevision(Pkt.getVer()), C4NetProtocolRevision);
 		fOK = false;
 	}
 	else
@@ -2194,10 +2199,10 @@ bool C4Network2::LeagueStart(bool *pCancel)
 		delete pDlg;
 	}
 	// Error?
-	StdStrBuf LeagueServerMessage, League, StreamingAddr;
+	StdStrBuf LeagueServerMessage, League, StreamingAddr, StreamingCodecs;
 	int32_t Seed = Game.RandomSeed, MaxPlayersLeague = 0;
 	if (!pLeagueClient->isSuccess() ||
-	    !pLeagueClient->GetStartReply(&LeagueServerMessage, &League, &StreamingAddr, &Seed, &MaxPlayersLeague))
+	    !pLeagueClient->GetStartReply(&LeagueServerMessage, &League, &StreamingAddr, &StreamingCodecs, &Seed, &MaxPlayersLeague))
 	{
 		const char *pError = pLeagueClient->GetError() ? pLeagueClient->GetError() :
 		                     LeagueServerMessage.getLength() ? LeagueServerMessage.getData() :
@@ -2255,10 +2260,12 @@ bool C4Network2::LeagueStart(bool *pCancel)
 	{
 		Game.Parameters.LeagueAddress.Clear();
 		Game.Parameters.StreamAddress.Clear();
+		StreamCodec = NCC_Zlib;
 	}
 	else
 	{
 		Game.Parameters.StreamAddress = StreamingAddr;
+		StreamCodec = C4Network2Codecs::ChooseStream(StreamingCodecs.getData());
 	}
 
 	// All ok
@@ -2888,14 +2895,12 @@ bool C4Network2::StartStreaming(C4Record *pRecord)
 	iLastStreamAttempt = time(nullptr);
 
 	// Initialize compressor
-	ZeroMem(&StreamCompressor, sizeof(StreamCompressor));
-	if (deflateInit(&StreamCompressor, 9) != Z_OK)
+	if (!StreamCompressor.Init(StreamCodec, StreamCodec == NCC_Zstd ? C4NetStreamingZstdLevel : C4NetStreamingZlibLevel))
 		return false;
 
 	// Create stream buffer
 	StreamingBuf.New(C4NetStreamingMaxBlockSize);
-	StreamCompressor.next_out = reinterpret_cast<BYTE*>(StreamingBuf.getMData());
-	StreamCompressor.avail_out = C4NetStreamingMaxBlockSize;
+	iStreamPending = 0;
 
 	// Initialize HTTP client
 	pStreamer = new C4HTTPClient();
@@ -2931,8 +2936,9 @@ bool C4Network2::StopStreaming()
 	Application.Remove(pStreamer);
 	fStreaming = false;
 	pStreamedRecord = nullptr;
-	deflateEnd(&StreamCompressor);
+	StreamCompressor.Clear();
 	StreamingBuf.Clear();
+	iStreamPending = 0;
 	delete pStreamer;
 	pStreamer = nullptr;
 
@@ -2947,36 +2953,30 @@ bool C4Network2::StreamIn(bool fFinish)
 	// Get data from record
 	const StdBuf &Data = pStreamedRecord->GetStreamingBuf();
 	if (!fFinish)
-		if (!Data.getSize() || !StreamCompressor.avail_out)
+		if (!Data.getSize() || iStreamPending >= StreamingBuf.getSize())
 			return false;
 
 	do
 	{
 
 		// Compress
-		StreamCompressor.next_in = const_cast<BYTE *>(getBufPtr<BYTE>(Data));
-		StreamCompressor.avail_in = Data.getSize();
-		int ret = deflate(&StreamCompressor, fFinish ? Z_FINISH : Z_NO_FLUSH);
+		size_t iInAmount, iOutAmount; bool fFinished;
+		if (!StreamCompressor.Process(Data.getData(), Data.getSize(), &iInAmount,
+		                              getMBufPtr<BYTE>(StreamingBuf, iStreamPending), StreamingBuf.getSize() - iStreamPending, &iOutAmount,
+		                              fFinish, &fFinished))
+			return false;
+		iStreamPending += iOutAmount;
 
 		// Anything consumed?
-		unsigned int iInAmount = Data.getSize() - StreamCompressor.avail_in;
 		if (iInAmount > 0)
 			pStreamedRecord->ClearStreamingBuf(iInAmount);
 
 		// Done?
-		if (!fFinish || ret == Z_STREAM_END)
+		if (!fFinish || fFinished)
 			break;
 
-		// Error while finishing?
-		if (ret != Z_OK)
-			return false;
-
 		// Enlarge buffer, if neccessary
-		size_t iPending = getPendingStreamData();
-		size_t iGrow = StreamingBuf.getSize();
-		StreamingBuf.Grow(iGrow);
-		StreamCompressor.avail_out += iGrow;
-		StreamCompressor.next_out = getMBufPtr<BYTE>(StreamingBuf, iPending);
+		StreamingBuf.Grow(StreamingBuf.getSize());
 
 	}
 	while (true);
@@ -2999,8 +2999,7 @@ bool C4Network2::StreamOut()
 			StreamingBuf.Move(iCurrentStreamAmount, getPendingStreamData() - iCurrentStreamAmount);
 
 		// Free buffer space
-		StreamCompressor.next_out -= iCurrentStreamAmount;
-		StreamCompressor.avail_out += iCurrentStreamAmount;
+		iStreamPending -= iCurrentStreamAmount;
 
 		// Advance stream
 		iCurrentStreamPosition += iCurrentStreamAmount;
@@ -3036,6 +3035,8 @@ bool C4Network2::StreamOut()
 	// Set stream address
 	StdStrBuf StreamAddr;
 	StreamAddr.Copy(Game.Parameters.StreamAddress);
+	if (StreamCodec != NCC_Zlib)
+		StreamAddr.AppendFormat("codec=%s&", C4Network2Codecs::GetName(StreamCodec));
 	StreamAddr.AppendFormat("pos=%d&end=%d", iCurrentStreamPosition, !pStreamedRecord);
 	pStreamer->SetServer(StreamAddr.getData());
 
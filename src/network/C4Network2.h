@@ -21,6 +21,7 @@
 #include "gui/C4Gui.h"
 #include "network/C4NetIO.h"
 #include "network/C4Network2Client.h"
+#include "network/C4Network2Codec.h"
 #include "network/C4Network2IO.h"
 #include "network/C4Network2Players.h"
 #include "network/C4Network2Res.h"
@@ -56,6 +57,10 @@ const unsigned int C4NetMinVotingInterval = 120; // (s)
 const size_t C4NetStreamingMinBlockSize = 10 * 1024;
 const size_t C4NetStreamingMaxBlockSize = 20 * 1024;
 const int C4NetStreamingInterval = 30; // (s)
+// Compression levels: zlib's default costs a fraction of level 9 for nearly the same size,
+// zstd's default beats both in speed and size
+const int C4NetStreamingZlibLevel = Z_DEFAULT_COMPRESSION,
+          C4NetStreamingZstdLevel = 3;
 
 enum C4NetGameState
 {
@@ -188,7 +193,9 @@ protected:
 	time_t iLastStreamAttempt;
 	C4Record *pStreamedRecord;
 	StdBuf StreamingBuf;
-	z_stream StreamCompressor;
+	size_t iStreamPending{0}; // compressed data in StreamingBuf
+	C4Network2Codec StreamCodec{NCC_Zlib}; // negotiated with the league server
+	C4Network2StreamCompressor StreamCompressor;
 
 	class C4HTTPClient *pStreamer;
 	unsigned int iCurrentStreamAmount, iCurrentStreamPosition;
@@ -297,7 +304,7 @@ public:
 	bool isLobbyCountDown() { return pLobbyCountdown != nullptr; }
 
 	// streaming
-	size_t getPendingStreamData() const { return StreamingBuf.getSize() - StreamCompressor.avail_out; }
+	size_t getPendingStreamData() const { return iStreamPending; }
 	bool isStreaming() const;
 	bool StartStreaming(C4Record *pRecord);
 	bool FinishStreaming();
@@ -0,0 +1,230 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2019, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4Include.h"
+#include "network/C4Network2Codec.h"
+
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif
+
+// Fast levels: bulk data is compressed while it is being sent
+const int C4NetCodecZlibFastLevel = Z_BEST_SPEED,
+          C4NetCodecZstdFastLevel = 1;
+
+uint32_t C4Network2Codecs::GetLocalMask()
+{
+	uint32_t mask = (1u << NCC_None) | (1u << NCC_Zlib);
+#ifdef HAVE_ZSTD
+	mask |= 1u << NCC_Zstd;
+#endif
+#ifdef HAVE_LZ4
+	mask |= 1u << NCC_LZ4;
+#endif
+	return mask;
+}
+
+const char *C4Network2Codecs::GetName(C4Network2Codec codec)
+{
+	switch (codec)
+	{
+	case NCC_None: return "none";
+	case NCC_Zlib: return "zlib";
+	case NCC_Zstd: return "zstd";
+	case NCC_LZ4: return "lz4";
+	}
+	return "none";
+}
+
+C4Network2Codec C4Network2Codecs::GetByName(const char *name)
+{
+	for (auto codec : { NCC_Zlib, NCC_Zstd, NCC_LZ4 })
+		if (SEqualNoCase(name, GetName(codec)))
+			return codec;
+	return NCC_None;
+}
+
+C4Network2Codec C4Network2Codecs::ChooseFast(uint32_t remote_mask)
+{
+	const uint32_t mask = remote_mask & GetLocalMask();
+	for (auto codec : { NCC_LZ4, NCC_Zstd })
+		if (mask & (1u << codec))
+			return codec;
+	return NCC_None;
+}
+
+C4Network2Codec C4Network2Codecs::ChooseStream(const char *remote_names)
+{
+	uint32_t remote_mask = 0;
+	char name[32 + 1];
+	for (int i = 0; SCopySegment(remote_names, i, name, ',', 32, true); ++i)
+		remote_mask |= 1u << GetByName(name);
+	if (remote_mask & GetLocalMask() & (1u << NCC_Zstd))
+		return NCC_Zstd;
+	return NCC_Zlib;
+}
+
+bool C4Network2Codecs::Compress(C4Network2Codec codec, const void *data, size_t size, StdBuf &out)
+{
+	size_t out_size = 0;
+	switch (codec)
+	{
+	case NCC_Zlib:
+	{
+		uLongf zsize = compressBound(size);
+		out.New(zsize);
+		if (compress2(getMBufPtr<Bytef>(out), &zsize, static_cast<const Bytef *>(data), size, C4NetCodecZlibFastLevel) != Z_OK)
+			return false;
+		out_size = zsize;
+		break;
+	}
+#ifdef HAVE_ZSTD
+	case NCC_Zstd:
+		out.New(ZSTD_compressBound(size));
+		out_size = ZSTD_compress(out.getMData(), out.getSize(), data, size, C4NetCodecZstdFastLevel);
+		if (ZSTD_isError(out_size)) return false;
+		break;
+#endif
+#ifdef HAVE_LZ4
+	case NCC_LZ4:
+	{
+		if (size > LZ4_MAX_INPUT_SIZE) return false;
+		out.New(LZ4_compressBound(size));
+		const int lz4_size = LZ4_compress_default(static_cast<const char *>(data), getMBufPtr<char>(out), size, out.getSize());
+		if (lz4_size <= 0) return false;
+		out_size = lz4_size;
+		break;
+	}
+#endif
+	default:
+		return false;
+	}
+	// Not worth it?
+	if (out_size >= size) return false;
+	out.Shrink(out.getSize() - out_size);
+	return true;
+}
+
+bool C4Network2Codecs::Decompress(C4Network2Codec codec, const void *data, size_t size, size_t raw_size, StdBuf &out)
+{
+	out.New(raw_size);
+	switch (codec)
+	{
+	case NCC_None:
+		if (size != raw_size) return false;
+		out.Write(data, size);
+		return true;
+	case NCC_Zlib:
+	{
+		uLongf zsize = raw_size;
+		return uncompress(getMBufPtr<Bytef>(out), &zsize, static_cast<const Bytef *>(data), size) == Z_OK && zsize == raw_size;
+	}
+#ifdef HAVE_ZSTD
+	case NCC_Zstd:
+		return ZSTD_decompress(out.getMData(), raw_size, data, size) == raw_size;
+#endif
+#ifdef HAVE_LZ4
+	case NCC_LZ4:
+		if (size > LZ4_MAX_INPUT_SIZE || raw_size > LZ4_MAX_INPUT_SIZE) return false;
+		return LZ4_decompress_safe(static_cast<const char *>(data), getMBufPtr<char>(out), size, raw_size) == static_cast<int>(raw_size);
+#endif
+	default:
+		return false;
+	}
+}
+
+// *** C4Network2StreamCompressor
+
+bool C4Network2StreamCompressor::Init(C4Network2Codec codec, int32_t level)
+{
+	Clear();
+	switch (codec)
+	{
+	case NCC_Zlib:
+		ZeroMem(&ZStream, sizeof(ZStream));
+		if (deflateInit(&ZStream, level) != Z_OK)
+			return false;
+		break;
+#ifdef HAVE_ZSTD
+	case NCC_Zstd:
+	{
+		ZSTD_CCtx *ctx = ZSTD_createCCtx();
+		if (!ctx) return false;
+		ZstdStream = ctx;
+		if (ZSTD_isError(ZSTD_CCtx_setParameter(ctx, ZSTD_c_compressionLevel, level)))
+			{ Clear(); return false; }
+		break;
+	}
+#endif
+	default:
+		return false;
+	}
+	Codec = codec;
+	return true;
+}
+
+void C4Network2StreamCompressor::Clear()
+{
+	if (Codec == NCC_Zlib)
+		deflateEnd(&ZStream);
+#ifdef HAVE_ZSTD
+	if (ZstdStream)
+		ZSTD_freeCCtx(static_cast<ZSTD_CCtx *>(ZstdStream));
+#endif
+	ZstdStream = nullptr;
+	Codec = NCC_None;
+}
+
+bool C4Network2StreamCompressor::Process(const void *in, size_t in_size, size_t *consumed, void *out, size_t out_size, size_t *produced, bool finish, bool *finished)
+{
+	*consumed = *produced = 0; *finished = false;
+	switch (Codec)
+	{
+	case NCC_Zlib:
+	{
+		ZStream.next_in = static_cast<Bytef *>(const_cast<void *>(in));
+		ZStream.avail_in = in_size;
+		ZStream.next_out = static_cast<Bytef *>(out);
+		ZStream.avail_out = out_size;
+		int ret = deflate(&ZStream, finish ? Z_FINISH : Z_NO_FLUSH);
+		// Z_BUF_ERROR only means that no progress was possible
+		if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+			return false;
+		*consumed = in_size - ZStream.avail_in;
+		*produced = out_size - ZStream.avail_out;
+		*finished = (ret == Z_STREAM_END);
+		return true;
+	}
+#ifdef HAVE_ZSTD
+	case NCC_Zstd:
+	{
+		ZSTD_inBuffer zin = { in, in_size, 0 };
+		ZSTD_outBuffer zout = { out, out_size, 0 };
+		size_t remaining = ZSTD_compressStream2(static_cast<ZSTD_CCtx *>(ZstdStream), &zout, &zin, finish ? ZSTD_e_end : ZSTD_e_continue);
+		if (ZSTD_isError(remaining))
+			return false;
+		*consumed = zin.pos;
+		*produced = zout.pos;
+		*finished = finish && !remaining;
+		return true;
+	}
+#endif
+	default:
+		return false;
+	}
+}
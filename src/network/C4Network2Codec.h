@@ -0,0 +1,86 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2019, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Compression codecs for network transfers, negotiated between both ends */
+
+#ifndef INC_C4Network2Codec
+#define INC_C4Network2Codec
+
+#include "lib/StdAdaptors.h"
+
+#include <zlib.h>
+
+// zlib is always available. zstd and LZ4 are optional dependencies, so peers announce
+// the codecs they support as a bit mask of (1 << codec) and fall back to zlib or to
+// uncompressed data.
+enum C4Network2Codec
+{
+	NCC_None = 0, // uncompressed
+	NCC_Zlib = 1,
+	NCC_Zstd = 2,
+	NCC_LZ4 = 3,
+};
+
+const StdEnumEntry<C4Network2Codec> C4Network2Codec_EnumMap[] =
+{
+	{ "None", NCC_None },
+	{ "Zlib", NCC_Zlib },
+	{ "Zstd", NCC_Zstd },
+	{ "LZ4", NCC_LZ4 },
+};
+
+class C4Network2Codecs
+{
+public:
+	static uint32_t GetLocalMask(); // codecs supported by this build
+	static bool IsAvailable(C4Network2Codec codec) { return !!(GetLocalMask() & (1u << codec)); }
+	static const char *GetName(C4Network2Codec codec);
+	static C4Network2Codec GetByName(const char *name); // NCC_None if unknown
+
+	// Fastest codec supported by both ends for bulk data that would otherwise be sent
+	// uncompressed. Never picks zlib, which costs more time than it saves on fast links.
+	static C4Network2Codec ChooseFast(uint32_t remote_mask);
+	// Best compressing codec of a comma-separated list of names, zlib if none is supported
+	static C4Network2Codec ChooseStream(const char *remote_names);
+
+	// Compress a whole buffer. Fails if the data does not shrink, so callers can send it as is.
+	static bool Compress(C4Network2Codec codec, const void *data, size_t size, StdBuf &out);
+	// Decompress into exactly raw_size bytes
+	static bool Decompress(C4Network2Codec codec, const void *data, size_t size, size_t raw_size, StdBuf &out);
+};
+
+// Incremental compression of a continuous stream (zlib or zstd)
+class C4Network2StreamCompressor
+{
+public:
+	C4Network2StreamCompressor() = default;
+	~C4Network2StreamCompressor() { Clear(); }
+
+	bool Init(C4Network2Codec codec, int32_t level);
+	void Clear();
+	C4Network2Codec GetCodec() const { return Codec; }
+
+	// Compress from in to out as far as the output space allows. Returns the amounts of
+	// data consumed and produced. With finish set, all pending data is flushed, and
+	// finished is set once the stream has been terminated.
+	bool Process(const void *in, size_t in_size, size_t *consumed, void *out, size_t out_size, size_t *produced, bool finish, bool *finished);
+
+private:
+	C4Network2Codec Codec{NCC_None};
+	z_stream ZStream;
+	void *ZstdStream{nullptr};
+};
+
+#endif // INC_C4Network2Codec
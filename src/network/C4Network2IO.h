@@ -348,12 +348,21 @@ public:
 	void CompileFunc(StdCompiler *pComp) override;
 };
 
+// Revision of the binary packet layouts within one engine version. Increase it whenever
+// packets change incompatibly, so that mismatched peers are rejected on connection.
+const int32_t C4NetProtocolRevision = 1;
+
 class C4PacketConn : public C4PacketBase
 {
 public:
 	C4PacketConn();
 	C4PacketConn(const class C4ClientCore &nCCore, uint32_t iConnID, const char *szPassword = nullptr);
 
+	// engine version and protocol revision, as sent by this engine
+	static int32_t GetLocalVer();
+	static int32_t GetEngineVer(int32_t iVer) { return iVer % 10000; }
+	static int32_t GetProtocolRevision(int32_t iVer) { return iVer / 10000; }
+
 protected:
 	int32_t iVer;
 	uint32_t iConnID;
@@ -128,8 +128,8 @@ void C4Network2ResCore::CompileFunc(StdCompiler *pComp)
 
 // *** C4Network2ResLoad
 
-C4Network2ResLoad::C4Network2ResLoad(int32_t inChunk, int32_t inByClient)
-		: iChunk(inChunk), Timestamp(time(nullptr)), iByClient(inByClient), pNext(nullptr)
+C4Network2ResLoad::C4Network2ResLoad(int32_t inChunk, int32_t inChunkCnt, int32_t inByClient)
+		: iChunk(inChunk), iChunkCnt(inChunkCnt), Timestamp(time(nullptr)), iByClient(inByClient), pNext(nullptr)
 {
 
 }
@@ -292,6 +292,14 @@ void C4Network2ResChunkData::GetNegative(C4Network2ResChunkData &Target) const
 	Target.AddChunkRange(iFreeStart, iChunkCnt - iFreeStart);
 }
 
+bool C4Network2ResChunkData::hasChunk(int32_t iChunk) const
+{
+	for (ChunkRange *pRange = pChunkRanges; pRange; pRange = pRange->Next)
+		if (iChunk >= pRange->Start && iChunk < pRange->Start + pRange->Length)
+			return true;
+	return false;
+}
+
 int32_t C4Network2ResChunkData::getPresentChunk(int32_t iNr) const
 {
 	for (ChunkRange *pRange = pChunkRanges; pRange; pRange = pRange->Next)
@@ -402,8 +410,15 @@ bool C4Network2Res::SetByGroup(C4Group *pGrp, bool fTemp, C4Network2ResType eTyp
 		sResName.Copy(Config.AtRelativePath(sFullName.getData()));
 	}
 	SCopy(pGrp->GetFullName().getData(), szFile, sizeof(szFile)-1);
+	// contents checksum, which has to read all entries: reuse it if the item didn't change
+	uint32_t iContentsCRC;
+	if (fTemp || !pParent->Cache.GetContentsCRC(szFile, &iContentsCRC))
+	{
+		iContentsCRC = pGrp->EntryCRC32();
+		if (!fTemp) pParent->Cache.SetContentsCRC(szFile, iContentsCRC);
+	}
 	// set core
-	Core.Set(eType, iResID, sResName.getData(), pGrp->EntryCRC32());
+	Core.Set(eType, iResID, sResName.getData(), iContentsCRC);
 #ifdef C4NET2RES_DEBUG_LOG
 	// log
 	LogSilentF("Network: Resource: complete %d:%s is file %s (%s)", iResID, sResName.getData(), szFile, fTemp ? "temp" : "static");
@@ -566,54 +581,22 @@ bool C4Network2Res::GetStandalone(char *pTo, int32_t iMaxL, bool fSetOfficial, b
 	// lock file
 	CStdLock FileLock(&FileCSec);
 
-	// directory?
-	SCopy(szFile, szStandalone, sizeof(szStandalone)-1);
-	if (DirectoryExists(szFile))
+	// packed before and unchanged since?
+	uint32_t iCRC32 = 0, iCachedSize = 0;
+	StdStrBuf sCached;
+	bool fCached = false;
+	if (!fTempFile && pParent->Cache.GetStandalone(szFile, &sCached, &iCachedSize, &iCRC32))
 	{
-		// size check for the directory, if allowed
-		if (fAllowUnloadable)
-		{
-			uint32_t iDirSize;
-			if (!DirSizeHelper::GetDirSize(szFile, &iDirSize, Config.Network.MaxLoadFileSize))
-				{ if (!fSilent) LogF("Network: could not get directory size of %s!", szFile); szStandalone[0] = '\0'; return false; }
-			if (iDirSize > uint32_t(Config.Network.MaxLoadFileSize))
-				{ if (!fSilent) LogSilentF("Network: %s over size limit, will be marked unloadable!", szFile); szStandalone[0] = '\0'; return false; }
-		}
-		// log - this may take a few seconds
-		if (!fSilent) LogF(LoadResStr("IDS_PRC_NETPACKING"), GetFilename(szFile));
-		// pack inplace?
-		if (!fTempFile)
-		{
-			if (!pParent->FindTempResFileName(szFile, szStandalone))
-				{ if (!fSilent) Log("GetStandalone: could not find free name for temporary file!"); szStandalone[0] = '\0'; return false; }
-			if (!C4Group_PackDirectoryTo(szFile, szStandalone))
-				{ if (!fSilent) Log("GetStandalone: could not pack directory!"); szStandalone[0] = '\0'; return false; }
-		}
-		else if (!C4Group_PackDirectory(szStandalone))
-			{ if (!fSilent) Log("GetStandalone: could not pack directory!"); if (!SEqual(szFile, szStandalone)) EraseDirectory(szStandalone); szStandalone[0] = '\0'; return false; }
-		// make sure directory is packed
-		if (DirectoryExists(szStandalone))
-			{ if (!fSilent) Log("GetStandalone: directory hasn't been packed!"); if (!SEqual(szFile, szStandalone)) EraseDirectory(szStandalone); szStandalone[0] = '\0'; return false; }
-		// fallthru
+		// copy it, as the standalone might be changed (see Derive)
+		if (SEqual(sCached.getData(), szFile))
+			SCopy(szFile, szStandalone, sizeof(szStandalone)-1);
+		else if (!pParent->FindTempResFileName(szFile, szStandalone) || !CopyItem(sCached.getData(), szStandalone))
+			szStandalone[0] = '\0';
+		fCached = szStandalone[0] && FileSize(szStandalone) == iCachedSize;
+		if (!fCached && szStandalone[0] && !SEqual(szFile, szStandalone)) EraseItem(szStandalone);
 	}
-
-	// doesn't exist physically?
-	if (!FileExists(szStandalone))
-	{
-		// try C4Group (might be packed)
-		if (!pParent->FindTempResFileName(szFile, szStandalone))
-			{ if (!fSilent) Log("GetStandalone: could not find free name for temporary file!"); szStandalone[0] = '\0'; return false; }
-		if (!C4Group_CopyItem(szFile, szStandalone))
-			{ if (!fSilent) Log("GetStandalone: could not copy to temporary file!"); szStandalone[0] = '\0'; return false; }
-	}
-
-	// remains missing? give up.
-	if (!FileExists(szStandalone))
-		{ if (!fSilent) Log("GetStandalone: file not found!"); szStandalone[0] = '\0'; return false; }
-
-	// do optimizations (delete unneeded entries)
-	if (!OptimizeStandalone(fSilent))
-		{ if (!SEqual(szFile, szStandalone)) EraseItem(szStandalone); szStandalone[0] = '\0'; return false; }
+	if (!fCached && !CreateStandalone(fAllowUnloadable, fSilent))
+		return false;
 
 	// get file size
 	size_t iSize = FileSize(szStandalone);
@@ -632,9 +615,14 @@ bool C4Network2Res::GetStandalone(char *pTo, int32_t iMaxL, bool fSetOfficial, b
 	}
 
 	// calc checksum
-	uint32_t iCRC32;
-	if (!GetFileCRC(szStandalone, &iCRC32))
-		{ if (!fSilent) Log("GetStandalone: could not calculate checksum!"); return false; }
+	if (!fCached)
+	{
+		if (!GetFileCRC(szStandalone, &iCRC32))
+			{ if (!fSilent) Log("GetStandalone: could not calculate checksum!"); return false; }
+		// remember for the next time; also starts calculating the SHA in the background
+		if (!fTempFile)
+			pParent->Cache.SetStandalone(szFile, szStandalone, iSize, iCRC32);
+	}
 	// set / check
 	if (!fSetOfficial && iCRC32 != Core.getFileCRC())
 	{
@@ -660,12 +648,18 @@ bool C4Network2Res::CalculateSHA()
 	if (Core.hasFileSHA()) return true;
 	// get the file
 	char szStandalone[_MAX_PATH_LEN];
-	if (!GetStandalone(szStandalone, _MAX_PATH, false))
+	const bool fStandalone = GetStandalone(szStandalone, _MAX_PATH, false);
+	if (!fStandalone)
 		SCopy(szFile, szStandalone, _MAX_PATH);
-	// get the hash
+	// get the hash. For unchanged local files, it has been calculated in the background.
 	BYTE hash[SHA_DIGEST_LENGTH];
-	if (!GetFileSHA1(szStandalone, hash))
-		return false;
+	const bool fCache = fStandalone && !fTempFile;
+	if (!fCache || !pParent->Cache.GetSHA(szFile, hash))
+	{
+		if (!GetFileSHA1(szStandalone, hash))
+			return false;
+		if (fCache) pParent->Cache.SetSHA(szFile, hash);
+	}
 	// save it back
 	Core.SetFileSHA(hash);
 	// okay
@@ -810,7 +804,7 @@ bool C4Network2Res::SendStatus(C4Network2IOConnection *pTo)
 	}
 }
 
-bool C4Network2Res::SendChunk(uint32_t iChunk, int32_t iToClient)
+bool C4Network2Res::SendChunk(uint32_t iChunk, int32_t iToClient, C4Network2Codec eCodec)
 {
 	assert(pParent && pParent->getIOClass());
 	if (!szStandalone[0] || iChunk >= Core.getChunkCnt()) return false;
@@ -822,7 +816,7 @@ bool C4Network2Res::SendChunk(uint32_t iChunk, int32_t iToClient)
 	// create packet
 	CStdLock FileLock(&FileCSec);
 	C4Network2ResChunk ResChunk;
-	ResChunk.Set(this, iChunk);
+	ResChunk.Set(this, iChunk, eCodec);
 	// send
 	bool fSuccess = pConn->Send(MkC4NetIOPacket(PID_NetResData, ResChunk));
 	pConn->DelRef();
@@ -892,11 +886,15 @@ void C4Network2Res::OnChunk(const C4Network2ResChunk &rChunk)
 	{
 		// status changed
 		fDirty = true;
-		// remove load waits
+		// remove load waits once all chunks of the request are there
 		for (C4Network2ResLoad *pLoad = pLoads, *pNext; pLoad; pLoad = pNext)
 		{
 			pNext = pLoad->Next();
-			if (static_cast<uint32_t>(pLoad->getChunk()) == rChunk.getChunkNr())
+			if (!pLoad->hasChunk(rChunk.getChunkNr())) continue;
+			bool fLoadComplete = true;
+			for (int32_t iChunk = pLoad->getChunk(); iChunk < pLoad->getChunk() + pLoad->getChunkCnt(); iChunk++)
+				fLoadComplete = fLoadComplete && Chunks.hasChunk(iChunk);
+			if (fLoadComplete)
 				RemoveLoad(pLoad);
 		}
 	}
@@ -1054,27 +1052,43 @@ bool C4Network2Res::StartLoad(int32_t iFromClient, const C4Network2ResChunkData
 		if (pPos->getByClient() == iFromClient)
 			return true;
 	// find chunk to retrieve
-	int32_t iLoads[C4NetResMaxLoad]; int32_t i = 0;
+	std::vector<int32_t> Loading;
 	for (C4Network2ResLoad *pLoad = pLoads; pLoad; pLoad = pLoad->Next())
-		iLoads[i++] = pLoad->getChunk();
-	int32_t iRetrieveChunk = Chunks.GetChunkToRetrieve(Available, i, iLoads);
+		for (int32_t iChunk = pLoad->getChunk(); iChunk < pLoad->getChunk() + pLoad->getChunkCnt(); iChunk++)
+			Loading.push_back(iChunk);
+	int32_t iRetrieveChunk = Chunks.GetChunkToRetrieve(Available, Loading.size(), Loading.data());
 	// nothing? ignore
 	if (iRetrieveChunk < 0 || (uint32_t)iRetrieveChunk >= Core.getChunkCnt())
 		return true;
 	// search message connection for client
 	C4Network2IOConnection *pConn = pParent->getIOClass()->GetMsgConnection(iFromClient);
 	if (!pConn) return false;
+	// fast link? request the following chunks as well
+	int32_t iPing = pConn->getPingTime(), iMaxRetrieveCnt = 1;
+	if (iPing >= 0 && iPing <= C4NetResFastLinkPing)
+		iMaxRetrieveCnt = C4NetResFastLinkBatch;
+	else if (iPing >= 0 && iPing <= C4NetResMediumLinkPing)
+		iMaxRetrieveCnt = C4NetResMediumLinkBatch;
+	int32_t iRetrieveCnt = 1;
+	while (iRetrieveCnt < iMaxRetrieveCnt)
+	{
+		int32_t iNext = iRetrieveChunk + iRetrieveCnt;
+		if ((uint32_t)iNext >= Core.getChunkCnt() || !Available.hasChunk(iNext) || Chunks.hasChunk(iNext) ||
+		    std::find(Loading.begin(), Loading.end(), iNext) != Loading.end())
+			break;
+		iRetrieveCnt++;
+	}
 	// send request
-	if (!pConn->Send(MkC4NetIOPacket(PID_NetResReq, C4PacketResRequest(Core.getID(), iRetrieveChunk))))
+	if (!pConn->Send(MkC4NetIOPacket(PID_NetResReq, C4PacketResRequest(Core.getID(), iRetrieveChunk, iRetrieveCnt))))
 		{ pConn->DelRef(); return false; }
 	pConn->DelRef();
 #ifdef C4NET2RES_DEBUG_LOG
 	// log
-	Application.InteractiveThread.ThreadLogS("Network: Res: requesting chunk %d of %d:%s (%s) from client %d",
-	    iRetrieveChunk, Core.getID(), Core.getFileName(), szFile, iFromClient);
+	Application.InteractiveThread.ThreadLogS("Network: Res: requesting chunks %d-%d of %d:%s (%s) from client %d",
+	    iRetrieveChunk, iRetrieveChunk + iRetrieveCnt - 1, Core.getID(), Core.getFileName(), szFile, iFromClient);
 #endif
 	// create load class
-	C4Network2ResLoad *pnLoad = new C4Network2ResLoad(iRetrieveChunk, iFromClient);
+	C4Network2ResLoad *pnLoad = new C4Network2ResLoad(iRetrieveChunk, iRetrieveCnt, iFromClient);
 	// add to list
 	pnLoad->pNext = pLoads;
 	pLoads = pnLoad;
@@ -1138,6 +1152,61 @@ void C4Network2Res::RemoveCChunks(ClientChunks *pChunks)
 	delete pChunks;
 }
 
+bool C4Network2Res::CreateStandalone(bool fAllowUnloadable, bool fSilent)
+{
+	CStdLock FileLock(&FileCSec);
+	// directory?
+	SCopy(szFile, szStandalone, sizeof(szStandalone)-1);
+	if (DirectoryExists(szFile))
+	{
+		// size check for the directory, if allowed
+		if (fAllowUnloadable)
+		{
+			uint32_t iDirSize;
+			if (!DirSizeHelper::GetDirSize(szFile, &iDirSize, Config.Network.MaxLoadFileSize))
+				{ if (!fSilent) LogF("Network: could not get directory size of %s!", szFile); szStandalone[0] = '\0'; return false; }
+			if (iDirSize > uint32_t(Config.Network.MaxLoadFileSize))
+				{ if (!fSilent) LogSilentF("Network: %s over size limit, will be marked unloadable!", szFile); szStandalone[0] = '\0'; return false; }
+		}
+		// log - this may take a few seconds
+		if (!fSilent) LogF(LoadResStr("IDS_PRC_NETPACKING"), GetFilename(szFile));
+		// pack inplace?
+		if (!fTempFile)
+		{
+			if (!pParent->FindTempResFileName(szFile, szStandalone))
+				{ if (!fSilent) Log("GetStandalone: could not find free name for temporary file!"); szStandalone[0] = '\0'; return false; }
+			if (!C4Group_PackDirectoryTo(szFile, szStandalone))
+				{ if (!fSilent) Log("GetStandalone: could not pack directory!"); szStandalone[0] = '\0'; return false; }
+		}
+		else if (!C4Group_PackDirectory(szStandalone))
+			{ if (!fSilent) Log("GetStandalone: could not pack directory!"); if (!SEqual(szFile, szStandalone)) EraseDirectory(szStandalone); szStandalone[0] = '\0'; return false; }
+		// make sure directory is packed
+		if (DirectoryExists(szStandalone))
+			{ if (!fSilent) Log("GetStandalone: directory hasn't been packed!"); if (!SEqual(szFile, szStandalone)) EraseDirectory(szStandalone); szStandalone[0] = '\0'; return false; }
+		// fallthru
+	}
+
+	// doesn't exist physically?
+	if (!FileExists(szStandalone))
+	{
+		// try C4Group (might be packed)
+		if (!pParent->FindTempResFileName(szFile, szStandalone))
+			{ if (!fSilent) Log("GetStandalone: could not find free name for temporary file!"); szStandalone[0] = '\0'; return false; }
+		if (!C4Group_CopyItem(szFile, szStandalone))
+			{ if (!fSilent) Log("GetStandalone: could not copy to temporary file!"); szStandalone[0] = '\0'; return false; }
+	}
+
+	// remains missing? give up.
+	if (!FileExists(szStandalone))
+		{ if (!fSilent) Log("GetStandalone: file not found!"); szStandalone[0] = '\0'; return false; }
+
+	// do optimizations (delete unneeded entries)
+	if (!OptimizeStandalone(fSilent))
+		{ if (!SEqual(szFile, szStandalone)) EraseItem(szStandalone); szStandalone[0] = '\0'; return false; }
+
+	return true;
+}
+
 bool C4Network2Res::OptimizeStandalone(bool fSilent)
 {
 	CStdLock FileLock(&FileCSec);
@@ -1176,14 +1245,14 @@ C4Network2ResChunk::C4Network2ResChunk() = default;
 
 C4Network2ResChunk::~C4Network2ResChunk() = default;
 
-bool C4Network2ResChunk::Set(C4Network2Res *pRes, uint32_t inChunk)
+bool C4Network2ResChunk::Set(C4Network2Res *pRes, uint32_t inChunk, C4Network2Codec enCodec)
 {
 	const C4Network2ResCore &Core = pRes->getCore();
 	iResID = pRes->getResID();
 	iChunk = inChunk;
 	// calculate offset and size
 	int32_t iOffset = iChunk * Core.getChunkSize(),
-	                  iSize = std::min<int32_t>(Core.getFileSize() - iOffset, C4NetResChunkSize);
+	                  iSize = std::min<int32_t>(Core.getFileSize() - iOffset, Core.getChunkSize());
 	if (iSize < 0) { LogF("Network: could not get chunk from offset %d from resource file %s: File size is only %d!", iOffset, pRes->getFile(), Core.getFileSize()); return false; }
 	// open file
 	int32_t f = pRes->OpenFileRead();
@@ -1196,10 +1265,18 @@ bool C4Network2ResChunk::Set(C4Network2Res *pRes, uint32_t inChunk)
 	char *pBuf = (char *) malloc(iSize);
 	if (read(f, pBuf, iSize) != iSize)
 		{ free(pBuf); close(f); LogF("Network: could not read resource file %s!", pRes->getFile()); return false; }
-	// set
-	Data.Take(pBuf, iSize);
 	// close
 	close(f);
+	// set, compressed if that helps (group entries usually are compressed already)
+	iRawSize = iSize;
+	eCodec = NCC_None;
+	if (enCodec != NCC_None && C4Network2Codecs::Compress(enCodec, pBuf, iSize, Data))
+	{
+		eCodec = enCodec;
+		free(pBuf);
+	}
+	else
+		Data.Take(pBuf, iSize);
 	// ok
 	return true;
 }
@@ -1216,12 +1293,26 @@ bool C4Network2ResChunk::AddTo(C4Network2Res *pRes, C4Network2IO *pIO) const
 #endif
 		return false;
 	}
+	// decompress
+	StdBuf Decompressed;
+	const StdBuf *pData = &Data;
+	if (eCodec != NCC_None)
+	{
+		if (iRawSize > Core.getChunkSize() || !C4Network2Codecs::Decompress(eCodec, Data.getData(), Data.getSize(), iRawSize, Decompressed))
+		{
+#ifdef C4NET2RES_DEBUG_LOG
+			Application.InteractiveThread.ThreadLogS("C4Network2ResChunk(%d)::AddTo(%s [%d]): Could not decompress %s data!", (int) iResID, (const char *) Core.getFileName(), (int) pRes->getResID(), C4Network2Codecs::GetName(eCodec));
+#endif
+			return false;
+		}
+		pData = &Decompressed;
+	}
 	// calculate offset and size
 	int32_t iOffset = iChunk * Core.getChunkSize();
-	if (iOffset + Data.getSize() > Core.getFileSize())
+	if (iOffset + pData->getSize() > Core.getFileSize())
 	{
 #ifdef C4NET2RES_DEBUG_LOG
-		Application.InteractiveThread.ThreadLogS("C4Network2ResChunk(%d)::AddTo(%s [%d]): Adding %d bytes at offset %d exceeds expected file size of %d!", (int) iResID, (const char *) Core.getFileName(), (int) pRes->getResID(), (int) Data.getSize(), (int) iOffset, (int) Core.getFileSize());
+		Application.InteractiveThread.ThreadLogS("C4Network2ResChunk(%d)::AddTo(%s [%d]): Adding %d bytes at offset %d exceeds expected file size of %d!", (int) iResID, (const char *) Core.getFileName(), (int) pRes->getResID(), (int) pData->getSize(), (int) iOffset, (int) Core.getFileSize());
 #endif
 		return false;
 	}
@@ -1245,7 +1336,7 @@ bool C4Network2ResChunk::AddTo(C4Network2Res *pRes, C4Network2IO *pIO) const
 			return false;
 		}
 	// write
-	if (write(f, Data.getData(), Data.getSize()) != int32_t(Data.getSize()))
+	if (write(f, pData->getData(), pData->getSize()) != int32_t(pData->getSize()))
 	{
 #ifdef C4NET2RES_DEBUG_LOG
 		Application.InteractiveThread.ThreadLogS("C4Network2ResChunk(%d)::AddTo(%s [%d]): write error: %s!", (int) iResID, (const char *) Core.getFileName(), (int) pRes->getResID(), strerror(errno));
@@ -1264,6 +1355,9 @@ void C4Network2ResChunk::CompileFunc(StdCompiler *pComp)
 	// pack header
 	pComp->Value(mkNamingAdapt(iResID, "ResID", -1));
 	pComp->Value(mkNamingAdapt(iChunk, "Chunk", ~0U));
+	pComp->Value(mkNamingAdapt(mkEnumAdaptT<uint8_t>(eCodec, C4Network2Codec_EnumMap), "Codec", NCC_None));
+	if (eCodec != NCC_None)
+		pComp->Value(mkNamingAdapt(iRawSize, "RawSize", 0U));
 	// Data
 	pComp->Value(mkNamingAdapt(Data, "Data"));
 }
@@ -1291,6 +1385,8 @@ bool C4Network2ResList::Init(int32_t inClientID, C4Network2IO *pIOClass) // by m
 	SetLocalID(inClientID);
 	// create network path
 	if (!CreateNetworkFolder()) return false;
+	// open resource cache (failure only costs time)
+	Cache.Init(Config.AtNetworkPath("ResCache"), uint64_t(std::max<int32_t>(Config.Network.ResCacheSize, 0)) * 1024 * 1024);
 	// ok
 	return true;
 }
@@ -1492,6 +1588,10 @@ void C4Network2ResList::Clear()
 	}
 	iClientID = C4ClientIDUnknown;
 	iLastDiscover = iLastStatus = 0;
+	// save resource cache
+	if (Cache.HitCnt || Cache.MissCnt)
+		LogSilentF("Network: Resource cache - %u of %u packed resources reused", Cache.HitCnt, Cache.HitCnt + Cache.MissCnt);
+	Cache.Clear();
 }
 
 void C4Network2ResList::OnClientConnect(C4Network2IOConnection *pConn) // by main thread
@@ -1560,8 +1660,15 @@ void C4Network2ResList::HandlePacket(char cStatus, const C4PacketBase *pPacket,
 		// find resource
 		CStdShareLock ResListLock(&ResListCSec);
 		C4Network2Res *pRes = getRes(Pkt.getReqID());
-		// send requested chunk
-		if (pRes && pRes->IsBinaryCompatible()) pRes->SendChunk(Pkt.getReqChunk(), pConn->getClientID());
+		// send requested chunks, compressed if both sides support a fast codec
+		if (pRes && pRes->IsBinaryCompatible())
+		{
+			C4Network2Codec eCodec = C4Network2Codecs::ChooseFast(Pkt.getCodecs());
+			int32_t iChunkCnt = Clamp<int32_t>(Pkt.getReqChunkCnt(), 1, C4NetResFastLinkBatch);
+			for (int32_t i = 0; i < iChunkCnt; i++)
+				if (!pRes->SendChunk(Pkt.getReqChunk() + i, pConn->getClientID(), eCodec))
+					break;
+		}
 	}
 	break;
 
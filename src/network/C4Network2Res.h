@@ -22,6 +22,8 @@
 #include "platform/StdSync.h"
 
 #include "lib/SHA1.h"
+#include "network/C4Network2Codec.h"
+#include "network/C4Network2ResCache.h"
 
 #include <atomic>
 
@@ -35,6 +37,12 @@ const int32_t C4NetResDiscoverTimeout = 10, // (s)
               C4NetResDeleteTime = 60, // (s)
               C4NetResMaxBigicon = 20; // maximum size, in KB, of bigicon
 
+// chunks requested at once, by ping of the link: fast links move more data per round trip
+const int32_t C4NetResFastLinkPing = 10, // (ms)
+              C4NetResMediumLinkPing = 50, // (ms)
+              C4NetResFastLinkBatch = 16,
+              C4NetResMediumLinkBatch = 4;
+
 const int32_t C4NetResIDAnonymous = -2;
 
 enum C4Network2ResType
@@ -110,12 +118,12 @@ class C4Network2ResLoad
 {
 	friend class C4Network2Res;
 public:
-	C4Network2ResLoad(int32_t iChunk, int32_t iByClient);
+	C4Network2ResLoad(int32_t iChunk, int32_t iChunkCnt, int32_t iByClient);
 	~C4Network2ResLoad();
 
 protected:
 	// chunk download data
-	int32_t iChunk;
+	int32_t iChunk, iChunkCnt; // consecutive chunks requested at once
 	time_t Timestamp;
 	int32_t iByClient;
 
@@ -124,6 +132,8 @@ protected:
 
 public:
 	int32_t     getChunk()        const { return iChunk; }
+	int32_t     getChunkCnt()     const { return iChunkCnt; }
+	bool        hasChunk(int32_t iNr) const { return iNr >= iChunk && iNr < iChunk + iChunkCnt; }
 	int32_t     getByClient()     const { return iByClient; }
 
 	C4Network2ResLoad *Next() const { return pNext; }
@@ -153,6 +163,7 @@ public:
 	int32_t getPresentChunkCnt()  const { return iPresentChunkCnt; }
 	int32_t getPresentPercent()   const { return iPresentChunkCnt * 100 / iChunkCnt; }
 	bool isComplete()         const { return iPresentChunkCnt == iChunkCnt; }
+	bool hasChunk(int32_t iChunk) const;
 
 	void SetIncomplete(int32_t iChunkCnt);
 	void SetComplete(int32_t iChunkCnt);
@@ -269,7 +280,7 @@ public:
 	bool FinishDerive(const C4Network2ResCore &nCore);
 
 	bool SendStatus(C4Network2IOConnection *pTo = nullptr);
-	bool SendChunk(uint32_t iChunk, int32_t iToClient);
+	bool SendChunk(uint32_t iChunk, int32_t iToClient, C4Network2Codec eCodec);
 
 	// references
 	void AddRef(); void DelRef();
@@ -298,6 +309,7 @@ protected:
 	void RemoveLoad(C4Network2ResLoad *pLoad);
 	void RemoveCChunks(ClientChunks *pChunks);
 
+	bool CreateStandalone(bool fAllowUnloadable, bool fSilent);
 	bool OptimizeStandalone(bool fSilent);
 
 };
@@ -311,13 +323,16 @@ public:
 protected:
 	int32_t iResID;
 	uint32_t iChunk;
+	C4Network2Codec eCodec{NCC_None};
+	uint32_t iRawSize{0}; // size of the chunk after decompression
 	StdBuf Data;
 
 public:
 	int32_t   getResID()   const { return iResID; }
 	uint32_t  getChunkNr() const { return iChunk; }
 
-	bool Set(C4Network2Res *pRes, uint32_t iChunk);
+	// Compresses the data with eCodec, unless that does not make it smaller
+	bool Set(C4Network2Res *pRes, uint32_t iChunk, C4Network2Codec eCodec = NCC_None);
 	bool AddTo(C4Network2Res *pRes, C4Network2IO *pIO) const;
 
 	void CompileFunc(StdCompiler *pComp) override;
@@ -346,6 +361,9 @@ protected:
 	// object used for network i/o
 	C4Network2IO *pIO{nullptr};
 
+	// packed local resources and checksums from earlier games
+	C4Network2ResCache Cache;
+
 public:
 
 	// initialization
@@ -435,14 +453,17 @@ public:
 class C4PacketResRequest : public C4PacketBase
 {
 public:
-	C4PacketResRequest(int32_t iID = -1, int32_t iChunk = -1);
+	C4PacketResRequest(int32_t iID = -1, int32_t iChunk = -1, int32_t iChunkCnt = 1);
 
 protected:
-	int32_t iReqID, iReqChunk;
+	int32_t iReqID, iReqChunk, iReqChunkCnt;
+	uint32_t iCodecs; // codecs the requesting client can decompress
 
 public:
 	int32_t getReqID()    const { return iReqID; }
 	int32_t getReqChunk() const { return iReqChunk; }
+	int32_t getReqChunkCnt() const { return iReqChunkCnt; }
+	uint32_t getCodecs()  const { return iCodecs; }
 
 	void CompileFunc(StdCompiler *pComp) override;
 };
@@ -0,0 +1,423 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2019, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4Include.h"
+#include "network/C4Network2ResCache.h"
+
+#include "c4group/CStdFile.h"
+
+const char *C4NetResCacheIndexFilename = "Index.txt";
+const int32_t C4NetResCacheMaxAge = 90 * 24 * 60 * 60; // entries unused for this long are dropped (s)
+
+namespace
+{
+	void AddToFingerprint(C4Network2ResCache::Fingerprint &print, const char *path)
+	{
+		print.Time = std::max<int32_t>(print.Time, FileTime(path));
+		if (DirectoryExists(path))
+		{
+			// the directory time covers added, removed and renamed items
+			for (DirectoryIterator i(path); *i; ++i)
+				AddToFingerprint(print, *i);
+		}
+		else
+		{
+			print.Size += FileSize(path);
+			print.FileCnt++;
+		}
+	}
+}
+
+// *** C4Network2ResCache::Fingerprint
+
+bool C4Network2ResCache::Fingerprint::Calculate(const char *path)
+{
+	*this = Fingerprint();
+	if (!ItemExists(path)) return false;
+	AddToFingerprint(*this, path);
+	return true;
+}
+
+void C4Network2ResCache::Fingerprint::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(mkNamingAdapt(Time, "Time", 0));
+	pComp->Value(mkNamingAdapt(Size, "Size", 0u));
+	pComp->Value(mkNamingAdapt(FileCnt, "FileCnt", 0u));
+}
+
+// *** C4Network2ResCache::Entry
+
+void C4Network2ResCache::Entry::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(mkNamingAdapt(mkParAdapt(Path, StdCompiler::RCT_All), "Path", ""));
+	pComp->Value(mkNamingAdapt(Print, "Fingerprint"));
+	pComp->Value(mkNamingAdapt(HasStandalone, "HasStandalone", false));
+	if (HasStandalone)
+	{
+		pComp->Value(mkNamingAdapt(mkParAdapt(File, StdCompiler::RCT_All), "File", ""));
+		pComp->Value(mkNamingAdapt(FileSize, "FileSize", 0u));
+		pComp->Value(mkNamingAdapt(FileCRC, "FileCRC", 0u));
+	}
+	pComp->Value(mkNamingAdapt(HasContentsCRC, "HasContentsCRC", false));
+	if (HasContentsCRC)
+		pComp->Value(mkNamingAdapt(ContentsCRC, "ContentsCRC", 0u));
+	pComp->Value(mkNamingAdapt(HasSHA, "HasSHA", false));
+	if (HasSHA)
+		pComp->Value(mkNamingAdapt(mkHexAdapt(SHA), "SHA"));
+	pComp->Value(mkNamingAdapt(LastUse, "LastUse", 0));
+}
+
+// *** C4Network2ResCache
+
+C4Network2ResCache::C4Network2ResCache() : Hasher(this), HashEvent(true), HashDoneEvent(true) { }
+
+C4Network2ResCache::~C4Network2ResCache()
+{
+	Clear();
+}
+
+bool C4Network2ResCache::Init(const char *directory, uint64_t max_size)
+{
+	Clear();
+	if (!max_size) return false;
+	// create directory
+	StdStrBuf dir(directory);
+	TruncateBackslash(dir.getMData());
+	if (!DirectoryExists(dir.getData()) && !CreatePath(dir.getData()))
+		return false;
+	Directory = std::string(dir.getData()) + DirSep;
+	MaxSize = max_size;
+	// load index
+	StdStrBuf index;
+	std::vector<Entry> entries;
+	if (index.LoadFromFile(GetIndexFilename().c_str()))
+	{
+		try
+		{
+			int32_t entry_cnt = 0;
+			StdCompilerINIRead comp;
+			comp.setInput(index);
+			comp.Begin();
+			comp.Value(mkNamingCountAdapt(entry_cnt, "Entry"));
+			entries.resize(entry_cnt);
+			for (Entry &entry : entries)
+				comp.Value(mkNamingAdapt(entry, "Entry"));
+			comp.End();
+		}
+		catch (StdCompiler::Exception *pExc)
+		{
+			// start over
+			delete pExc;
+			entries.clear();
+		}
+	}
+	// drop entries that are outdated or have lost their file
+	const int32_t now = time(nullptr);
+	for (Entry &entry : entries)
+	{
+		if (entry.Path.isNull() || entry.LastUse < now - C4NetResCacheMaxAge)
+			{ RemoveFile(entry); continue; }
+		if (entry.HasStandalone && entry.File.getLength() && !FileExists((Directory + entry.File.getData()).c_str()))
+			entry.HasStandalone = entry.HasSHA = false;
+		Entries[entry.Path.getData()] = entry;
+	}
+	// remove files that are not referenced anymore
+	std::set<std::string> files;
+	for (auto &item : Entries)
+		if (item.second.File.getLength())
+			files.insert(Directory + item.second.File.getData());
+	for (DirectoryIterator i(dir.getData()); *i; ++i)
+		if (!files.count(*i) && !SEqual(GetFilename(*i), C4NetResCacheIndexFilename))
+			EraseItem(*i);
+	Prune();
+	// start hashing thread. Jobs are processed when waiting for them otherwise.
+	Hasher.Start();
+	return true;
+}
+
+void C4Network2ResCache::Clear()
+{
+	// drop pending jobs, but let the hasher finish what it is working on
+	{
+		CStdLock lock(&EntryLock);
+		HashJobs.clear();
+	}
+	Hasher.SignalStop();
+	HashEvent.Set();
+	Hasher.Stop();
+	HashEvent.Reset();
+	if (IsEnabled() && Changed) SaveIndex();
+	Entries.clear();
+	Directory.clear();
+	MaxSize = 0;
+	Changed = false;
+	HitCnt = MissCnt = 0;
+}
+
+std::string C4Network2ResCache::GetIndexFilename() const
+{
+	return Directory + C4NetResCacheIndexFilename;
+}
+
+bool C4Network2ResCache::SaveIndex()
+{
+	CStdLock lock(&EntryLock);
+	try
+	{
+		int32_t entry_cnt = Entries.size();
+		StdCompilerINIWrite comp;
+		comp.Begin();
+		comp.Value(mkNamingCountAdapt(entry_cnt, "Entry"));
+		for (auto &item : Entries)
+			comp.Value(mkNamingAdapt(item.second, "Entry"));
+		comp.End();
+		if (!comp.getOutput().SaveToFile(GetIndexFilename().c_str()))
+			return false;
+	}
+	catch (StdCompiler::Exception *pExc)
+	{
+		delete pExc;
+		return false;
+	}
+	Changed = false;
+	return true;
+}
+
+C4Network2ResCache::Entry *C4Network2ResCache::GetEntry(const char *path, const Fingerprint &print, bool create)
+{
+	auto it = Entries.find(path);
+	if (it == Entries.end())
+	{
+		if (!create) return nullptr;
+		it = Entries.emplace(path, Entry()).first;
+		it->second.Path.Copy(path);
+	}
+	Entry &entry = it->second;
+	// changed since? Forget everything.
+	if (entry.Print != print)
+	{
+		if (!create) return nullptr;
+		RemoveFile(entry);
+		entry = Entry();
+		entry.Path.Copy(path);
+	}
+	entry.Print = print;
+	entry.LastUse = time(nullptr);
+	Changed = true;
+	return &entry;
+}
+
+void C4Network2ResCache::RemoveFile(Entry &entry)
+{
+	if (entry.File.getLength())
+		EraseItem((Directory + entry.File.getData()).c_str());
+	entry.File.Clear();
+	entry.HasStandalone = entry.HasSHA = false;
+}
+
+void C4Network2ResCache::Prune()
+{
+	CStdLock lock(&EntryLock);
+	// sum up packed copies
+	std::vector<Entry *> copies;
+	uint64_t total_size = 0;
+	for (auto &item : Entries)
+		if (item.second.File.getLength())
+		{
+			copies.push_back(&item.second);
+			total_size += item.second.FileSize;
+		}
+	if (total_size <= MaxSize) return;
+	// remove least recently used first
+	std::sort(copies.begin(), copies.end(), [](const Entry *a, const Entry *b) { return a->LastUse < b->LastUse; });
+	for (Entry *entry : copies)
+	{
+		if (total_size <= MaxSize) break;
+		total_size -= entry->FileSize;
+		RemoveFile(*entry);
+		Changed = true;
+	}
+}
+
+bool C4Network2ResCache::GetContentsCRC(const char *path, uint32_t *crc)
+{
+	if (!IsEnabled()) return false;
+	Fingerprint print;
+	if (!print.Calculate(path)) return false;
+	CStdLock lock(&EntryLock);
+	Entry *entry = GetEntry(path, print, false);
+	if (!entry || !entry->HasContentsCRC) return false;
+	*crc = entry->ContentsCRC;
+	return true;
+}
+
+void C4Network2ResCache::SetContentsCRC(const char *path, uint32_t crc)
+{
+	if (!IsEnabled()) return;
+	Fingerprint print;
+	if (!print.Calculate(path)) return;
+	CStdLock lock(&EntryLock);
+	Entry *entry = GetEntry(path, print, true);
+	entry->HasContentsCRC = true;
+	entry->ContentsCRC = crc;
+}
+
+bool C4Network2ResCache::GetStandalone(const char *path, StdStrBuf *file, uint32_t *size, uint32_t *crc)
+{
+	if (!IsEnabled()) return false;
+	Fingerprint print;
+	if (!print.Calculate(path)) return false;
+	CStdLock lock(&EntryLock);
+	Entry *entry = GetEntry(path, print, false);
+	if (!entry || !entry->HasStandalone)
+		{ MissCnt++; return false; }
+	if (entry->File.getLength())
+		file->Copy((Directory + entry->File.getData()).c_str());
+	else
+		file->Copy(path);
+	*size = entry->FileSize;
+	*crc = entry->FileCRC;
+	HitCnt++;
+	return true;
+}
+
+bool C4Network2ResCache::SetStandalone(const char *path, const char *standalone, uint32_t size, uint32_t crc)
+{
+	if (!IsEnabled()) return false;
+	Fingerprint print;
+	if (!print.Calculate(path)) return false;
+	// keep a copy unless the item is packed already
+	StdStrBuf file;
+	if (!SEqual(path, standalone))
+	{
+		if (size > MaxSize) return false;
+		for (int32_t i = 0; !file.getLength() || ItemExists((Directory + file.getData()).c_str()); ++i)
+			file.Format("%d_%s", i, GetFilename(path));
+		if (!CopyItem(standalone, (Directory + file.getData()).c_str()))
+			return false;
+	}
+	HashJob job;
+	{
+		CStdLock lock(&EntryLock);
+		Entry *entry = GetEntry(path, print, true);
+		RemoveFile(*entry);
+		entry->File.Take(file);
+		entry->FileSize = size;
+		entry->FileCRC = crc;
+		entry->HasStandalone = true;
+		// hash in the background
+		job.Path = path;
+		job.File = entry->File.getLength() ? Directory + entry->File.getData() : std::string(path);
+		job.Print = print;
+		HashJobs.push_back(job);
+		HashEvent.Set();
+	}
+	Prune();
+	// the game might not be shut down cleanly
+	SaveIndex();
+	return true;
+}
+
+bool C4Network2ResCache::GetSHA(const char *path, uint8_t *sha)
+{
+	if (!IsEnabled()) return false;
+	Fingerprint print;
+	if (!print.Calculate(path)) return false;
+	for (;;)
+	{
+		{
+			CStdLock lock(&EntryLock);
+			Entry *entry = GetEntry(path, print, false);
+			if (!entry || !entry->HasStandalone) return false;
+			if (entry->HasSHA)
+			{
+				memcpy(sha, entry->SHA, SHA_DIGEST_LENGTH);
+				return true;
+			}
+			if (!IsHashPending(path)) return false;
+			HashDoneEvent.Reset();
+		}
+		// hash it right away if the hasher didn't start yet
+		if (!RunHashJob(path))
+			HashDoneEvent.WaitFor(INFINITE);
+	}
+}
+
+void C4Network2ResCache::SetSHA(const char *path, const uint8_t *sha)
+{
+	if (!IsEnabled()) return;
+	Fingerprint print;
+	if (!print.Calculate(path)) return;
+	CStdLock lock(&EntryLock);
+	Entry *entry = GetEntry(path, print, false);
+	if (!entry || !entry->HasStandalone) return;
+	memcpy(entry->SHA, sha, SHA_DIGEST_LENGTH);
+	entry->HasSHA = true;
+}
+
+bool C4Network2ResCache::IsHashPending(const char *path)
+{
+	if (HashingPaths.count(path)) return true;
+	for (const HashJob &job : HashJobs)
+		if (job.Path == path)
+			return true;
+	return false;
+}
+
+bool C4Network2ResCache::RunHashJob(const char *path)
+{
+	HashJob job;
+	{
+		CStdLock lock(&EntryLock);
+		auto it = HashJobs.begin();
+		if (path)
+			it = std::find_if(HashJobs.begin(), HashJobs.end(), [path](const HashJob &job) { return job.Path == path; });
+		if (it == HashJobs.end())
+		{
+			if (HashJobs.empty()) HashEvent.Reset();
+			return false;
+		}
+		job = *it;
+		HashJobs.erase(it);
+		HashingPaths.insert(job.Path);
+	}
+	uint8_t sha[SHA_DIGEST_LENGTH];
+	bool success = GetFileSHA1(job.File.c_str(), sha);
+	// items that are packed already might have changed while they were hashed
+	Fingerprint print;
+	if (job.File == job.Path && (!print.Calculate(job.Path.c_str()) || print != job.Print))
+		success = false;
+	CStdLock lock(&EntryLock);
+	if (success)
+	{
+		auto it = Entries.find(job.Path);
+		if (it != Entries.end() && it->second.HasStandalone && it->second.Print == job.Print)
+		{
+			memcpy(it->second.SHA, sha, SHA_DIGEST_LENGTH);
+			it->second.HasSHA = true;
+			SaveIndex();
+		}
+	}
+	HashingPaths.erase(HashingPaths.find(job.Path));
+	HashDoneEvent.Set();
+	return true;
+}
+
+void C4Network2ResCache::HashThread::Execute()
+{
+	Cache->HashEvent.WaitFor(INFINITE);
+	if (IsStopSignaled()) return;
+	Cache->RunHashJob();
+}
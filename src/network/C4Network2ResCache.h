@@ -0,0 +1,127 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2019, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Persistent cache of packed network resources and their checksums */
+
+#ifndef INC_C4Network2ResCache
+#define INC_C4Network2ResCache
+
+#include "lib/SHA1.h"
+#include "lib/StdBuf.h"
+#include "platform/StdScheduler.h"
+#include "platform/StdSync.h"
+
+#include <deque>
+#include <map>
+#include <set>
+
+class StdCompiler;
+
+// Local resources are identified by path and a fingerprint of their modification time
+// and size, so unchanged files and folders don't have to be packed and hashed again
+// every time a game is hosted. Packed copies of folders are kept in the cache directory.
+// SHA1 hashes are calculated by a background thread.
+class C4Network2ResCache
+{
+public:
+	struct Fingerprint
+	{
+		int32_t Time{0}; // latest modification of the item or anything inside it
+		uint32_t Size{0}; // total size of all files (wraps around)
+		uint32_t FileCnt{0};
+
+		bool Calculate(const char *path); // recurses into directories
+		bool operator == (const Fingerprint &other) const { return Time == other.Time && Size == other.Size && FileCnt == other.FileCnt; }
+		bool operator != (const Fingerprint &other) const { return !(*this == other); }
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+	C4Network2ResCache();
+	~C4Network2ResCache();
+
+	// Loads the index of the given directory. max_size limits the total size of packed copies.
+	bool Init(const char *directory, uint64_t max_size);
+	void Clear(); // waits for the hashing thread and saves the index
+	bool IsEnabled() const { return !Directory.empty(); }
+
+	// Checksum over the contents of a group (C4Group::EntryCRC32)
+	bool GetContentsCRC(const char *path, uint32_t *crc);
+	void SetContentsCRC(const char *path, uint32_t crc);
+
+	// Packed version of path stored earlier: Sets file to the copy in the cache directory,
+	// or to path if the item is packed itself. Size and CRC32 of the packed file are returned.
+	bool GetStandalone(const char *path, StdStrBuf *file, uint32_t *size, uint32_t *crc);
+	// Store a packed version of path. Pass standalone == path for items that are packed
+	// already; only the checksums are remembered for those. Queues the SHA1 calculation.
+	bool SetStandalone(const char *path, const char *standalone, uint32_t size, uint32_t crc);
+
+	// SHA1 of the packed version of path. Waits if the hashing thread is still busy with it.
+	bool GetSHA(const char *path, uint8_t *sha);
+	void SetSHA(const char *path, const uint8_t *sha);
+
+	// statistics
+	uint32_t HitCnt{0}, MissCnt{0};
+
+private:
+	struct Entry
+	{
+		StdCopyStrBuf Path;
+		Fingerprint Print;
+		StdCopyStrBuf File; // packed copy in the cache directory, empty if the item itself is packed
+		uint32_t FileSize{0}, FileCRC{0};
+		bool HasStandalone{false};
+		bool HasContentsCRC{false}; uint32_t ContentsCRC{0};
+		bool HasSHA{false}; uint8_t SHA[SHA_DIGEST_LENGTH];
+		int32_t LastUse{0};
+
+		void CompileFunc(StdCompiler *pComp);
+	};
+	struct HashJob
+	{
+		std::string Path, File;
+		Fingerprint Print;
+	};
+	class HashThread : public StdThread
+	{
+		C4Network2ResCache *Cache;
+	public:
+		HashThread(C4Network2ResCache *cache) : Cache(cache) { }
+	protected:
+		void Execute() override;
+	};
+	friend class HashThread;
+
+	std::string Directory;
+	uint64_t MaxSize{0};
+	std::map<std::string, Entry> Entries;
+	CStdCSec EntryLock;
+	bool Changed{false};
+
+	std::deque<HashJob> HashJobs; // not started yet
+	std::multiset<std::string> HashingPaths; // jobs in progress
+	HashThread Hasher;
+	CStdEvent HashEvent; // set while there are jobs
+	CStdEvent HashDoneEvent; // set whenever a job is finished
+
+	std::string GetIndexFilename() const;
+	bool SaveIndex();
+	Entry *GetEntry(const char *path, const Fingerprint &print, bool create); // with EntryLock
+	void RemoveFile(Entry &entry);
+	void Prune(); // removes packed copies over the size limit
+	bool RunHashJob(const char *path = nullptr); // the next job or the one for path
+	bool IsHashPending(const char *path); // with EntryLock
+};
+
+#endif // INC_C4Network2ResCache
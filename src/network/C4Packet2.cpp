@@ -395,18 +395,24 @@ void C4PacketList::CompileFunc(StdCompiler *pComp)
 // *** C4PacketConn
 
 C4PacketConn::C4PacketConn()
-		: iVer(C4XVER1*100 + C4XVER2)
+		: iVer(GetLocalVer())
 {
 }
 
 C4PacketConn::C4PacketConn(const C4ClientCore &nCCore, uint32_t inConnID, const char *szPassword)
-		: iVer(C4XVER1*100 + C4XVER2),
+		: iVer(GetLocalVer()),
 		iConnID(inConnID),
 		CCore(nCCore),
 		Password(szPassword)
 {
 }
 
+int32_t C4PacketConn::GetLocalVer()
+{
+	// Older engines only send the engine version, so they have revision 0
+	return C4NetProtocolRevision * 10000 + C4XVER1*100 + C4XVER2;
+}
+
 void C4PacketConn::CompileFunc(StdCompiler *pComp)
 {
 	pComp->Value(mkNamingAdapt(CCore, "CCore"));
@@ -553,8 +559,9 @@ void C4PacketResDiscover::CompileFunc(StdCompiler *pComp)
 
 // *** C4PacketResRequest
 
-C4PacketResRequest::C4PacketResRequest(int32_t inID, int32_t inChunk)
-		: iReqID(inID), iReqChunk(inChunk)
+C4PacketResRequest::C4PacketResRequest(int32_t inID, int32_t inChunk, int32_t inChunkCnt)
+		: iReqID(inID), iReqChunk(inChunk), iReqChunkCnt(inChunkCnt),
+		iCodecs(C4Network2Codecs::GetLocalMask())
 {
 
 }
@@ -563,6 +570,8 @@ void C4PacketResRequest::CompileFunc(StdCompiler *pComp)
 {
 	pComp->Value(mkNamingAdapt(iReqID, "ResID", -1));
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iReqChunk), "Chunk", -1));
+	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iReqChunkCnt), "ChunkCnt", 1));
+	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iCodecs), "Codecs", 1u << NCC_None));
 }
 
 // *** C4PacketControlReq
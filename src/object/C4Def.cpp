@@ -25,11 +25,14 @@
 #include "graphics/C4Draw.h"
 #include "graphics/C4DrawGL.h"
 #include "graphics/C4GraphicsResource.h"
+#include "graphics/C4PNGPrefetch.h"
 #include "graphics/CSurface8.h"
+#include "graphics/StdPNG.h"
 #include "landscape/C4Particles.h"
 #include "landscape/C4SolidMask.h"
 #include "lib/StdColors.h"
 #include "lib/StdMeshLoader.h"
+#include "object/C4DefList.h"
 #include "object/C4Object.h"
 #include "platform/C4FileMonitor.h"
 #include "platform/C4SoundSystem.h"
@@ -44,11 +47,13 @@ public:
 
 	C4Surface* LoadTexture(const char* filename) override
 	{
-		if (!Group.AccessEntry(filename)) return nullptr;
+		// PNGs may have been decoded in the background already
+		std::unique_ptr<CPNGFile> png = ::PNGPrefetch.Take(Group, filename);
+		if (!png && !Group.AccessEntry(filename)) return nullptr;
 		C4Surface* surface = new C4Surface;
 		// Suppress error message here, StdMeshMaterial loader
 		// will show one.
-		if (!surface->Read(Group, GetExtension(filename), C4SF_MipMap))
+		if (!(png ? surface->ReadPNG(*png, C4SF_MipMap) : surface->Read(Group, GetExtension(filename), C4SF_MipMap)))
 			{ delete surface; surface = nullptr; }
 		return surface;
 	}
@@ -365,21 +370,35 @@ bool C4Def::Load(C4Group &hGroup,
 
 	if (AddFileMonitoring) Game.pFileMonitor->AddDirectory(Filename);
 
+	// Time spent in the loading phases
+	C4DefListLoadTimes &times = ::Definitions.LoadTimes;
+	auto phase_start = std::chrono::steady_clock::now();
+	auto end_phase = [&phase_start](C4DefListLoadTimes::Duration &phase_time)
+	{
+		auto now = std::chrono::steady_clock::now();
+		phase_time += now - phase_start;
+		phase_start = now;
+	};
+
 	// Pre-read all images and shader stuff because they ar eaccessed in unpredictable order during loading
 	hGroup.PreCacheEntries(C4CFN_ShaderFiles);
 	hGroup.PreCacheEntries(C4CFN_ImageFiles);
+	end_phase(times.Read);
 
 	LoadMeshMaterials(hGroup, gfx_backup);
+	end_phase(times.Materials);
 	bool fSuccess = LoadParticleDef(hGroup);
 
 	// Read DefCore
 	if (fSuccess) fSuccess = LoadDefCore(hGroup);
+	end_phase(times.DefCore);
 
 	// Skip def: don't even read sounds!
 	if (fSuccess && Game.C4S.Definitions.SkipDefs.GetIDCount(id, 1)) return false;
 
 	// Read sounds, even if not a valid def (for pure ocd sound folders)
 	if (dwLoadWhat & C4D_Load_Sounds) LoadSounds(hGroup, pSoundSystem);
+	end_phase(times.Sounds);
 
 	// cancel if not a valid definition
 	if (!fSuccess) return false;
@@ -389,6 +408,7 @@ bool C4Def::Load(C4Group &hGroup,
 
 	// Read surface bitmap, meshes, skeletons
 	if ((dwLoadWhat & C4D_Load_Bitmap) && !LoadGraphics(hGroup, loader)) return false;
+	end_phase(times.Graphics);
 
 	// Read string table
 	C4Language::LoadComponentHost(&StringTable, hGroup, C4CFN_ScriptStringTbl, szLanguage);
@@ -405,9 +425,11 @@ bool C4Def::Load(C4Group &hGroup,
 
 	// Read clonkranks
 	if (dwLoadWhat & C4D_Load_RankNames) LoadRankNames(hGroup, szLanguage);
+	end_phase(times.Script);
 
 	// Read rankfaces
 	if (dwLoadWhat & C4D_Load_RankFaces) LoadRankFaces(hGroup);
+	end_phase(times.Graphics);
 
 	// Temporary flag
 	if (dwLoadWhat & C4D_Load_Temporary) Temporary=true;
@@ -575,7 +597,12 @@ void C4Def::LoadRankFaces(C4Group &hGroup)
 	// clear any previous
 	delete pRankSymbols; pRankSymbols = nullptr;
 	// load new
-	if (hGroup.AccessEntry(C4CFN_RankFacesPNG))
+	if (std::unique_ptr<CPNGFile> png = ::PNGPrefetch.Take(hGroup, C4CFN_RankFacesPNG))
+	{
+		pRankSymbols = new C4FacetSurface();
+		if (!pRankSymbols->GetFace().ReadPNG(*png, false)) { delete pRankSymbols; pRankSymbols = nullptr; }
+	}
+	else if (hGroup.AccessEntry(C4CFN_RankFacesPNG))
 	{
 		pRankSymbols = new C4FacetSurface();
 		if (!pRankSymbols->GetFace().ReadPNG(hGroup, false)) { delete pRankSymbols; pRankSymbols = nullptr; }
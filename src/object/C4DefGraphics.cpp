@@ -161,17 +161,19 @@ bool C4DefGraphics::LoadMesh(C4Group &hGroup, const char* szFileName, StdMeshSke
 
 	try
 	{
-		if(!hGroup.LoadEntry(szFileName, &buf, &size, 1)) return false;
-
 		if (SEqualNoCase(GetExtension(szFileName), "xml"))
 		{
+			if(!hGroup.LoadEntry(szFileName, &buf, &size, 1)) return false;
 			Mesh = StdMeshLoader::LoadMeshXml(buf, size, ::MeshMaterialManager, loader, hGroup.GetName());
+			delete[] buf; buf = nullptr;
 		}
 		else
 		{
-			Mesh = StdMeshLoader::LoadMeshBinary(buf, size, ::MeshMaterialManager, loader, hGroup.GetName());
+			// Binary meshes need no terminating zero and are read in place
+			C4GroupEntryView view;
+			if (!hGroup.LoadEntryView(szFileName, &view)) return false;
+			Mesh = StdMeshLoader::LoadMeshBinary(reinterpret_cast<const char *>(view.getData()), view.getSize(), ::MeshMaterialManager, loader, hGroup.GetName());
 		}
-		delete[] buf;
 
 		Mesh->SetLabel(pDef->id.ToString());
 
@@ -196,19 +198,22 @@ bool C4DefGraphics::LoadSkeleton(C4Group &hGroup, const char* szFileName, StdMes
 
 	try
 	{
-		if (!hGroup.LoadEntry(szFileName, &buf, &size, 1)) return false;
+		// Binary skeletons need no terminating zero and are read in place
+		bool is_xml = SEqualNoCase(GetExtension(szFileName), "xml");
+		C4GroupEntryView view;
+		if (is_xml ? !hGroup.LoadEntry(szFileName, &buf, &size, 1) : !hGroup.LoadEntryView(szFileName, &view)) return false;
 
 		// delete skeleton from the map for reloading, or else if you delete or rename
 		// a skeleton file in the folder the old skeleton will still exist in the map
 		loader.RemoveSkeleton(hGroup.GetName(), szFileName);
 
-		if (SEqualNoCase(GetExtension(szFileName), "xml"))
+		if (is_xml)
 		{
 			loader.LoadSkeletonXml(hGroup.GetName(), szFileName, buf, size);
 		}
 		else
 		{
-			loader.LoadSkeletonBinary(hGroup.GetName(), szFileName, buf, size);
+			loader.LoadSkeletonBinary(hGroup.GetName(), szFileName, reinterpret_cast<const char *>(view.getData()), view.getSize());
 		}
 
 		delete[] buf;
@@ -24,6 +24,7 @@
 #include "control/C4Record.h"
 #include "game/C4GameScript.h"
 #include "game/C4GameVersion.h"
+#include "graphics/C4PNGPrefetch.h"
 #include "lib/StdMeshLoader.h"
 #include "object/C4Def.h"
 #include "platform/C4FileMonitor.h"
@@ -73,6 +74,58 @@ int32_t C4DefList::Load(C4Group &hGroup, DWORD dwLoadWhat,
                         C4SoundSystem *pSoundSystem,
                         bool fOverload,
                         bool fSearchMessage, int32_t iMinProgress, int32_t iMaxProgress, bool fLoadSysGroups)
+{
+	// Definitions are loaded one by one, in order. Meanwhile, their images are decoded
+	// on worker threads, which is what most of the loading time used to be spent on.
+	auto start = std::chrono::steady_clock::now();
+	bool fPrefetch = (dwLoadWhat & C4D_Load_Bitmap) && !::PNGPrefetch.IsActive();
+	if (fPrefetch)
+	{
+		int32_t iSet = 0;
+		PrefetchImages(hGroup, iSet);
+		LoadTimes.Prefetch += std::chrono::steady_clock::now() - start;
+		::PNGPrefetch.Start();
+	}
+	int32_t iResult = LoadGroup(hGroup, dwLoadWhat, szLanguage, pSoundSystem, fOverload, fSearchMessage, iMinProgress, iMaxProgress, fLoadSysGroups);
+	if (fPrefetch)
+	{
+		LoadTimes.ThreadCnt = ::PNGPrefetch.ThreadCnt;
+		LoadTimes.ImageCnt += ::PNGPrefetch.QueuedCnt;
+		LoadTimes.PrefetchedImageCnt += ::PNGPrefetch.TakenCnt;
+		LoadTimes.Decode += ::PNGPrefetch.DecodeTime;
+		LoadTimes.DecodeWait += ::PNGPrefetch.WaitTime;
+		::PNGPrefetch.Clear();
+	}
+	LoadTimes.Total += std::chrono::steady_clock::now() - start;
+	return iResult;
+}
+
+void C4DefList::PrefetchImages(C4Group &hGroup, int32_t &iSet)
+{
+	// Queue images in the order LoadGroup reads the definitions. Entries are visited
+	// in group order, so packed groups are read in a single pass.
+	bool fIsDef = SEqualNoCase(GetExtension(hGroup.GetName()), "ocd");
+	int32_t iGroupSet = iSet++;
+	char szEntryname[_MAX_FNAME_LEN];
+	C4Group hChild;
+	hGroup.ResetSearch();
+	while (hGroup.FindNextEntry("*", szEntryname))
+	{
+		if (fIsDef && WildcardMatch(C4CFN_PNGFiles, szEntryname))
+			::PNGPrefetch.Add(hGroup, szEntryname, iGroupSet);
+		else if (WildcardMatch(C4CFN_DefFiles, szEntryname) && hChild.OpenAsChild(&hGroup, szEntryname))
+		{
+			PrefetchImages(hChild, iSet);
+			hChild.Close();
+		}
+	}
+}
+
+int32_t C4DefList::LoadGroup(C4Group &hGroup, DWORD dwLoadWhat,
+                             const char *szLanguage,
+                             C4SoundSystem *pSoundSystem,
+                             bool fOverload,
+                             bool fSearchMessage, int32_t iMinProgress, int32_t iMaxProgress, bool fLoadSysGroups)
 {
 	int32_t iResult=0;
 	C4Def *nDef = nullptr;
@@ -135,7 +188,7 @@ int32_t C4DefList::Load(C4Group &hGroup, DWORD dwLoadWhat,
 			int iSubMinProgress = std::min(iMaxProgress, iMinProgress + ((iMaxProgress - iMinProgress) * i) / 16);
 			int iSubMaxProgress = std::min(iMaxProgress, iMinProgress + ((iMaxProgress - iMinProgress) * (i + 1)) / 16);
 			++i;
-			iResult += Load(hChild,dwLoadWhat,szLanguage,pSoundSystem,fOverload,fSearchMessage,iSubMinProgress,iSubMaxProgress);
+			iResult += LoadGroup(hChild,dwLoadWhat,szLanguage,pSoundSystem,fOverload,fSearchMessage,iSubMinProgress,iSubMaxProgress,true);
 			hChild.Close();
 		}
 
@@ -414,6 +467,7 @@ void C4DefList::Default()
 {
 	FirstDef=nullptr;
 	LoadFailure=false;
+	LoadTimes = C4DefListLoadTimes();
 	table.clear();
 }
 
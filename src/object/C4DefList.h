@@ -22,6 +22,23 @@
 
 #include "graphics/C4FontLoaderCustomImages.h"
 
+#include <chrono>
+
+// Time spent in the phases of definition loading, for the startup timing report
+struct C4DefListLoadTimes
+{
+	typedef std::chrono::steady_clock::duration Duration;
+
+	int32_t ThreadCnt{0}; // workers decoding images in the background
+	int32_t ImageCnt{0}, PrefetchedImageCnt{0}; // images queued for / taken from background decoding
+	Duration Total{0};
+	Duration Prefetch{0}; // reading image data to be decoded in the background
+	// main thread phases of C4Def::Load
+	Duration Read{0}, Materials{0}, DefCore{0}, Sounds{0}, Graphics{0}, Script{0};
+	Duration Decode{0}; // background decoding, summed over all threads
+	Duration DecodeWait{0}; // main thread waiting for images being decoded
+};
+
 class C4DefList: public CStdFontCustomImages
 {
 public:
@@ -29,6 +46,7 @@ public:
 	~C4DefList() override;
 public:
 	bool LoadFailure;
+	C4DefListLoadTimes LoadTimes;
 	typedef std::map<C4ID, C4Def*> Table;
 	Table table;
 protected:
@@ -77,6 +95,10 @@ public:
 	float GetFontImageAspect(const char* szImageTag) override;
 private:
 	std::unique_ptr<StdMeshSkeletonLoader> SkeletonLoader;
+
+	int32_t LoadGroup(C4Group &hGroup, DWORD dwLoadWhat, const char *szLanguage, C4SoundSystem *pSoundSystem,
+	                  bool fOverload, bool fSearchMessage, int32_t iMinProgress, int32_t iMaxProgress, bool fLoadSysGroups);
+	void PrefetchImages(C4Group &hGroup, int32_t &iSet);
 };
 
 extern C4DefList Definitions;
@@ -16,6 +16,7 @@
 #include "C4Include.h"
 #include "object/C4FindObject.h"
 
+#include "game/C4Game.h"
 #include "lib/C4Random.h"
 #include "object/C4Def.h"
 #include "object/C4DefList.h"
@@ -23,6 +24,55 @@
 #include "object/C4Object.h"
 #include "player/C4PlayerList.h"
 
+// *** Query cache
+
+namespace
+{
+	enum C4FindObjectQuery { C4FOQ_Count, C4FOQ_Find, C4FOQ_FindMany };
+
+	// Results of identical searches within one frame, valid as long as no object was
+	// added, removed, moved or otherwise changed (see C4GameObjects::InvalidateQueries)
+	class C4FindObjectCache
+	{
+	public:
+		struct Entry
+		{
+			int32_t Count;
+			std::vector<C4Object *> Objects;
+		};
+
+		const Entry *Get(const C4FindObjectCacheKey &Key)
+		{
+			if (!IsCurrent()) return nullptr;
+			auto it = Results.find(Key);
+			return it != Results.end() ? &it->second : nullptr;
+		}
+
+		Entry *Put(const C4FindObjectCacheKey &Key, uint32_t iStateBefore)
+		{
+			// Something changed while searching (e.g. through a nested search)?
+			if (iStateBefore != ::Objects.GetQueryStateCounter()) return nullptr;
+			if (!IsCurrent() || Results.size() >= MaxEntries)
+			{
+				Results.clear();
+				Frame = Game.FrameCounter;
+				StateCounter = iStateBefore;
+			}
+			return &Results[Key];
+		}
+
+	private:
+		static const size_t MaxEntries = 256;
+		int32_t Frame = -1;
+		uint32_t StateCounter = 0;
+		std::map<C4FindObjectCacheKey, Entry> Results;
+
+		bool IsCurrent() const { return Frame == Game.FrameCounter && StateCounter == ::Objects.GetQueryStateCounter(); }
+	};
+
+	C4FindObjectCache QueryCache;
+}
+
 // *** C4FindObject
 
 C4FindObject::~C4FindObject()
@@ -257,7 +307,7 @@ C4FindObject *C4FindObject::CreateByValue(const C4Value &DataVal, C4SortObject *
 	return nullptr;
 }
 
-int32_t C4FindObject::Count(const C4ObjectList &Objs)
+template<class ObjectList> int32_t C4FindObject::CountIn(const ObjectList &Objs)
 {
 	// Trivial cases
 	if (IsImpossible())
@@ -272,7 +322,7 @@ int32_t C4FindObject::Count(const C4ObjectList &Objs)
 	return iCount;
 }
 
-C4Object *C4FindObject::Find(const C4ObjectList &Objs)
+template<class ObjectList> C4Object *C4FindObject::FindIn(const ObjectList &Objs)
 {
 	// Trivial case
 	if (IsImpossible())
@@ -296,7 +346,7 @@ C4Object *C4FindObject::Find(const C4ObjectList &Objs)
 }
 
 // return is to be freed by the caller
-C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs)
+template<class ObjectList> C4ValueArray *C4FindObject::FindManyIn(const ObjectList &Objs)
 {
 	// Trivial case
 	if (IsImpossible())
@@ -324,7 +374,127 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs)
 	return pArray;
 }
 
+int32_t C4FindObject::Count(const C4ObjectList &Objs)
+{
+	// Only search objects of the matching definition or category, if possible.
+	// Indexes are kept in main list order, so results are the same.
+	if (&Objs == &::Objects)
+		if (const C4SectorObjectList *pIndex = GetObjectIndex())
+			return CountIn(*pIndex);
+	return CountIn(Objs);
+}
+
+C4Object *C4FindObject::Find(const C4ObjectList &Objs)
+{
+	if (&Objs == &::Objects)
+		if (const C4SectorObjectList *pIndex = GetObjectIndex())
+			return FindIn(*pIndex);
+	return FindIn(Objs);
+}
+
+C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs)
+{
+	if (&Objs == &::Objects)
+		if (const C4SectorObjectList *pIndex = GetObjectIndex())
+			return FindManyIn(*pIndex);
+	return FindManyIn(Objs);
+}
+
+const C4SectorObjectList *C4FindObject::GetSmallerIndex(const C4Rect &Bounds, bool fShapes)
+{
+	// Use the object index if it holds fewer objects than the sector lists of the area
+	const C4SectorObjectList *pIndex = GetObjectIndex();
+	if (!pIndex) return nullptr;
+	size_t iAreaCount = 0;
+	C4LArea Area(&::Objects.Sectors, Bounds); C4LSector *pSct;
+	if (fShapes)
+	{
+		for (C4SectorObjectList *pLst=Area.FirstObjectShapes(&pSct); pLst; pLst=Area.NextObjectShapes(pLst, &pSct))
+			if ((iAreaCount += pLst->size()) > pIndex->size())
+				return pIndex;
+	}
+	else
+	{
+		for (C4SectorObjectList *pLst=Area.FirstObjects(&pSct); pLst; pLst=Area.NextObjects(pLst, &pSct))
+			if ((iAreaCount += pLst->size()) > pIndex->size())
+				return pIndex;
+	}
+	return nullptr;
+}
+
+bool C4FindObject::GetQueryCacheKey(C4FindObjectCacheKey &Key, int32_t iQuery)
+{
+	Key.push_back(iQuery);
+	if (!GetCacheKey(Key)) return false;
+	if (pSort)
+		return pSort->GetCacheKey(Key);
+	Key.push_back(0);
+	return true;
+}
+
 int32_t C4FindObject::Count(const C4ObjectList &Objs, const C4LSectors &Sct)
+{
+	// Identical search earlier this frame?
+	C4FindObjectCacheKey Key;
+	bool fCache = (&Objs == &::Objects) && GetQueryCacheKey(Key, C4FOQ_Count);
+	if (fCache)
+		if (const C4FindObjectCache::Entry *pEntry = QueryCache.Get(Key))
+			return pEntry->Count;
+	uint32_t iState = ::Objects.GetQueryStateCounter();
+	int32_t iCount = CountInSectors(Objs);
+	if (fCache)
+		if (C4FindObjectCache::Entry *pEntry = QueryCache.Put(Key, iState))
+			pEntry->Count = iCount;
+	return iCount;
+}
+
+C4Object *C4FindObject::Find(const C4ObjectList &Objs, const C4LSectors &Sct)
+{
+	// Identical search earlier this frame?
+	C4FindObjectCacheKey Key;
+	bool fCache = (&Objs == &::Objects) && GetQueryCacheKey(Key, C4FOQ_Find);
+	if (fCache)
+		if (const C4FindObjectCache::Entry *pEntry = QueryCache.Get(Key))
+			return pEntry->Count ? pEntry->Objects[0] : nullptr;
+	uint32_t iState = ::Objects.GetQueryStateCounter();
+	C4Object *pObj = FindInSectors(Objs);
+	if (fCache)
+		if (C4FindObjectCache::Entry *pEntry = QueryCache.Put(Key, iState))
+		{
+			pEntry->Count = !!pObj;
+			pEntry->Objects.assign(pEntry->Count, pObj);
+		}
+	return pObj;
+}
+
+// return is to be freed by the caller
+C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs, const C4LSectors &Sct)
+{
+	// Identical search earlier this frame? Return a copy, because scripts may modify the array.
+	C4FindObjectCacheKey Key;
+	bool fCache = (&Objs == &::Objects) && GetQueryCacheKey(Key, C4FOQ_FindMany);
+	if (fCache)
+		if (const C4FindObjectCache::Entry *pEntry = QueryCache.Get(Key))
+		{
+			C4ValueArray *pArray = new C4ValueArray(pEntry->Count);
+			for (int32_t i = 0; i < pEntry->Count; i++)
+				(*pArray)[i] = C4VObj(pEntry->Objects[i]);
+			return pArray;
+		}
+	uint32_t iState = ::Objects.GetQueryStateCounter();
+	C4ValueArray *pArray = FindManyInSectors(Objs);
+	if (fCache)
+		if (C4FindObjectCache::Entry *pEntry = QueryCache.Put(Key, iState))
+		{
+			pEntry->Count = pArray->GetSize();
+			pEntry->Objects.resize(pEntry->Count);
+			for (int32_t i = 0; i < pEntry->Count; i++)
+				pEntry->Objects[i] = pArray->GetItem(i)._getObj();
+		}
+	return pArray;
+}
+
+int32_t C4FindObject::CountInSectors(const C4ObjectList &Objs)
 {
 	// Trivial cases
 	if (IsImpossible())
@@ -335,19 +505,22 @@ int32_t C4FindObject::Count(const C4ObjectList &Objs, const C4LSectors &Sct)
 	C4Rect *pBounds = GetBounds();
 	if (!pBounds)
 		return Count(Objs);
+	else if (const C4SectorObjectList *pIndex = GetSmallerIndex(*pBounds, UseShapes()))
+		return CountIn(*pIndex);
 	else if (UseShapes())
 	{
 		// Get area
 		C4LArea Area(&::Objects.Sectors, *pBounds); C4LSector *pSct;
-		C4ObjectList *pLst = Area.FirstObjectShapes(&pSct);
+		C4SectorObjectList *pLst = Area.FirstObjectShapes(&pSct);
 		// Check if a single-sector check is enough
-		if (!Area.Next(pSct))
-			return Count(pSct->ObjectShapes);
+		C4LSector *pNextSct = pSct;
+		if (!Area.NextObjectShapes(pLst, &pNextSct))
+			return CountIn(pSct->ObjectShapes);
 		// Create marker, count over all areas
 		uint32_t iMarker = ::Objects.GetNextMarker();
 		int32_t iCount = 0;
 		for (; pLst; pLst=Area.NextObjectShapes(pLst, &pSct))
-			for (C4Object *obj : Objs)
+			for (C4Object *obj : *pLst)
 				if (obj->Status)
 					if (obj->Marker != iMarker)
 					{
@@ -362,13 +535,13 @@ int32_t C4FindObject::Count(const C4ObjectList &Objs, const C4LSectors &Sct)
 		// Count objects per area
 		C4LArea Area(&::Objects.Sectors, *pBounds); C4LSector *pSct;
 		int32_t iCount = 0;
-		for (C4ObjectList *pLst=Area.FirstObjects(&pSct); pLst; pLst=Area.NextObjects(pLst, &pSct))
-			iCount += Count(*pLst);
+		for (C4SectorObjectList *pLst=Area.FirstObjects(&pSct); pLst; pLst=Area.NextObjects(pLst, &pSct))
+			iCount += CountIn(*pLst);
 		return iCount;
 	}
 }
 
-C4Object *C4FindObject::Find(const C4ObjectList &Objs, const C4LSectors &Sct)
+C4Object *C4FindObject::FindInSectors(const C4ObjectList &Objs)
 {
 	// Trivial case
 	if (IsImpossible())
@@ -378,13 +551,15 @@ C4Object *C4FindObject::Find(const C4ObjectList &Objs, const C4LSectors &Sct)
 	C4Rect *pBounds = GetBounds();
 	if (!pBounds)
 		return Find(Objs);
+	else if (const C4SectorObjectList *pIndex = GetSmallerIndex(*pBounds, UseShapes()))
+		return FindIn(*pIndex);
 	// Traverse areas, return first matching object w/o sort or best with sort
 	else if (UseShapes())
 	{
 		C4LArea Area(&::Objects.Sectors, *pBounds); C4LSector *pSct;
 		C4Object *pObj;
-		for (C4ObjectList *pLst=Area.FirstObjectShapes(&pSct); pLst; pLst=Area.NextObjectShapes(pLst, &pSct))
-			if ((pObj = Find(*pLst)))
+		for (C4SectorObjectList *pLst=Area.FirstObjectShapes(&pSct); pLst; pLst=Area.NextObjectShapes(pLst, &pSct))
+			if ((pObj = FindIn(*pLst)))
 			{
 				if (!pSort)
 					return pObj;
@@ -397,9 +572,9 @@ C4Object *C4FindObject::Find(const C4ObjectList &Objs, const C4LSectors &Sct)
 	{
 		C4LArea Area(&::Objects.Sectors, *pBounds); C4LSector *pSct;
 		C4Object *pObj;
-		for (C4ObjectList *pLst=Area.FirstObjects(&pSct); pLst; pLst=Area.NextObjects(pLst, &pSct))
+		for (C4SectorObjectList *pLst=Area.FirstObjects(&pSct); pLst; pLst=Area.NextObjects(pLst, &pSct))
 		{
-			if ((pObj = Find(*pLst)))
+			if ((pObj = FindIn(*pLst)))
 			{
 				if (!pSort)
 					return pObj;
@@ -413,7 +588,7 @@ C4Object *C4FindObject::Find(const C4ObjectList &Objs, const C4LSectors &Sct)
 }
 
 // return is to be freed by the caller
-C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs, const C4LSectors &Sct)
+C4ValueArray *C4FindObject::FindManyInSectors(const C4ObjectList &Objs)
 {
 	// Trivial case
 	if (IsImpossible())
@@ -421,6 +596,8 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs, const C4LSectors
 	C4Rect *pBounds = GetBounds();
 	if (!pBounds)
 		return FindMany(Objs);
+	else if (const C4SectorObjectList *pIndex = GetSmallerIndex(*pBounds, UseShapes()))
+		return FindManyIn(*pIndex);
 	// Prepare for array that may be generated
 	C4ValueArray *pArray; int32_t iSize;
 	// Check shape lists?
@@ -428,10 +605,11 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs, const C4LSectors
 	{
 		// Get area
 		C4LArea Area(&::Objects.Sectors, *pBounds); C4LSector *pSct;
-		C4ObjectList *pLst = Area.FirstObjectShapes(&pSct);
+		C4SectorObjectList *pLst = Area.FirstObjectShapes(&pSct);
 		// Check if a single-sector check is enough
-		if (!Area.Next(pSct))
-			return FindMany(pSct->ObjectShapes);
+		C4LSector *pNextSct = pSct;
+		if (!Area.NextObjectShapes(pLst, &pNextSct))
+			return FindManyIn(pSct->ObjectShapes);
 		// Set up array
 		pArray = new C4ValueArray(32); iSize = 0;
 		// Create marker, search all areas
@@ -458,7 +636,7 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs, const C4LSectors
 		pArray = new C4ValueArray(32); iSize = 0;
 		// Search
 		C4LArea Area(&::Objects.Sectors, *pBounds); C4LSector *pSct;
-		for (C4ObjectList *pLst=Area.FirstObjects(&pSct); pLst; pLst=Area.NextObjects(pLst, &pSct))
+		for (C4SectorObjectList *pLst=Area.FirstObjects(&pSct); pLst; pLst=Area.NextObjects(pLst, &pSct))
 			for (C4Object *obj : *pLst)
 				if (obj->Status)
 					if (Check(obj))
@@ -515,6 +693,12 @@ bool C4FindObjectNot::Check(C4Object *pObj)
 	return !pCond->Check(pObj);
 }
 
+bool C4FindObjectNot::GetCacheKey(C4FindObjectCacheKey &Key)
+{
+	Key.push_back(C4FO_Not);
+	return pCond->GetCacheKey(Key);
+}
+
 // *** C4FindObjectAnd
 
 C4FindObjectAnd::C4FindObjectAnd(int32_t inCnt, C4FindObject **ppConds, bool fFreeArray)
@@ -552,6 +736,8 @@ C4FindObjectAnd::C4FindObjectAnd(int32_t inCnt, C4FindObject **ppConds, bool fFr
 			// the objects will be filtered out later
 		}
 	}
+	// Check cheap conditions first, so script callbacks are only done for remaining candidates
+	std::stable_sort(ppConds, ppConds + iCnt, [](C4FindObject *pCond1, C4FindObject *pCond2) { return pCond1->GetCost() < pCond2->GetCost(); });
 }
 
 C4FindObjectAnd::~C4FindObjectAnd()
@@ -578,6 +764,34 @@ bool C4FindObjectAnd::IsImpossible()
 	return false;
 }
 
+int32_t C4FindObjectAnd::GetCost()
+{
+	int32_t iCost = 0;
+	for (int32_t i = 0; i < iCnt; i++)
+		iCost += ppConds[i]->GetCost();
+	return iCost;
+}
+
+const C4SectorObjectList *C4FindObjectAnd::GetObjectIndex()
+{
+	// Use the smallest index of all conditions
+	const C4SectorObjectList *pBestIndex = nullptr;
+	for (int32_t i = 0; i < iCnt; i++)
+		if (const C4SectorObjectList *pIndex = ppConds[i]->GetObjectIndex())
+			if (!pBestIndex || pIndex->size() < pBestIndex->size())
+				pBestIndex = pIndex;
+	return pBestIndex;
+}
+
+bool C4FindObjectAnd::GetCacheKey(C4FindObjectCacheKey &Key)
+{
+	Key.push_back(C4FO_And); Key.push_back(iCnt);
+	for (int32_t i = 0; i < iCnt; i++)
+		if (!ppConds[i]->GetCacheKey(Key))
+			return false;
+	return true;
+}
+
 // *** C4FindObjectOr
 
 C4FindObjectOr::C4FindObjectOr(int32_t inCnt, C4FindObject **ppConds)
@@ -613,6 +827,8 @@ C4FindObjectOr::C4FindObjectOr(int32_t inCnt, C4FindObject **ppConds)
 			fHasBounds = true;
 		}
 	}
+	// Check cheap conditions first
+	std::stable_sort(ppConds, ppConds + iCnt, [](C4FindObject *pCond1, C4FindObject *pCond2) { return pCond1->GetCost() < pCond2->GetCost(); });
 }
 
 C4FindObjectOr::~C4FindObjectOr()
@@ -638,6 +854,23 @@ bool C4FindObjectOr::IsEnsured()
 	return false;
 }
 
+int32_t C4FindObjectOr::GetCost()
+{
+	int32_t iCost = 0;
+	for (int32_t i = 0; i < iCnt; i++)
+		iCost += ppConds[i]->GetCost();
+	return iCost;
+}
+
+bool C4FindObjectOr::GetCacheKey(C4FindObjectCacheKey &Key)
+{
+	Key.push_back(C4FO_Or); Key.push_back(iCnt);
+	for (int32_t i = 0; i < iCnt; i++)
+		if (!ppConds[i]->GetCacheKey(Key))
+			return false;
+	return true;
+}
+
 // *** C4FindObject* (primitive conditions)
 
 bool C4FindObjectExclude::Check(C4Object *pObj)
@@ -645,6 +878,12 @@ bool C4FindObjectExclude::Check(C4Object *pObj)
 	return pObj != pExclude;
 }
 
+bool C4FindObjectExclude::GetCacheKey(C4FindObjectCacheKey &Key)
+{
+	Key.insert(Key.end(), { C4FO_Exclude, reinterpret_cast<intptr_t>(pExclude) });
+	return true;
+}
+
 bool C4FindObjectDef::Check(C4Object *pObj)
 {
 	return pObj->GetPrototype() == def;
@@ -655,6 +894,21 @@ bool C4FindObjectDef::IsImpossible()
 	return !def || !def->GetDef() || !def->GetDef()->Count;
 }
 
+const C4SectorObjectList *C4FindObjectDef::GetObjectIndex()
+{
+	C4Def *pDef = def ? def->GetDef() : nullptr;
+	// The index holds the objects of the definition. It can be used if the definition is
+	// searched for itself, and no object of another definition has it as prototype.
+	if (!pDef || pDef != def || ::Objects.HasForeignPrototypes(def)) return nullptr;
+	return &::Objects.GetDefObjects(pDef);
+}
+
+bool C4FindObjectDef::GetCacheKey(C4FindObjectCacheKey &Key)
+{
+	Key.insert(Key.end(), { C4FO_ID, reinterpret_cast<intptr_t>(def) });
+	return true;
+}
+
 bool C4FindObjectInRect::Check(C4Object *pObj)
 {
 	return rect.Contains(pObj->GetX(), pObj->GetY());
@@ -665,11 +919,23 @@ bool C4FindObjectInRect::IsImpossible()
 	return !rect.Wdt || !rect.Hgt;
 }
 
+bool C4FindObjectInRect::GetCacheKey(C4FindObjectCacheKey &Key)
+{
+	Key.insert(Key.end(), { C4FO_InRect, rect.x, rect.y, rect.Wdt, rect.Hgt });
+	return true;
+}
+
 bool C4FindObjectAtPoint::Check(C4Object *pObj)
 {
 	return pObj->Shape.Contains(bounds.x - pObj->GetX(), bounds.y - pObj->GetY());
 }
 
+bool C4FindObjectAtPoint::GetCacheKey(C4FindObjectCacheKey &Key)
+{
+	Key.insert(Key.end(), { C4FO_AtPoint, bounds.x, bounds.y });
+	return true;
+}
+
 bool C4FindObjectAtRect::Check(C4Object *pObj)
 {
 	C4Rect rcShapeBounds = pObj->Shape;
@@ -677,16 +943,34 @@ bool C4FindObjectAtRect::Check(C4Object *pObj)
 	return !!rcShapeBounds.Overlap(bounds);
 }
 
+bool C4FindObjectAtRect::GetCacheKey(C4FindObjectCacheKey &Key)
+{
+	Key.insert(Key.end(), { C4FO_AtRect, bounds.x, bounds.y, bounds.Wdt, bounds.Hgt });
+	return true;
+}
+
 bool C4FindObjectOnLine::Check(C4Object *pObj)
 {
 	return pObj->Shape.IntersectsLine(x - pObj->GetX(), y - pObj->GetY(), x2 - pObj->GetX(), y2 - pObj->GetY());
 }
 
+bool C4FindObjectOnLine::GetCacheKey(C4FindObjectCacheKey &Key)
+{
+	Key.insert(Key.end(), { C4FO_OnLine, x, y, x2, y2 });
+	return true;
+}
+
 bool C4FindObjectDistance::Check(C4Object *pObj)
 {
 	return (pObj->GetX() - x) * (pObj->GetX() - x) + (pObj->GetY() - y) * (pObj->GetY() - y) <= r2;
 }
 
+bool C4FindObjectDistance::GetCacheKey(C4FindObjectCacheKey &Key)
+{
+	Key.insert(Key.end(), { C4FO_Distance, x, y, r2 });
+	return true;
+}
+
 bool C4FindObjectCone::Check(C4Object *pObj)
 {
 	bool in_circle = (pObj->GetX() - x) * (pObj->GetX() - x) + (pObj->GetY() - y) * (pObj->GetY() - y) <= r2;
@@ -697,6 +981,12 @@ bool C4FindObjectCone::Check(C4Object *pObj)
 	return in_circle && in_cone;
 }
 
+bool C4FindObjectCone::GetCacheKey(C4FindObjectCacheKey &Key)
+{
+	Key.insert(Key.end(), { C4FO_Cone, x, y, r2, cone_angle, cone_width, prec_angle });
+	return true;
+}
+
 bool C4FindObjectOCF::Check(C4Object *pObj)
 {
 	return !! (pObj->OCF & ocf);
@@ -717,6 +1007,22 @@ bool C4FindObjectCategory::IsEnsured()
 	return !iCategory;
 }
 
+const C4SectorObjectList *C4FindObjectCategory::GetObjectIndex()
+{
+	// Objects matching any of multiple bits are spread over several indexes. Category 0
+	// matches every object, and negative categories are left to Check.
+	if (iCategory <= 0) return nullptr;
+	const uint32_t category = iCategory;
+	if (category & (category - 1)) return nullptr;
+	return &::Objects.GetCategoryObjects(iCategory);
+}
+
+bool C4FindObjectCategory::GetCacheKey(C4FindObjectCacheKey &Key)
+{
+	Key.insert(Key.end(), { C4FO_Category, iCategory });
+	return true;
+}
+
 bool C4FindObjectAction::Check(C4Object *pObj)
 {
 	assert(pObj);
@@ -815,6 +1121,12 @@ bool C4FindObjectLayer::IsImpossible()
 	return false;
 }
 
+bool C4FindObjectLayer::GetCacheKey(C4FindObjectCacheKey &Key)
+{
+	Key.insert(Key.end(), { C4FO_Layer, reinterpret_cast<intptr_t>(pLayer) });
+	return true;
+}
+
 // *** C4FindObjectInArray
 
 bool C4FindObjectInArray::Check(C4Object *pObj)
@@ -1005,6 +1317,12 @@ int32_t C4SortObjectReverse::CompareCache(int32_t iObj1, int32_t iObj2, C4Object
 	return pSort->CompareCache(iObj2, iObj1, pObj2, pObj1);
 }
 
+bool C4SortObjectReverse::GetCacheKey(C4FindObjectCacheKey &Key)
+{
+	Key.push_back(C4SO_Reverse);
+	return pSort->GetCacheKey(Key);
+}
+
 C4SortObjectMultiple::~C4SortObjectMultiple()
 {
 	for (int32_t i=0; i<iCnt; ++i) delete ppSorts[i];
@@ -1042,12 +1360,27 @@ int32_t C4SortObjectMultiple::CompareCache(int32_t iObj1, int32_t iObj2, C4Objec
 	return 0;
 }
 
+bool C4SortObjectMultiple::GetCacheKey(C4FindObjectCacheKey &Key)
+{
+	Key.push_back(C4SO_Multiple); Key.push_back(iCnt);
+	for (int32_t i=0; i<iCnt; ++i)
+		if (!ppSorts[i]->GetCacheKey(Key))
+			return false;
+	return true;
+}
+
 int32_t C4SortObjectDistance::CompareGetValue(C4Object *pFor)
 {
 	int32_t dx=pFor->GetX()-iX, dy=pFor->GetY()-iY;
 	return dx*dx+dy*dy;
 }
 
+bool C4SortObjectDistance::GetCacheKey(C4FindObjectCacheKey &Key)
+{
+	Key.insert(Key.end(), { C4SO_Distance, iX, iY });
+	return true;
+}
+
 int32_t C4SortObjectRandom::CompareGetValue(C4Object *pFor)
 {
 	return Random(1 << 16);
@@ -19,6 +19,8 @@
 #include "lib/C4Rect.h"
 #include "script/C4Value.h"
 
+#include <vector>
+
 // Condition map
 enum C4FindObjectCondID
 {
@@ -65,6 +67,18 @@ enum C4SortObjectCondID
 	C4SO_Last         = 50  // no sort condition larger than this
 };
 
+// Estimated cost of checking a condition on a single object; used to order And/Or children
+enum C4FindObjectCost
+{
+	C4FOC_Trivial  = 1,   // compare a single field
+	C4FOC_Geometry = 2,   // position or shape test
+	C4FOC_Lookup   = 8,   // string, property or array lookup
+	C4FOC_Script   = 100, // script callback
+};
+
+// Key of a query in the per-frame result cache
+typedef std::vector<intptr_t> C4FindObjectCacheKey;
+
 // Base class
 class C4FindObject
 {
@@ -96,9 +110,26 @@ protected:
 	virtual bool UseShapes() { return false; }
 	virtual bool IsImpossible() { return false; }
 	virtual bool IsEnsured() { return false; }
+	virtual int32_t GetCost() { return C4FOC_Trivial; }
+	// Append a key identifying this condition. Only conditions that depend on nothing but object
+	// existence, position, shape, definition, category and layer may be cached.
+	virtual bool GetCacheKey(C4FindObjectCacheKey &Key) { return false; }
+	// Index of the main object list that contains all objects this condition can be true for
+	virtual const C4SectorObjectList *GetObjectIndex() { return nullptr; }
 
 private:
+	// Search in a single list; instantiated for C4ObjectList and C4SectorObjectList
+	template<class ObjectList> int32_t CountIn(const ObjectList &Objs);
+	template<class ObjectList> C4Object *FindIn(const ObjectList &Objs);
+	template<class ObjectList> C4ValueArray *FindManyIn(const ObjectList &Objs);
+	// Search through the sector lists, without the query cache
+	int32_t CountInSectors(const C4ObjectList &Objs);
+	C4Object *FindInSectors(const C4ObjectList &Objs);
+	C4ValueArray *FindManyInSectors(const C4ObjectList &Objs);
+
 	void CheckObjectStatus(C4ValueArray *pArray);
+	const C4SectorObjectList *GetSmallerIndex(const C4Rect &Bounds, bool fShapes);
+	bool GetQueryCacheKey(C4FindObjectCacheKey &Key, int32_t iQuery);
 };
 
 // Combinators
@@ -114,6 +145,8 @@ protected:
 	bool Check(C4Object *pObj) override;
 	bool IsImpossible() override { return pCond->IsEnsured(); }
 	bool IsEnsured() override { return pCond->IsImpossible(); }
+	int32_t GetCost() override { return pCond->GetCost(); }
+	bool GetCacheKey(C4FindObjectCacheKey &Key) override;
 };
 
 class C4FindObjectAnd : public C4FindObject
@@ -131,6 +164,9 @@ protected:
 	bool UseShapes() override { return fUseShapes; }
 	bool IsEnsured() override { return !iCnt; }
 	bool IsImpossible() override;
+	int32_t GetCost() override;
+	bool GetCacheKey(C4FindObjectCacheKey &Key) override;
+	const C4SectorObjectList *GetObjectIndex() override;
 	void ForgetConditions() { ppConds=nullptr; iCnt=0; }
 };
 
@@ -158,6 +194,8 @@ protected:
 	bool UseShapes() override { return fUseShapes; }
 	bool IsEnsured() override;
 	bool IsImpossible() override { return !iCnt; }
+	int32_t GetCost() override;
+	bool GetCacheKey(C4FindObjectCacheKey &Key) override;
 };
 
 // Primitive conditions
@@ -170,6 +208,7 @@ private:
 	C4Object *pExclude;
 protected:
 	bool Check(C4Object *pObj) override;
+	bool GetCacheKey(C4FindObjectCacheKey &Key) override;
 };
 
 class C4FindObjectDef : public C4FindObject
@@ -182,6 +221,8 @@ private:
 protected:
 	bool Check(C4Object *pObj) override;
 	bool IsImpossible() override;
+	bool GetCacheKey(C4FindObjectCacheKey &Key) override;
+	const C4SectorObjectList *GetObjectIndex() override;
 };
 
 class C4FindObjectInRect : public C4FindObject
@@ -195,6 +236,8 @@ protected:
 	bool Check(C4Object *pObj) override;
 	C4Rect *GetBounds() override { return &rect; }
 	bool IsImpossible() override;
+	int32_t GetCost() override { return C4FOC_Geometry; }
+	bool GetCacheKey(C4FindObjectCacheKey &Key) override;
 };
 
 class C4FindObjectAtPoint : public C4FindObject
@@ -208,6 +251,8 @@ protected:
 	bool Check(C4Object *pObj) override;
 	C4Rect *GetBounds() override { return &bounds; }
 	bool UseShapes() override { return true; }
+	int32_t GetCost() override { return C4FOC_Geometry; }
+	bool GetCacheKey(C4FindObjectCacheKey &Key) override;
 };
 
 class C4FindObjectAtRect : public C4FindObject
@@ -221,6 +266,8 @@ protected:
 	bool Check(C4Object *pObj) override;
 	C4Rect *GetBounds() override { return &bounds; }
 	bool UseShapes() override { return true; }
+	int32_t GetCost() override { return C4FOC_Geometry; }
+	bool GetCacheKey(C4FindObjectCacheKey &Key) override;
 };
 
 class C4FindObjectOnLine : public C4FindObject
@@ -235,6 +282,8 @@ protected:
 	bool Check(C4Object *pObj) override;
 	C4Rect *GetBounds() override { return &bounds; }
 	bool UseShapes() override { return true; }
+	int32_t GetCost() override { return C4FOC_Geometry; }
+	bool GetCacheKey(C4FindObjectCacheKey &Key) override;
 };
 
 class C4FindObjectDistance : public C4FindObject
@@ -248,6 +297,8 @@ private:
 protected:
 	bool Check(C4Object *pObj) override;
 	C4Rect *GetBounds() override { return &bounds; }
+	int32_t GetCost() override { return C4FOC_Geometry; }
+	bool GetCacheKey(C4FindObjectCacheKey &Key) override;
 };
 
 class C4FindObjectCone : public C4FindObject
@@ -261,6 +312,8 @@ private:
 protected:
 	bool Check(C4Object *pObj) override;
 	C4Rect *GetBounds() override { return &bounds; }
+	int32_t GetCost() override { return C4FOC_Geometry; }
+	bool GetCacheKey(C4FindObjectCacheKey &Key) override;
 };
 
 class C4FindObjectOCF : public C4FindObject
@@ -285,6 +338,8 @@ private:
 protected:
 	bool Check(C4Object *pObj) override;
 	bool IsEnsured() override;
+	bool GetCacheKey(C4FindObjectCacheKey &Key) override;
+	const C4SectorObjectList *GetObjectIndex() override;
 };
 
 class C4FindObjectAction : public C4FindObject
@@ -296,6 +351,7 @@ private:
 	const char *szAction;
 protected:
 	bool Check(C4Object *pObj) override;
+	int32_t GetCost() override { return C4FOC_Lookup; }
 };
 
 class C4FindObjectActionTarget : public C4FindObject
@@ -376,6 +432,7 @@ private:
 protected:
 	bool Check(C4Object *pObj) override;
 	bool IsImpossible() override;
+	int32_t GetCost() override { return C4FOC_Script; }
 };
 
 class C4FindObjectProperty : public C4FindObject
@@ -391,6 +448,7 @@ private:
 protected:
 	bool Check(C4Object *pObj) override;
 	bool IsImpossible() override;
+	int32_t GetCost() override { return C4FOC_Lookup; }
 };
 
 class C4FindObjectLayer : public C4FindObject
@@ -402,6 +460,7 @@ private:
 protected:
 	bool Check(C4Object *pObj) override;
 	bool IsImpossible() override;
+	bool GetCacheKey(C4FindObjectCacheKey &Key) override;
 };
 
 class C4FindObjectInArray : public C4FindObject
@@ -413,6 +472,7 @@ private:
 protected:
 	bool Check(C4Object *pObj) override;
 	bool IsImpossible() override;
+	int32_t GetCost() override { return C4FOC_Lookup; }
 };
 
 // result sorting
@@ -428,6 +488,7 @@ public:
 
 	virtual bool PrepareCache(const C4ValueArray *pObjs) { return false; }
 	virtual int32_t CompareCache(int32_t iObj1, int32_t iObj2, C4Object *pObj1, C4Object *pObj2) { return Compare(pObj1, pObj2); }
+	virtual bool GetCacheKey(C4FindObjectCacheKey &Key) { return false; } // see C4FindObject::GetCacheKey
 
 public:
 	static C4SortObject *CreateByValue(const C4Value &Data, const C4Object *context=nullptr);
@@ -470,6 +531,7 @@ protected:
 
 	bool PrepareCache(const C4ValueArray *pObjs) override;
 	int32_t CompareCache(int32_t iObj1, int32_t iObj2, C4Object *pObj1, C4Object *pObj2) override;
+	bool GetCacheKey(C4FindObjectCacheKey &Key) override;
 };
 
 class C4SortObjectMultiple : public C4SortObject // apply next sort if previous compares to equality
@@ -488,6 +550,7 @@ protected:
 
 	bool PrepareCache(const C4ValueArray *pObjs) override;
 	int32_t CompareCache(int32_t iObj1, int32_t iObj2, C4Object *pObj1, C4Object *pObj2) override;
+	bool GetCacheKey(C4FindObjectCacheKey &Key) override;
 };
 
 class C4SortObjectDistance : public C4SortObjectByValue // sort by distance from point x/y
@@ -500,6 +563,7 @@ private:
 
 protected:
 	int32_t CompareGetValue(C4Object *pFor) override;
+	bool GetCacheKey(C4FindObjectCacheKey &Key) override;
 };
 
 class C4SortObjectRandom : public C4SortObjectByValue // randomize order
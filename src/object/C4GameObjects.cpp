@@ -24,6 +24,7 @@
 #include "lib/C4Random.h"
 #include "network/C4Network2Stats.h"
 #include "object/C4Def.h"
+#include "object/C4DefList.h"
 #include "object/C4Object.h"
 #include "object/C4ObjectCom.h"
 #include "player/C4PlayerList.h"
@@ -43,6 +44,8 @@ void C4GameObjects::Default()
 {
 	Sectors.Clear();
 	LastUsedMarker = 0;
+	InvalidateQueries();
+	ClearIndexes();
 	ForeObjects.Default();
 }
 
@@ -69,12 +72,14 @@ bool C4GameObjects::Add(C4Object *object)
 		return false;
 	// Add to sectors
 	Sectors.Add(object, this);
+	InvalidateQueries();
 	return true;
 }
 
 
 bool C4GameObjects::Remove(C4Object *object)
 {
+	SetForeignPrototype(object, nullptr);
 	// If it's an inactive object, simply remove it from the inactive list
 	if (object->Status == C4OS_INACTIVE)
 	{
@@ -82,12 +87,187 @@ bool C4GameObjects::Remove(C4Object *object)
 	}
 	// Remove from sectors
 	Sectors.Remove(object);
+	InvalidateQueries();
 	// Remove from forelist
 	ForeObjects.Remove(object);
 	// Manipulate main list
 	return C4ObjectList::Remove(object);
 }
 
+void C4GameObjects::InsertLinkBefore(C4ObjectLink *link, C4ObjectLink *before_link)
+{
+	C4NotifyingObjectList::InsertLinkBefore(link, before_link);
+	AssignMainListOrder(link);
+	AddToIndexes(link);
+}
+
+void C4GameObjects::InsertLink(C4ObjectLink *link, C4ObjectLink *after_link)
+{
+	C4NotifyingObjectList::InsertLink(link, after_link);
+	AssignMainListOrder(link);
+	AddToIndexes(link);
+}
+
+void C4GameObjects::RemoveLink(C4ObjectLink *link)
+{
+	RemoveFromIndexes(link->Obj, link->Obj->Def, link->Obj->Category);
+	C4NotifyingObjectList::RemoveLink(link);
+}
+
+// Distance between the order keys of neighbouring objects after renumbering
+static const uint64_t MainListOrderStep = uint64_t(1) << 32;
+
+void C4GameObjects::AssignMainListOrder(C4ObjectLink *link)
+{
+	// Pick a key between the neighbours. Objects are mostly inserted behind the
+	// previously inserted one, so step forward from the predecessor if possible.
+	uint64_t lower = link->Prev ? link->Prev->Obj->MainListOrder : 0;
+	uint64_t upper = link->Next ? link->Next->Obj->MainListOrder : UINT64_MAX;
+	if (!link->Prev && !link->Next)
+		link->Obj->MainListOrder = uint64_t(1) << 62;
+	else if (upper - lower < 2)
+		RenumberMainListOrder();
+	else if (link->Prev)
+		link->Obj->MainListOrder = lower + std::min(MainListOrderStep, (upper - lower) / 2);
+	else
+		link->Obj->MainListOrder = upper - std::min(MainListOrderStep, (upper - lower) / 2);
+}
+
+void C4GameObjects::RenumberMainListOrder()
+{
+	// Keeps the relative order, so the indexes stay sorted
+	uint64_t order = uint64_t(1) << 62;
+	for (C4ObjectLink *link = First; link; link = link->Next, order += MainListOrderStep)
+		link->Obj->MainListOrder = order;
+}
+
+void C4GameObjects::AddToIndexes(C4ObjectLink *link)
+{
+	C4Object *object = link->Obj;
+	SetForeignPrototype(object, object->GetPrototype() != object->Def ? object->GetPrototype() : nullptr);
+	if (object->Def)
+	{
+		std::unique_ptr<C4SectorObjectList> &def_index = DefIndex[object->Def];
+		if (!def_index) def_index = std::make_unique<C4SectorObjectList>();
+		def_index->AddInMainListOrder(object);
+	}
+	uint32_t categories = object->Category;
+	for (int32_t bit = 0; categories; ++bit, categories >>= 1)
+		if (categories & 1)
+			CategoryIndex[bit].AddInMainListOrder(object);
+}
+
+void C4GameObjects::RemoveFromIndexes(C4Object *object, C4Def *def, int32_t category)
+{
+	SetForeignPrototype(object, nullptr);
+	auto def_index = DefIndex.find(def);
+	if (def_index != DefIndex.end())
+		def_index->second->Remove(object);
+	uint32_t categories = category;
+	for (int32_t bit = 0; categories; ++bit, categories >>= 1)
+		if (categories & 1)
+			CategoryIndex[bit].Remove(object);
+}
+
+void C4GameObjects::ClearIndexes()
+{
+	for (auto &def_index : DefIndex)
+		def_index.second->Clear();
+	for (C4SectorObjectList &category_index : CategoryIndex)
+		category_index.Clear();
+	ForeignPrototypes.clear();
+	ForeignPrototypeCounts.clear();
+}
+
+void C4GameObjects::RebuildIndexes()
+{
+	ClearIndexes();
+	RenumberMainListOrder();
+	for (C4ObjectLink *link = First; link; link = link->Next)
+	{
+		C4Object *object = link->Obj;
+		if (object->Def)
+		{
+			std::unique_ptr<C4SectorObjectList> &def_index = DefIndex[object->Def];
+			if (!def_index) def_index = std::make_unique<C4SectorObjectList>();
+			def_index->Append(object);
+		}
+		if (object->GetPrototype() != object->Def)
+			SetForeignPrototype(object, object->GetPrototype());
+		uint32_t categories = object->Category;
+		for (int32_t bit = 0; categories; ++bit, categories >>= 1)
+			if (categories & 1)
+				CategoryIndex[bit].Append(object);
+	}
+}
+
+void C4GameObjects::UpdateIndexes(C4Object *object, C4Def *old_def, int32_t old_category)
+{
+	// Only objects in the main list are indexed
+	C4ObjectLink *link = GetLink(object);
+	if (!link) return;
+	RemoveFromIndexes(object, old_def, old_category);
+	AddToIndexes(link);
+}
+
+void C4GameObjects::UpdatePrototype(C4Object *object)
+{
+	// Objects outside of the main list may be tracked as well. This only keeps queries from using the
+	// definition index until they are removed.
+	SetForeignPrototype(object, object->GetPrototype() != object->Def ? object->GetPrototype() : nullptr);
+	InvalidateQueries();
+}
+
+void C4GameObjects::SetForeignPrototype(C4Object *object, C4PropList *prototype)
+{
+	auto foreign = ForeignPrototypes.find(object);
+	if (foreign != ForeignPrototypes.end())
+	{
+		if (foreign->second == prototype) return;
+		auto count = ForeignPrototypeCounts.find(foreign->second);
+		if (!--count->second) ForeignPrototypeCounts.erase(count);
+		ForeignPrototypes.erase(foreign);
+	}
+	if (prototype)
+	{
+		ForeignPrototypes[object] = prototype;
+		++ForeignPrototypeCounts[prototype];
+	}
+}
+
+const C4SectorObjectList &C4GameObjects::GetDefObjects(C4Def *def) const
+{
+	static const C4SectorObjectList no_objects;
+	auto def_index = DefIndex.find(def);
+	return def_index != DefIndex.end() ? *def_index->second : no_objects;
+}
+
+const C4SectorObjectList &C4GameObjects::GetCategoryObjects(int32_t category_bit) const
+{
+	static const C4SectorObjectList no_objects;
+	const uint32_t category = category_bit;
+	assert(category && !(category & (category - 1)));
+	for (int32_t bit = 0; bit < 32; ++bit)
+		if (category & (1u << bit))
+			return CategoryIndex[bit];
+	return no_objects;
+}
+
+int C4GameObjects::ObjectCount(C4ID id) const
+{
+	if (id == C4ID::None) return C4ObjectList::ObjectCount();
+	C4Def *def = C4Id2Def(id);
+	return def ? GetDefObjects(def).ObjectCount() : 0;
+}
+
+C4Object* C4GameObjects::Find(C4Def * def, int owner, DWORD dwOCF)
+{
+	for (C4Object *object : GetDefObjects(def))
+		if (object->Status && (owner == ANY_OWNER || object->Owner == owner) && (dwOCF & object->OCF))
+			return object;
+	return nullptr;
+}
+
 void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 {
 	// Reverse area check: Checks for all <ball> at <goal>
@@ -111,7 +291,7 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 		{
 			uint32_t Marker = GetNextMarker();
 			C4LSector *sector;
-			for (C4ObjectList *in_goal_area = goal->Area.FirstObjects(&sector); in_goal_area; in_goal_area = goal->Area.NextObjects(in_goal_area, &sector))
+			for (C4SectorObjectList *in_goal_area = goal->Area.FirstObjects(&sector); in_goal_area; in_goal_area = goal->Area.NextObjects(in_goal_area, &sector))
 			{
 				for (C4Object* ball : *in_goal_area)
 				{
@@ -268,6 +448,7 @@ void C4GameObjects::Clear(bool clear_inactive_objects)
 		InactiveObjects.Clear();
 	}
 	LastUsedMarker = 0;
+	InvalidateQueries();
 }
 
 int C4GameObjects::PostLoad(bool keep_inactive_objects, C4ValueNumbers *numbers)
@@ -377,6 +558,8 @@ int C4GameObjects::PostLoad(bool keep_inactive_objects, C4ValueNumbers *numbers)
 
 	// Make sure list is sorted by category - after sorting out inactives, because inactives aren't sorted into the main list
 	FixObjectOrder();
+	// FixObjectOrder swaps objects between links
+	RebuildIndexes();
 
 	// Misc updates
 	for (C4Object *object : *this)
@@ -431,6 +614,7 @@ void C4GameObjects::UpdatePos(C4Object *object)
 {
 	// Position might have changed. Update sector lists
 	Sectors.Update(object, this);
+	InvalidateQueries();
 }
 
 void C4GameObjects::UpdatePosResort(C4Object *object)
@@ -438,6 +622,7 @@ void C4GameObjects::UpdatePosResort(C4Object *object)
 	// Object order for this object was changed. Readd object to sectors
 	Sectors.Remove(object);
 	Sectors.Add(object, this);
+	InvalidateQueries();
 }
 
 void C4GameObjects::FixObjectOrder()
@@ -22,6 +22,9 @@
 #include "object/C4ObjectList.h"
 #include "object/C4Sector.h"
 
+#include <memory>
+#include <unordered_map>
+
 // Main object list class
 class C4GameObjects : public C4NotifyingObjectList
 {
@@ -37,6 +40,25 @@ public:
 
 private:
 	uint32_t LastUsedMarker; // Last used value for C4Object::Marker
+	uint32_t QueryStateCounter{0}; // Incremented whenever cached FindObject results may become invalid
+
+	// Objects of the main list by definition and by category bit, in main list order
+	std::unordered_map<C4Def *, std::unique_ptr<C4SectorObjectList>> DefIndex;
+	C4SectorObjectList CategoryIndex[32];
+	// Objects whose prototype is not their definition, and their number per prototype
+	std::unordered_map<C4Object *, C4PropList *> ForeignPrototypes;
+	std::unordered_map<C4PropList *, int32_t> ForeignPrototypeCounts;
+	void SetForeignPrototype(C4Object *object, C4PropList *prototype);
+	void AssignMainListOrder(C4ObjectLink *link);
+	void RenumberMainListOrder();
+	void AddToIndexes(C4ObjectLink *link);
+	void RemoveFromIndexes(C4Object *object, C4Def *def, int32_t category);
+	void ClearIndexes();
+
+protected:
+	void InsertLinkBefore(C4ObjectLink *link, C4ObjectLink *before_link) override;
+	void InsertLink(C4ObjectLink *link, C4ObjectLink *after_link) override;
+	void RemoveLink(C4ObjectLink *link) override;
 
 public:
 	C4LSectors Sectors; // Section object lists
@@ -60,6 +82,16 @@ public:
 	void UpdateScriptPointers(); // Update pointers to C4AulScript *
 	C4Value GRBroadcast(const char *function_name, C4AulParSet *parameters, bool pass_error, bool reject_test);  // Call function in all goals/rules/environment objects
 
+	const C4SectorObjectList &GetDefObjects(C4Def *def) const; // All objects of the main list with this definition
+	const C4SectorObjectList &GetCategoryObjects(int32_t category_bit) const; // All objects of the main list with this category bit set
+	void UpdateIndexes(C4Object *game_object, C4Def *old_def, int32_t old_category); // Definition or category of an object changed
+	void UpdatePrototype(C4Object *game_object); // Prototype of an object changed
+	bool HasForeignPrototypes(C4PropList *prototype) const { return ForeignPrototypeCounts.count(prototype) > 0; } // Whether objects of other definitions have this prototype
+	void RebuildIndexes();
+	// Indexed versions of the C4ObjectList lookups, also used through C4ObjectList references
+	int ObjectCount(C4ID id=C4ID::None) const override;
+	C4Object* Find(C4Def * def, int owner = ANY_OWNER, DWORD dwOCF = OCF_All) override;
+
 	void UpdatePos(C4Object *game_object);
 	void UpdatePosResort(C4Object *game_object);
 
@@ -76,6 +108,9 @@ public:
 	void OnSynchronized();
 	void SetOCF();
 
+	void InvalidateQueries() { ++QueryStateCounter; } // Object existence, position, shape, definition, category or layer changed
+	uint32_t GetQueryStateCounter() const { return QueryStateCounter; }
+
 	uint32_t GetNextMarker(); // Get a new marker. If all markers are exceeded (LastUsedMarker is 0xffffffff), restart marker at 1 and reset all object markers to zero.
 };
 
@@ -23,6 +23,7 @@
 #include "landscape/C4Landscape.h"
 #include "landscape/C4SolidMask.h"
 #include "object/C4Def.h"
+#include "object/C4GameObjects.h"
 #include "object/C4Object.h"
 #include "script/C4Effect.h"
 
@@ -146,6 +147,7 @@ void C4Object::DoMotion(int32_t distance_x, int32_t distance_y)
 	RemoveSolidMask(true);
 	fix_x += distance_x;
 	fix_y += distance_y;
+	::Objects.InvalidateQueries();
 }
 
 void C4Object::StopAndContact(C4Real &contact_coordinate, C4Real limit, C4Real &speed, int32_t cnat)
@@ -461,6 +463,7 @@ void C4Object::DoMovement()
 		RemoveSolidMask(true);
 		fix_x = new_x;
 		fix_y = new_y;
+		::Objects.InvalidateQueries();
 	}
 	// Rotation  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 	if ((OCF & OCF_Rotate) && !!rdir)
@@ -529,6 +532,7 @@ void C4Object::DoMovement()
 				{
 					fix_x = itofix(current_x);
 					fix_y = itofix(current_y);
+					::Objects.InvalidateQueries();
 				}
 			}
 		}
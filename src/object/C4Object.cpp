@@ -94,6 +94,7 @@ void C4Object::Default()
 	Menu=nullptr;
 	MaterialContents=nullptr;
 	Marker=0;
+	MainListOrder=0;
 	ColorMod=0xffffffff;
 	BlitMode=0;
 	CrewDisabled=false;
@@ -279,6 +280,7 @@ void C4Object::AssignRemoval(bool exit_contents)
 	}
 
 	Status = C4OS_DELETED;
+	::Objects.InvalidateQueries();
 	// count decrease
 	Def->Count--;
 
@@ -347,6 +349,8 @@ void C4Object::UpdateShape(bool bUpdateVertices)
 		if (fix_r != Fix0)
 			Shape.Rotate(fix_r, bUpdateVertices);
 
+	// Cached FindObject results depend on the shape, also while the object is initializing
+	::Objects.InvalidateQueries();
 	// covered area changed? to be on the save side, update pos
 	UpdatePos();
 }
@@ -531,10 +535,13 @@ bool C4Object::ChangeDef(C4ID idNew)
 	if (pSolidMaskData) { delete pSolidMaskData; pSolidMaskData=nullptr; }
 	Def->Count--;
 	// Def change
+	C4Def *pOldDef=Def;
 	Def=pDef;
 	SetProperty(P_Prototype, C4VPropList(pDef));
 	id=pDef->id;
 	Def->Count++;
+	::Objects.UpdateIndexes(this, pOldDef, Category);
+	::Objects.InvalidateQueries();
 	// new def: Needs to be resorted
 	Unsorted=true;
 	// graphics change
@@ -652,6 +659,7 @@ void C4Object::DoCon(int32_t iChange, bool grow_from_center)
 	if (!grow_from_center)
 	{
 		fix_y = strgt_con_b - Shape.GetBottom();
+		::Objects.InvalidateQueries();
 	}
 	// Face (except for the shape)
 	UpdateFace(false);
@@ -1118,11 +1126,22 @@ void C4Object::SyncClearance()
 	}
 }
 
+void C4Object::SetCategory(int32_t iCategory)
+{
+	int32_t iOldCategory = Category;
+	Category = iCategory;
+	::Objects.UpdateIndexes(this, Def, iOldCategory);
+	Resort();
+	SetOCF();
+}
+
 void C4Object::Resort()
 {
 	// Flag resort
 	Unsorted=true;
 	Game.fResortAnyObject = true;
+	// Category or plane may have changed
+	::Objects.InvalidateQueries();
 	// Must not immediately resort - link change/removal would crash Game::ExecObjects
 }
 
@@ -1320,6 +1339,10 @@ void C4Object::SetPropertyByS(C4String * k, const C4Value & to)
 				if (!to.getInt()) throw C4AulExecError("invalid Plane 0");
 				SetPlane(to.getInt());
 				return;
+			case P_Prototype:
+				C4PropListNumbered::SetPropertyByS(k, to);
+				::Objects.UpdatePrototype(this);
+				return;
 		}
 	}
 	C4PropListNumbered::SetPropertyByS(k, to);
@@ -1334,6 +1357,10 @@ void C4Object::ResetProperty(C4String * k)
 			case P_Plane:
 				SetPlane(GetPropertyInt(P_Plane));
 				return;
+			case P_Prototype:
+				C4PropListNumbered::ResetProperty(k);
+				::Objects.UpdatePrototype(this);
+				return;
 		}
 	}
 	return C4PropListNumbered::ResetProperty(k);
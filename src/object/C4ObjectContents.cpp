@@ -24,6 +24,7 @@
 #include "game/C4Physics.h"
 #include "object/C4Def.h"
 #include "object/C4DefList.h"
+#include "object/C4GameObjects.h"
 #include "object/C4ObjectCom.h"
 #include "object/C4ObjectMenu.h"
 #include "platform/C4SoundSystem.h"
@@ -49,6 +50,7 @@ bool C4Object::Exit(int32_t iX, int32_t iY, int32_t iR, C4Real iXDir, C4Real iYD
 	fix_x=itofix(iX); fix_y=itofix(iY);
 	fix_r=itofix(iR);
 	BoundsCheck(fix_x, fix_y);
+	::Objects.InvalidateQueries();
 	xdir=iXDir; ydir=iYDir; rdir=iRDir;
 	// Misc updates
 	Mobile=true;
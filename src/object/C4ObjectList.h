@@ -133,14 +133,14 @@ public:
 
 	bool IsContained(const C4Object *obj) const;
 	int ClearPointers(C4Object *obj);
-	int ObjectCount(C4ID id=C4ID::None) const;
+	virtual int ObjectCount(C4ID id=C4ID::None) const;
 	int MassCount();
 	int ListIDCount(int32_t dwCategory) const;
 
 	C4Object* GetObject(int index = 0) const;
 	C4Object* GetFirstObject() const { return First ? First->Obj : nullptr; }
 	C4Object* GetLastObject() const { return Last ? Last->Obj : nullptr; }
-	C4Object* Find(C4Def * def, int owner = ANY_OWNER, DWORD dwOCF = OCF_All);
+	virtual C4Object* Find(C4Def * def, int owner = ANY_OWNER, DWORD dwOCF = OCF_All);
 	C4Object* FindOther(C4ID id, int owner = ANY_OWNER);
 
 	const C4ObjectLink* GetLink(const C4Object *obj) const;
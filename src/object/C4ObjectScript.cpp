@@ -28,6 +28,7 @@
 #include "lib/StdMeshMath.h"
 #include "object/C4Command.h"
 #include "object/C4DefList.h"
+#include "object/C4GameObjects.h"
 #include "object/C4MeshAnimation.h"
 #include "object/C4MeshDenumerator.h"
 #include "object/C4ObjectCom.h"
@@ -1966,6 +1967,7 @@ static void FnSetObjectLayer(C4Object *Obj, C4Object *pNewLayer)
 			contentObj->Layer = pNewLayer;
 		}
 	}
+	::Objects.InvalidateQueries();
 }
 
 static void FnSetShape(C4Object *Obj, long iX, long iY, long iWdt, long iHgt)
@@ -1976,6 +1978,7 @@ static void FnSetShape(C4Object *Obj, long iX, long iY, long iWdt, long iHgt)
 	Obj->Shape.Wdt = iWdt;
 	Obj->Shape.Hgt = iHgt;
 	// section list needs refresh
+	::Objects.InvalidateQueries();
 	Obj->UpdatePos();
 }
 
@@ -22,14 +22,164 @@
 #include "object/C4GameObjects.h"
 #include "object/C4Object.h"
 
+/* sector object list */
+
+C4SectorObjectList::iterator::iterator(const C4SectorObjectList &list, size_t pos):
+	List(list), Obj(pos < list.Objects.size() ? list.Objects[pos] : nullptr), NextPos(pos + 1)
+{
+	Next = List.FirstIter;
+	List.FirstIter = this;
+}
+
+C4SectorObjectList::iterator::iterator(const iterator &iter):
+	List(iter.List), Obj(iter.Obj), NextPos(iter.NextPos)
+{
+	Next = List.FirstIter;
+	List.FirstIter = this;
+}
+
+C4SectorObjectList::iterator::~iterator()
+{
+	// unregister; iterators are usually destroyed in reverse order of creation
+	iterator **ppIter = &List.FirstIter;
+	while (*ppIter != this) ppIter = &(*ppIter)->Next;
+	*ppIter = Next;
+}
+
+C4SectorObjectList::iterator &C4SectorObjectList::iterator::operator++ ()
+{
+	if (NextPos < List.Objects.size())
+		Obj = List.Objects[NextPos++];
+	else
+		Obj = nullptr;
+	return *this;
+}
+
+void C4SectorObjectList::Insert(size_t pos, C4Object *obj)
+{
+	Objects.insert(Objects.begin() + pos, obj);
+	// objects inserted at or before the current position of an iterator are not visited by it
+	for (iterator *it = FirstIter; it; it = it->Next)
+		if (pos < it->NextPos) ++it->NextPos;
+}
+
+void C4SectorObjectList::Erase(size_t pos)
+{
+	C4Object *obj = Objects[pos];
+	Objects.erase(Objects.begin() + pos);
+	for (iterator *it = FirstIter; it; it = it->Next)
+		if (pos < it->NextPos)
+		{
+			--it->NextPos;
+			if (it->Obj == obj) it->Obj = nullptr;
+		}
+}
+
+bool C4SectorObjectList::Add(C4Object *obj, const C4ObjectList *main_list)
+{
+	if (!obj || !obj->Def || !obj->Status) return false;
+	// Debug: don't do double links
+	assert(!IsContained(obj));
+	// Search insert position (default: end of list)
+	size_t pos = Objects.size();
+	if (!obj->Unsorted && main_list)
+	{
+		// Walk the main list in parallel with this list. The object goes behind
+		// the last sorted object of this list that precedes it in the main list.
+		auto skip = [this](size_t i) { while (i < Objects.size() && (!Objects[i]->Status || Objects[i]->Unsorted)) ++i; return i; };
+		size_t cur = skip(0);
+		pos = 0;
+		if (cur < Objects.size())
+			for (C4ObjectLink *link = main_list->First; link; link = link->Next)
+			{
+				C4Object *main_obj = link->Obj;
+				if (!main_obj->Status || main_obj->Unsorted) continue;
+				if (main_obj == obj) break;
+				if (main_obj == Objects[cur])
+				{
+					pos = cur + 1;
+					cur = skip(cur + 1);
+					if (cur >= Objects.size()) break;
+				}
+			}
+	}
+	Insert(pos, obj);
+	return true;
+}
+
+void C4SectorObjectList::AddInMainListOrder(C4Object *obj)
+{
+	assert(!IsContained(obj));
+	auto it = std::upper_bound(Objects.begin(), Objects.end(), obj,
+		[](const C4Object *a, const C4Object *b) { return a->MainListOrder < b->MainListOrder; });
+	Insert(it - Objects.begin(), obj);
+}
+
+bool C4SectorObjectList::Remove(C4Object *obj)
+{
+	auto it = std::find(Objects.begin(), Objects.end(), obj);
+	if (it == Objects.end()) return false;
+	Erase(it - Objects.begin());
+	return true;
+}
+
+void C4SectorObjectList::Clear()
+{
+	Objects.clear();
+	for (iterator *it = FirstIter; it; it = it->Next)
+	{
+		it->Obj = nullptr;
+		it->NextPos = 0;
+	}
+}
+
+bool C4SectorObjectList::IsContained(const C4Object *obj) const
+{
+	return std::find(Objects.begin(), Objects.end(), obj) != Objects.end();
+}
+
+int C4SectorObjectList::ObjectCount() const
+{
+	return std::count_if(Objects.begin(), Objects.end(), [](C4Object *obj) { return obj->Status != 0; });
+}
+
+bool C4SectorObjectList::CheckSort(const C4ObjectList *list) const
+{
+	const C4ObjectLink *compare_link = list->First;
+	for (C4Object *obj : Objects)
+	{
+		if (!obj->Status || obj->Unsorted) continue;
+		while (compare_link && compare_link->Obj != obj) compare_link = compare_link->Next;
+		if (!compare_link)
+		{
+			LogF("CheckSort failure: object %d in sector list is out of order", (int)obj->Number);
+			return false;
+		}
+	}
+	return true;
+}
+
+void C4SectorObjectList::CompileFunc(StdCompiler *pComp, C4ValueNumbers *numbers)
+{
+	// Sector lists are rebuilt from object positions, so they are only ever decompiled for debugging
+	assert(!pComp->isDeserializer());
+	if (pComp->isDeserializer()) return;
+	std::list<int32_t> enumerated;
+	for (C4Object *obj : Objects)
+		if (obj->Status)
+			enumerated.push_back(obj->Number);
+	pComp->Value(mkSTLContainerAdapt(enumerated, StdCompiler::SEP_SEP2));
+}
+
 /* sector */
 
-void C4LSector::Init(int ix, int iy)
+void C4LSector::Init(int ix, int iy, bool fCoarse)
 {
 	// clear any previous initialization
 	Clear();
 	// store class members
 	x=ix; y=iy;
+	Coarse=fCoarse;
 }
 
 void C4LSector::Clear()
@@ -60,15 +210,23 @@ void C4LSectors::Init(int iWdt, int iHgt)
 	// clear any previous initialization
 	Clear();
 	// store class members, calc size
-	Wdt = ((PxWdt=iWdt)-1)/C4LSectorWdt+1;
-	Hgt = ((PxHgt=iHgt)-1)/C4LSectorHgt+1;
+	PxWdt=iWdt; PxHgt=iHgt;
+	Wdt = (PxWdt+2*C4LSectorMarginX-1)/C4LSectorWdt+1;
+	Hgt = (PxHgt+2*C4LSectorMarginY-1)/C4LSectorHgt+1;
 	// create sectors
 	Sectors = new C4LSector[Size=Wdt*Hgt];
 	// init sectors
 	C4LSector *sct=Sectors;
 	for (int cnt=0; cnt<Size; cnt++, sct++)
-		sct->Init(cnt%Wdt, cnt/Wdt);
-	SectorOut.Init(-1,-1); // outpos at -1,-1 - MUST NOT intersect with an inside sector!
+		sct->Init(cnt%Wdt, cnt/Wdt, false);
+	// create coarse sectors
+	CoarseWdt = (Wdt-1)/C4LSectorCoarseFactor+1;
+	CoarseHgt = (Hgt-1)/C4LSectorCoarseFactor+1;
+	CoarseSectors = new C4LSector[CoarseSize=CoarseWdt*CoarseHgt];
+	sct=CoarseSectors;
+	for (int cnt=0; cnt<CoarseSize; cnt++, sct++)
+		sct->Init(cnt%CoarseWdt, cnt/CoarseWdt, true);
+	SectorOut.Init(-1,-1,false); // outpos at -1,-1 - MUST NOT intersect with an inside sector!
 }
 
 void C4LSectors::Clear()
@@ -77,30 +235,37 @@ void C4LSectors::Clear()
 	SectorOut.Clear();
 	// free sectors
 	delete [] Sectors; Sectors=nullptr;
+	delete [] CoarseSectors; CoarseSectors=nullptr;
 }
 
 C4LSector *C4LSectors::SectorAt(int ix, int iy)
 {
 	// check bounds
-	if (ix<0 || iy<0 || ix>=PxWdt || iy>=PxHgt)
+	ix += C4LSectorMarginX; iy += C4LSectorMarginY;
+	if (ix<0 || iy<0 || ix>=PxWdt+2*C4LSectorMarginX || iy>=PxHgt+2*C4LSectorMarginY)
 		return &SectorOut;
 	// get sector
 	return Sectors+(iy/C4LSectorHgt)*Wdt+(ix/C4LSectorWdt);
 }
 
+C4Rect C4LSectors::GetBounds() const
+{
+	return C4Rect(-C4LSectorMarginX, -C4LSectorMarginY, PxWdt+2*C4LSectorMarginX, PxHgt+2*C4LSectorMarginY);
+}
+
 void C4LSectors::Add(C4Object *pObj, C4ObjectList *pMainList)
 {
 	assert(Sectors);
 	// Add to owning sector
 	C4LSector *pSct = SectorAt(pObj->GetX(), pObj->GetY());
-	pSct->Objects.Add(pObj, C4ObjectList::stMain, pMainList);
+	pSct->Objects.Add(pObj, pMainList);
 	// Save position
 	pObj->old_x = pObj->GetX(); pObj->old_y = pObj->GetY();
 	// Add to all sectors in shape area
 	pObj->Area.Set(this, pObj);
 	for (pSct = pObj->Area.First(); pSct; pSct = pObj->Area.Next(pSct))
 	{
-		pSct->ObjectShapes.Add(pObj, C4ObjectList::stMain, pMainList);
+		pSct->ObjectShapes.Add(pObj, pMainList);
 	}
 	if (Config.General.DebugRec)
 		pObj->Area.DebugRec(pObj, 'A');
@@ -124,7 +289,7 @@ void C4LSectors::Update(C4Object *pObj, C4ObjectList *pMainList)
 		if (pOld != pNew)
 		{
 			pOld->Objects.Remove(pObj);
-			pNew->Objects.Add(pObj, C4ObjectList::stMain, pMainList);
+			pNew->Objects.Add(pObj, pMainList);
 		}
 		// Save position
 		pObj->old_x = pObj->GetX(); pObj->old_y = pObj->GetY();
@@ -140,7 +305,7 @@ void C4LSectors::Update(C4Object *pObj, C4ObjectList *pMainList)
 	for (pNew = NewArea.First(); pNew; pNew = NewArea.Next(pNew))
 		if (!pObj->Area.Contains(pNew))
 		{
-			pNew->ObjectShapes.Add(pObj, C4ObjectList::stMain, pMainList);
+			pNew->ObjectShapes.Add(pObj, pMainList);
 		}
 	// Update area
 	pObj->Area = NewArea;
@@ -191,6 +356,9 @@ void C4LSectors::AssertObjectNotInList(C4Object *pObj)
 		assert(!sct->Objects.IsContained(pObj));
 		assert(!sct->ObjectShapes.IsContained(pObj));
 	}
+	sct=CoarseSectors;
+	for (int cnt=0; cnt<CoarseSize; cnt++, sct++)
+		assert(!sct->ObjectShapes.IsContained(pObj));
 	assert(!SectorOut.Objects.IsContained(pObj));
 	assert(!SectorOut.ObjectShapes.IsContained(pObj));
 #endif
@@ -201,6 +369,8 @@ int C4LSectors::getShapeSum() const
 	int iSum = 0;
 	for (int cnt=0; cnt<Size; cnt++)
 		iSum += Sectors[cnt].ObjectShapes.ObjectCount();
+	for (int cnt=0; cnt<CoarseSize; cnt++)
+		iSum += CoarseSectors[cnt].ObjectShapes.ObjectCount();
 	return iSum;
 }
 
@@ -228,6 +398,10 @@ void C4LSectors::ClearObjects()
 	{
 		for (int cnt=0; cnt<Size; cnt++) Sectors[cnt].ClearObjects();
 	}
+	if (CoarseSectors)
+	{
+		for (int cnt=0; cnt<CoarseSize; cnt++) CoarseSectors[cnt].ClearObjects();
+	}
 	SectorOut.ClearObjects();
 }
 
@@ -238,16 +412,21 @@ bool C4LArea::operator == (const C4LArea &Area) const
 	return pFirst == Area.pFirst &&
 	       xL == Area.xL &&
 	       yL == Area.yL &&
+	       pFirstCoarse == Area.pFirstCoarse &&
+	       xLCoarse == Area.xLCoarse &&
+	       yLCoarse == Area.yLCoarse &&
+	       fShapesFine == Area.fShapesFine &&
 	       pOut == Area.pOut;
 }
 
-void C4LArea::Set(C4LSectors *pSectors, const C4Rect &Rect)
+void C4LArea::Set(C4LSectors *pSectors, const C4Rect &Rect, bool fObjectShape)
 {
 	// default: no area
-	pFirst=nullptr; pOut=nullptr;
+	pFirst=nullptr; pOut=nullptr; pFirstCoarse=nullptr; fShapesFine=true;
+	xLCoarse=yLCoarse=dpitchCoarse=0;
 	// check bounds
 	C4Rect ClippedRect(Rect),
-	Bounds(0, 0, pSectors->PxWdt, pSectors->PxHgt);
+	Bounds(pSectors->GetBounds());
 	ClippedRect.Normalize();
 	if (!Bounds.Contains(ClippedRect))
 	{
@@ -260,17 +439,39 @@ void C4LArea::Set(C4LSectors *pSectors, const C4Rect &Rect)
 	// (note this will associate areas that are above landscape bounds with sectors inside)
 	if (!ClippedRect.Wdt) ClippedRect.Wdt = 1;
 	if (!ClippedRect.Hgt) ClippedRect.Hgt = 1;
-	// calc bounds
-	xL = (ClippedRect.x + ClippedRect.Wdt - 1) / C4LSectorWdt;
-	yL = (ClippedRect.y + ClippedRect.Hgt - 1) / C4LSectorHgt;
+	// calc bounds in sector coordinates
+	int x0 = (ClippedRect.x - Bounds.x) / C4LSectorWdt;
+	int y0 = (ClippedRect.y - Bounds.y) / C4LSectorHgt;
+	xL = (ClippedRect.x - Bounds.x + ClippedRect.Wdt - 1) / C4LSectorWdt;
+	yL = (ClippedRect.y - Bounds.y + ClippedRect.Hgt - 1) / C4LSectorHgt;
 	// calc pitch
-	dpitch = pSectors->Wdt - (ClippedRect.x + ClippedRect.Wdt - 1) / C4LSectorWdt + ClippedRect.x / C4LSectorWdt;
+	dpitch = pSectors->Wdt - xL + x0;
+	// completely outside?
+	if (pFirst == pOut) return;
+	// large object shapes go into coarse sectors only; small ones into regular sectors only
+	if (fObjectShape)
+	{
+		if (xL - x0 < C4LSectorLargeShape && yL - y0 < C4LSectorLargeShape) return;
+		fShapesFine = false;
+	}
+	// calc coarse bounds
+	int cx0 = x0 / C4LSectorCoarseFactor, cy0 = y0 / C4LSectorCoarseFactor;
+	xLCoarse = xL / C4LSectorCoarseFactor;
+	yLCoarse = yL / C4LSectorCoarseFactor;
+	dpitchCoarse = pSectors->CoarseWdt - xLCoarse + cx0;
+	pFirstCoarse = pSectors->CoarseSectors + cy0 * pSectors->CoarseWdt + cx0;
 }
 
 void C4LArea::Set(C4LSectors *pSectors, C4Object *pObj)
 {
 	// set to object facet rect
-	Set(pSectors, C4Rect(pObj->Left(), pObj->Top(), pObj->Width(), pObj->Height()));
+	Set(pSectors, C4Rect(pObj->Left(), pObj->Top(), pObj->Width(), pObj->Height()), true);
+}
+
+C4LSector *C4LArea::First() const
+{
+	if (fShapesFine || !pFirst) return pFirst;
+	return pFirstCoarse ? pFirstCoarse : pOut;
 }
 
 C4LSector *C4LArea::Next(C4LSector *pPrev) const
@@ -278,13 +479,38 @@ C4LSector *C4LArea::Next(C4LSector *pPrev) const
 	// the outside-sector is the last sector that is returned
 	if (pPrev == pOut)
 		return nullptr;
-	// within one line?
+	if (!pPrev->Coarse)
+	{
+		// within one line?
+		if (pPrev->x<xL)
+			return pPrev+1;
+		// within the area?
+		if (pPrev->y<yL)
+			return pPrev+dpitch;
+		// continue with coarse sectors
+		if (pFirstCoarse)
+			return pFirstCoarse;
+	}
+	else
+	{
+		if (pPrev->x<xLCoarse)
+			return pPrev+1;
+		if (pPrev->y<yLCoarse)
+			return pPrev+dpitchCoarse;
+	}
+	// end reached - return outside-sector if applicable
+	return pOut;
+}
+
+C4LSector *C4LArea::NextFine(C4LSector *pPrev) const
+{
+	if (pPrev == pOut)
+		return nullptr;
+	assert(!pPrev->Coarse);
 	if (pPrev->x<xL)
 		return pPrev+1;
-	// within the area?
 	if (pPrev->y<yL)
 		return pPrev+dpitch;
-	// end reached - return outside-sector if applicable
 	return pOut;
 }
 
@@ -297,16 +523,18 @@ bool C4LArea::Contains(C4LSector *pSct) const
 	if (pSct == pOut) return true;
 	if (pFirst == pOut) return false;
 	// check bounds
-	return (pSct->x>=pFirst->x && pSct->y>=pFirst->y && pSct->x<=xL && pSct->y<=yL);
+	if (pSct->Coarse)
+		return pFirstCoarse && pSct->x>=pFirstCoarse->x && pSct->y>=pFirstCoarse->y && pSct->x<=xLCoarse && pSct->y<=yLCoarse;
+	return fShapesFine && pSct->x>=pFirst->x && pSct->y>=pFirst->y && pSct->x<=xL && pSct->y<=yL;
 }
 
-C4ObjectList *C4LArea::NextObjects(C4ObjectList *pPrev, C4LSector **ppSct)
+C4SectorObjectList *C4LArea::NextObjects(C4SectorObjectList *pPrev, C4LSector **ppSct)
 {
 	// get next sector
 	if (!*ppSct)
-		*ppSct = First();
+		*ppSct = pFirst;
 	else
-		*ppSct = Next(*ppSct);
+		*ppSct = NextFine(*ppSct);
 	// nothing left?
 	if (!*ppSct)
 		return nullptr;
@@ -314,13 +542,17 @@ C4ObjectList *C4LArea::NextObjects(C4ObjectList *pPrev, C4LSector **ppSct)
 	return &(*ppSct)->Objects;
 }
 
-C4ObjectList *C4LArea::NextObjectShapes(C4ObjectList *pPrev, C4LSector **ppSct)
+C4SectorObjectList *C4LArea::NextObjectShapes(C4SectorObjectList *pPrev, C4LSector **ppSct)
 {
-	// get next sector
-	if (!*ppSct)
-		*ppSct = First();
-	else
-		*ppSct = Next(*ppSct);
+	// get next sector; coarse sectors are usually empty and not worth visiting
+	do
+	{
+		if (!*ppSct)
+			*ppSct = First();
+		else
+			*ppSct = Next(*ppSct);
+	}
+	while (*ppSct && (*ppSct)->Coarse && (*ppSct)->ObjectShapes.IsEmpty());
 	// nothing left?
 	if (!*ppSct)
 		return nullptr;
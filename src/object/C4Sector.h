@@ -30,6 +30,71 @@ class C4LArea;
 // constants
 const int32_t C4LSectorWdt = 50,
                              C4LSectorHgt = 50;
+// sectors also cover this much space around the landscape, so objects slightly
+// outside (e.g. above the sky) do not all end up in the outside sector
+const int32_t C4LSectorMarginX = 10 * C4LSectorWdt,
+                             C4LSectorMarginY = 10 * C4LSectorHgt;
+// coarse sectors span this many sectors in each direction. Objects with shapes
+// spanning more than C4LSectorLargeShape sectors in any direction are put into
+// the shape lists of the coarse sectors instead of the regular ones.
+const int32_t C4LSectorCoarseFactor = 8,
+                             C4LSectorLargeShape = 4;
+
+// Contiguous object list for sectors and the object indexes of C4GameObjects.
+// Kept in the same order as the main object list, like a C4ObjectList added
+// to with stMain sorting.
+class C4SectorObjectList
+{
+public:
+	C4SectorObjectList() = default;
+	~C4SectorObjectList() { assert(!FirstIter); }
+	C4SectorObjectList(const C4SectorObjectList &) = delete;
+	C4SectorObjectList &operator=(const C4SectorObjectList &) = delete;
+
+	// An iterator which survives if objects are added to or removed from the list.
+	// Like C4ObjectList::iterator, it will visit objects inserted after the current
+	// position, and skip objects inserted before it.
+	class iterator
+	{
+	public:
+		iterator(const iterator &iter);
+		~iterator();
+		iterator &operator++ ();
+		C4Object *operator* () const { return Obj; }
+		bool operator== (const iterator &iter) const { return Obj == iter.Obj; }
+		bool operator!= (const iterator &iter) const { return Obj != iter.Obj; }
+		iterator &operator=(const iterator &iter) = delete;
+	private:
+		iterator(const C4SectorObjectList &list, size_t pos);
+		const C4SectorObjectList &List;
+		C4Object *Obj; // current object; nullptr at end or after its removal
+		size_t NextPos; // index of the object that ++ moves to
+		iterator *Next; // next iterator registered on the same list
+		friend class C4SectorObjectList;
+	};
+	iterator begin() const { return iterator(*this, 0); }
+	iterator end() const { return iterator(*this, Objects.size()); }
+
+	bool Add(C4Object *obj, const C4ObjectList *main_list); // insert at the position matching the order in main_list
+	void AddInMainListOrder(C4Object *obj); // insert by C4Object::MainListOrder
+	void Append(C4Object *obj) { Insert(Objects.size(), obj); }
+	bool Remove(C4Object *obj);
+	void Clear();
+
+	bool IsContained(const C4Object *obj) const;
+	bool IsEmpty() const { return Objects.empty(); }
+	size_t size() const { return Objects.size(); } // number of objects including deleted ones
+	int ObjectCount() const; // count objects with nonzero status
+	bool CheckSort(const C4ObjectList *list) const; // check that all objects of this list appear in the other list in the same order
+
+	void CompileFunc(StdCompiler *pComp, C4ValueNumbers *numbers); // decompile only
+
+private:
+	std::vector<C4Object *> Objects;
+	mutable iterator *FirstIter = nullptr;
+	void Insert(size_t pos, C4Object *obj);
+	void Erase(size_t pos);
+};
 
 // one of those object list sectors
 class C4LSector
@@ -39,14 +104,15 @@ public:
 	~C4LSector() { Clear(); } // destructor
 
 protected:
-	void Init(int ix, int iy);
+	void Init(int ix, int iy, bool fCoarse);
 	void Clear();
 
 public:
 	int x, y; // pos
+	bool Coarse; // part of the coarse sector grid?
 
-	C4ObjectList Objects; // objects within this sector
-	C4ObjectList ObjectShapes; // objects with shapes that overlap this sector
+	C4SectorObjectList Objects; // objects within this sector
+	C4SectorObjectList ObjectShapes; // objects with shapes that overlap this sector
 
 	void CompileFunc(StdCompiler *pComp, C4ValueNumbers * numbers);
 	void ClearObjects(); // remove all objects from object lists
@@ -62,12 +128,16 @@ public:
 	int PxWdt, PxHgt; // size in px
 	int Wdt, Hgt, Size; // sector count
 
+	C4LSector *CoarseSectors; // coarse sectors for large shapes
+	int CoarseWdt, CoarseHgt, CoarseSize; // coarse sector count
+
 	C4LSector SectorOut; // the sector "outside"
 
 public:
 	void Init(int Wdt, int Hgt); // init map sectors
 	void Clear(); // free map sectors
 	C4LSector *SectorAt(int ix, int iy); // get sector at pos
+	C4Rect GetBounds() const; // get area covered by sectors in px
 
 	void Add(C4Object *pObj, C4ObjectList *pMainList);
 	void Update(C4Object *pObj, C4ObjectList *pMainList); // does not update object order!
@@ -83,11 +153,19 @@ public:
 };
 
 // a defined sector-area within the map
+// An area consists of a range of regular sectors, optionally a range of coarse
+// sectors and optionally the outside sector. The Objects lists of an area are
+// those of the regular sectors; its ObjectShapes lists are those of the coarse
+// sectors plus those of the regular sectors unless the area is the shape of a
+// large object.
 class C4LArea
 {
 public:
 	C4LSector *pFirst;
 	int xL, yL, dpitch; // bounds / delta-pitch
+	C4LSector *pFirstCoarse; // first coarse sector; nullptr if none
+	int xLCoarse, yLCoarse, dpitchCoarse; // bounds / delta-pitch in coarse sectors
+	bool fShapesFine; // whether the shape lists of regular sectors are part of the area
 	C4LSector *pOut; // outside?
 
 	C4LArea() { Clear(); } // default constructor
@@ -99,29 +177,30 @@ public:
 	C4LArea(C4LSectors *pSectors, C4Object *pObj) // initializing constructor
 	{ Set(pSectors, pObj); }
 
-	inline void Clear() { pFirst=pOut=nullptr; } // zero sector
+	inline void Clear() { pFirst=pOut=pFirstCoarse=nullptr; fShapesFine=true; } // zero sector
 
 	bool operator == (const C4LArea &Area) const;
 
 	bool IsNull() const { return !pFirst; }
 
-	void Set(C4LSectors *pSectors, const C4Rect &rect); // set rect, calc bounds and get pitch
+	void Set(C4LSectors *pSectors, const C4Rect &rect, bool fObjectShape = false); // set rect, calc bounds and get pitch
 	void Set(C4LSectors *pSectors, C4Object *pObj); // set to object facet rect
 
-	C4LSector *First() const { return pFirst; } // get first sector
-	C4LSector *Next(C4LSector *pPrev) const; // get next sector within area
+	C4LSector *First() const; // get first sector whose shape list is part of the area
+	C4LSector *Next(C4LSector *pPrev) const; // get next sector whose shape list is part of the area
+	C4LSector *NextFine(C4LSector *pPrev) const; // get next regular or outside sector within area
 
 	// void MoveObject(C4Object *pObj, const C4LArea &toArea); // store object into new area
 
-	bool Contains(C4LSector *pSct) const; // return whether sector is contained in area
+	bool Contains(C4LSector *pSct) const; // return whether sector's shape list is part of the area
 
-	inline C4ObjectList *FirstObjects(C4LSector **ppSct) // get first object list of this area
+	inline C4SectorObjectList *FirstObjects(C4LSector **ppSct) // get first object list of this area
 	{ *ppSct=nullptr; return NextObjects(nullptr, ppSct); }
-	C4ObjectList *NextObjects(C4ObjectList *pPrev, C4LSector **ppSct); // get next object list of this area
+	C4SectorObjectList *NextObjects(C4SectorObjectList *pPrev, C4LSector **ppSct); // get next object list of this area
 
-	inline C4ObjectList *FirstObjectShapes(C4LSector **ppSct) // get first object shapes list of this area
+	inline C4SectorObjectList *FirstObjectShapes(C4LSector **ppSct) // get first object shapes list of this area
 	{ *ppSct=nullptr; return NextObjectShapes(nullptr, ppSct); }
-	C4ObjectList *NextObjectShapes(C4ObjectList *pPrev, C4LSector **ppSct); // get next object shapes list of this area
+	C4SectorObjectList *NextObjectShapes(C4SectorObjectList *pPrev, C4LSector **ppSct); // get next object shapes list of this area; skips empty coarse sectors
 
 	void DebugRec(class C4Object *pObj, char cMarker);
 };
@@ -55,10 +55,10 @@ bool C4SoundEffect::Load(const char *szFileName, C4Group &hGroup, const char *na
 	// Sound check
 	if (!Config.Sound.RXSound) return false;
 	// Locate sound in file
-	StdBuf WaveBuffer;
-	if (!hGroup.LoadEntry(szFileName, &WaveBuffer)) return false;
-	// load it from mem
-	if (!Load((BYTE*)WaveBuffer.getMData(), WaveBuffer.getSize())) return false;
+	C4GroupEntryView WaveBuffer;
+	if (!hGroup.LoadEntryView(szFileName, &WaveBuffer)) return false;
+	// load it from mem (the loaders only read the data)
+	if (!Load(const_cast<BYTE*>(WaveBuffer.getData()), WaveBuffer.getSize())) return false;
 	// Set name
 	if (namespace_prefix)
 	{
@@ -0,0 +1,119 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2019, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* A fixed set of worker threads processing batches of independent work items */
+
+#include "C4Include.h"
+#include "platform/C4ThreadPool.h"
+
+#include <thread>
+
+C4ThreadPool::C4ThreadPool(int32_t thread_count) : WorkEvent(true), DoneEvent(true)
+{
+	if (thread_count < 0) thread_count = GetDefaultThreadCount();
+	for (int32_t i = 0; i < thread_count; ++i)
+	{
+		auto worker = std::make_unique<Worker>(this);
+		if (!worker->Start()) break;
+		Workers.push_back(std::move(worker));
+	}
+}
+
+C4ThreadPool::~C4ThreadPool()
+{
+	Wait();
+	// wake up all workers so they notice the stop signal
+	for (auto &worker : Workers) worker->SignalStop();
+	{
+		CStdLock lock(&BatchLock);
+		Stopping = true;
+		WorkEvent.Set();
+	}
+	for (auto &worker : Workers) worker->Stop();
+}
+
+int32_t C4ThreadPool::GetDefaultThreadCount()
+{
+#if defined(HAVE_WINTHREAD) || defined(HAVE_PTHREAD)
+	// the thread that starts the batches helps in Wait()
+	return std::max<int32_t>(std::thread::hardware_concurrency(), 1) - 1;
+#else
+	return 0;
+#endif
+}
+
+void C4ThreadPool::Start(size_t count, WorkFunc work)
+{
+	CStdLock lock(&BatchLock);
+	assert(!PendingItems);
+	Work = std::move(work);
+	NextItem = 0;
+	ItemCount = PendingItems = count;
+	if (count)
+	{
+		DoneEvent.Reset();
+		WorkEvent.Set();
+	}
+	else
+	{
+		DoneEvent.Set();
+	}
+}
+
+void C4ThreadPool::Wait()
+{
+	ProcessItems();
+	{
+		CStdLock lock(&BatchLock);
+		if (!PendingItems) return;
+	}
+	DoneEvent.WaitFor(INFINITE);
+}
+
+bool C4ThreadPool::GrabItem(size_t *item)
+{
+	CStdLock lock(&BatchLock);
+	if (NextItem < ItemCount)
+	{
+		*item = NextItem++;
+		return true;
+	}
+	// nothing left to start: let workers sleep until the next batch
+	if (!Stopping) WorkEvent.Reset();
+	return false;
+}
+
+void C4ThreadPool::FinishItem()
+{
+	CStdLock lock(&BatchLock);
+	if (!--PendingItems) DoneEvent.Set();
+}
+
+void C4ThreadPool::ProcessItems()
+{
+	size_t item;
+	while (GrabItem(&item))
+	{
+		Work(item);
+		FinishItem();
+	}
+}
+
+void C4ThreadPool::Worker::Execute()
+{
+	Pool->WorkEvent.WaitFor(INFINITE);
+	if (IsStopSignaled()) return;
+	Pool->ProcessItems();
+}
@@ -0,0 +1,69 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2019, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* A fixed set of worker threads processing batches of independent work items */
+
+#ifndef INC_C4ThreadPool
+#define INC_C4ThreadPool
+
+#include "platform/StdScheduler.h"
+#include "platform/StdSync.h"
+
+#include <functional>
+
+class C4ThreadPool
+{
+public:
+	typedef std::function<void(size_t)> WorkFunc;
+
+	C4ThreadPool(int32_t thread_count = -1); // -1: one worker per additional processor core
+	~C4ThreadPool();
+
+	int32_t GetThreadCount() const { return Workers.size(); }
+	static int32_t GetDefaultThreadCount();
+
+	// Queue a batch: work(i) is called exactly once for every i < count, in ascending order of
+	// starting. Only one batch can be in progress.
+	void Start(size_t count, WorkFunc work);
+	// Wait until the batch is done. The calling thread processes remaining items itself,
+	// so batches also complete on platforms without threads.
+	void Wait();
+	void Run(size_t count, WorkFunc work) { Start(count, std::move(work)); Wait(); }
+
+private:
+	class Worker : public StdThread
+	{
+		C4ThreadPool *Pool;
+	public:
+		Worker(C4ThreadPool *pool) : Pool(pool) { }
+	protected:
+		void Execute() override;
+	};
+	friend class Worker;
+
+	std::vector<std::unique_ptr<Worker>> Workers;
+	CStdCSec BatchLock;
+	CStdEvent WorkEvent; // set while there are items to be started
+	CStdEvent DoneEvent; // set when all items of the batch are finished
+	WorkFunc Work;
+	size_t NextItem{0}, ItemCount{0}, PendingItems{0};
+	bool Stopping{false};
+
+	bool GrabItem(size_t *item);
+	void FinishItem();
+	void ProcessItems();
+};
+
+#endif // INC_C4ThreadPool
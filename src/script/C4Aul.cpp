@@ -95,6 +95,7 @@ void C4AulScriptEngine::Clear()
 	C4PropListStaticMember::Clear();
 	// reset values
 	warnCnt = errCnt = lineCnt = 0;
+	ScriptCache.ResetStatistics();
 	// resetting name lists will reset all data lists, too
 	// except not...
 	GlobalNamedNames.Reset();
@@ -18,12 +18,14 @@
 #define INC_C4Aul
 
 #include "object/C4Id.h"
+#include "script/C4AulScriptCache.h"
 #include "script/C4StringTable.h"
 #include "script/C4Value.h"
 #include "script/C4ValueMap.h"
 
 // consts
 #define C4AUL_MAX_Identifier  100 // max length of function identifiers
+#define C4AUL_TierUpThreshold 100 // default number of calls and loop iterations before a script function is tiered up
 
 // warning flags
 enum class C4AulWarningId
@@ -130,6 +132,8 @@ protected:
 public:
 	int warnCnt{0}, errCnt{0}; // number of warnings/errors
 	int lineCnt{0}; // line count parsed
+	C4AulScriptCache ScriptCache; // parsed scripts kept across engine starts
+	uint32_t TierUpThreshold{C4AUL_TierUpThreshold}; // calls and loop iterations after which a function gets specialized code; 0 to disable
 
 	C4ValueMapNames GlobalNamedNames;
 	C4ValueMapData GlobalNamed;
@@ -189,6 +189,7 @@ class C4AulCompiler::CodegenAstVisitor : public ::aul::DefaultRecursiveVisitor
 
 	int32_t stack_height = 0;
 	bool at_jump_target = false;
+	int last_jump_target = -1; // highest code position that may be a jump target
 
 	struct Loop
 	{
@@ -218,7 +219,42 @@ class C4AulCompiler::CodegenAstVisitor : public ::aul::DefaultRecursiveVisitor
 	
 	constexpr static bool IsJump(C4AulBCCType t)
 	{
-		return t == AB_JUMP || t == AB_JUMPAND || t == AB_JUMPOR || t == AB_JUMPNNIL || t == AB_CONDN || t == AB_COND;
+		return t == AB_JUMP || t == AB_JUMPAND || t == AB_JUMPOR || t == AB_JUMPNNIL || t == AB_CONDN || t == AB_COND ||
+			t == AB_LessThan_CONDN || t == AB_LessThanEqual_CONDN || t == AB_GreaterThan_CONDN ||
+			t == AB_GreaterThanEqual_CONDN || t == AB_Equal_CONDN || t == AB_NotEqual_CONDN;
+	}
+
+	// Superinstruction for an operator with a constant int right side. AB_EOFN if there is none.
+	static C4AulBCCType GetIntOperandCode(C4AulBCCType t)
+	{
+		switch (t)
+		{
+		case AB_Sum: return AB_Sum_INT;
+		case AB_Sub: return AB_Sub_INT;
+		case AB_Mul: return AB_Mul_INT;
+		case AB_LessThan: return AB_LessThan_INT;
+		case AB_LessThanEqual: return AB_LessThanEqual_INT;
+		case AB_GreaterThan: return AB_GreaterThan_INT;
+		case AB_GreaterThanEqual: return AB_GreaterThanEqual_INT;
+		case AB_Equal: return AB_Equal_INT;
+		case AB_NotEqual: return AB_NotEqual_INT;
+		default: return AB_EOFN;
+		}
+	}
+
+	// Superinstruction for a comparison followed by CONDN. AB_EOFN if there is none.
+	static C4AulBCCType GetCompareCondnCode(C4AulBCCType t)
+	{
+		switch (t)
+		{
+		case AB_LessThan: return AB_LessThan_CONDN;
+		case AB_LessThanEqual: return AB_LessThanEqual_CONDN;
+		case AB_GreaterThan: return AB_GreaterThan_CONDN;
+		case AB_GreaterThanEqual: return AB_GreaterThanEqual_CONDN;
+		case AB_Equal: return AB_Equal_CONDN;
+		case AB_NotEqual: return AB_NotEqual_CONDN;
+		default: return AB_EOFN;
+		}
 	}
 
 	int AddJumpTarget();
@@ -713,6 +749,13 @@ int C4AulCompiler::CodegenAstVisitor::GetStackValue(C4AulBCCType eType, intptr_t
 	case AB_DUP:
 	case AB_DUP_CONTEXT:
 	case AB_THIS:
+		// the tiered up instructions count like the first instruction of their sequence
+	case AB_THIS_PROP:
+	case AB_INT_ARRAYA:
+	case AB_DUP_Sum:
+	case AB_DUP_Sub:
+	case AB_DUP_LessThan_CONDN:
+	case AB_DUP_GreaterThan_CONDN:
 		return 1;
 
 	case AB_Pow:
@@ -745,6 +788,14 @@ int C4AulCompiler::CodegenAstVisitor::GetStackValue(C4AulBCCType eType, intptr_t
 	case AB_JUMPNNIL:
 		return -1;
 
+	case AB_LessThan_CONDN:
+	case AB_LessThanEqual_CONDN:
+	case AB_GreaterThan_CONDN:
+	case AB_GreaterThanEqual_CONDN:
+	case AB_Equal_CONDN:
+	case AB_NotEqual_CONDN:
+		return -2;
+
 	case AB_FUNC:
 		return -reinterpret_cast<C4AulFunc *>(X)->GetParCount() + 1;
 
@@ -767,6 +818,17 @@ int C4AulCompiler::CodegenAstVisitor::GetStackValue(C4AulBCCType eType, intptr_t
 	case AB_EOFN:
 	case AB_JUMP:
 	case AB_DEBUG:
+	case AB_STACK_Inc:
+	case AB_STACK_Dec:
+	case AB_Sum_INT:
+	case AB_Sub_INT:
+	case AB_Mul_INT:
+	case AB_LessThan_INT:
+	case AB_LessThanEqual_INT:
+	case AB_GreaterThan_INT:
+	case AB_GreaterThanEqual_INT:
+	case AB_Equal_INT:
+	case AB_NotEqual_INT:
 		return 0;
 
 	case AB_STACK:
@@ -854,6 +916,20 @@ int C4AulCompiler::CodegenAstVisitor::AddBCC(const char *TokenSPos, C4AulBCCType
 		if (eType == AB_STACK && X == -1 && pCPos1->bccType == AB_STACK_SET)
 		{
 			pCPos1->bccType = AB_POP_TO;
+			// Join DUP + Inc/Dec + POP_TO of the same slot to STACK_Inc/STACK_Dec
+			if (Fn->GetCodePos() >= 3)
+			{
+				// Neither the Inc/Dec nor the POP_TO may be jumped to, as both are removed
+				C4AulBCC *pChange = pCPos1 - 1, *pDup = pCPos1 - 2;
+				if (last_jump_target < Fn->GetCodePos() - 2 &&
+					(pChange->bccType == AB_Inc || pChange->bccType == AB_Dec) && !pChange->Par.X &&
+					pDup->bccType == AB_DUP && pDup->Par.i == pCPos1->Par.i + 1)
+				{
+					pDup->bccType = pChange->bccType == AB_Inc ? AB_STACK_Inc : AB_STACK_Dec;
+					Fn->RemoveLastBCC();
+					Fn->RemoveLastBCC();
+				}
+			}
 			return Fn->GetCodePos() - 1;
 		}
 
@@ -885,6 +961,21 @@ int C4AulCompiler::CodegenAstVisitor::AddBCC(const char *TokenSPos, C4AulBCCType
 			return Fn->GetCodePos() - 1;
 		}
 
+		// Join INT + operator to an operator with constant right side
+		if (pCPos1->bccType == AB_INT && GetIntOperandCode(eType) != AB_EOFN)
+		{
+			pCPos1->bccType = GetIntOperandCode(eType);
+			return Fn->GetCodePos() - 1;
+		}
+
+		// Join comparison + CONDN to a conditional jump on the comparison
+		if (eType == AB_CONDN && GetCompareCondnCode(pCPos1->bccType) != AB_EOFN)
+		{
+			pCPos1->bccType = GetCompareCondnCode(pCPos1->bccType);
+			pCPos1->Par.i = X + 1;
+			return Fn->GetCodePos() - 1;
+		}
+
 		// Join AB_STRING + AB_ARRAYA to AB_PROP
 		if (eType == AB_ARRAYA && pCPos1->bccType == AB_STRING)
 		{
@@ -988,6 +1079,7 @@ int C4AulCompiler::CodegenAstVisitor::AddJumpTarget()
 		throw C4AulParseError(host, "internal error: jump target outside of function");
 
 	at_jump_target = true;
+	last_jump_target = std::max(last_jump_target, Fn->GetCodePos());
 	return Fn->GetCodePos();
 }
 
@@ -1188,10 +1280,75 @@ void C4AulCompiler::CodegenAstVisitor::visit(const ::aul::ast::VarExpr *n)
 	}
 }
 
+// Evaluates int operators on int literals at compile time. Operations that
+// fail or are undefined at runtime are left alone to keep their behaviour.
+static bool FoldIntConstant(const ::aul::ast::Expr *n, int32_t &result)
+{
+	if (auto lit = dynamic_cast<const ::aul::ast::IntLit *>(n))
+	{
+		result = static_cast<int32_t>(lit->value);
+		return true;
+	}
+	if (auto unop = dynamic_cast<const ::aul::ast::UnOpExpr *>(n))
+	{
+		const auto &op = C4ScriptOpMap[unop->op];
+		int32_t operand;
+		if (op.Changer || !FoldIntConstant(unop->operand.get(), operand))
+			return false;
+		switch (op.Code)
+		{
+		case AB_Neg: result = static_cast<int32_t>(0u - static_cast<uint32_t>(operand)); return true;
+		case AB_BitNot: result = ~operand; return true;
+		default: return false;
+		}
+	}
+	if (auto binop = dynamic_cast<const ::aul::ast::BinOpExpr *>(n))
+	{
+		const auto &op = C4ScriptOpMap[binop->op];
+		int32_t lhs, rhs;
+		if (op.Changer || !FoldIntConstant(binop->lhs.get(), lhs) || !FoldIntConstant(binop->rhs.get(), rhs))
+			return false;
+		// Wrap around on overflow like the runtime does
+		const uint32_t ulhs = static_cast<uint32_t>(lhs), urhs = static_cast<uint32_t>(rhs);
+		switch (op.Code)
+		{
+		case AB_Sum: result = static_cast<int32_t>(ulhs + urhs); return true;
+		case AB_Sub: result = static_cast<int32_t>(ulhs - urhs); return true;
+		case AB_Mul: result = static_cast<int32_t>(ulhs * urhs); return true;
+		case AB_Pow: result = Pow(lhs, rhs); return true;
+		case AB_Div:
+			if (!rhs || (lhs == INT32_MIN && rhs == -1)) return false;
+			result = lhs / rhs; return true;
+		case AB_Mod:
+			if (!rhs || (lhs == INT32_MIN && rhs == -1)) return false;
+			result = lhs % rhs; return true;
+		case AB_LeftShift:
+			if (rhs < 0 || rhs >= 32) return false;
+			result = static_cast<int32_t>(ulhs << rhs); return true;
+		case AB_RightShift:
+			if (rhs < 0 || rhs >= 32) return false;
+			result = lhs >> rhs; return true;
+		case AB_BitAnd: result = lhs & rhs; return true;
+		case AB_BitXOr: result = lhs ^ rhs; return true;
+		case AB_BitOr: result = lhs | rhs; return true;
+		default: return false;
+		}
+	}
+	return false;
+}
+
 void C4AulCompiler::CodegenAstVisitor::visit(const ::aul::ast::UnOpExpr *n)
 {
 	StackGuard g(this, 1);
 
+	int32_t value;
+	if (FoldIntConstant(n, value))
+	{
+		AddBCC(n->loc, AB_INT, value);
+		type_of_stack_top = C4V_Int;
+		return;
+	}
+
 	n->operand->accept(this);
 	const auto &op = C4ScriptOpMap[n->op];
 	if (op.Changer)
@@ -1215,6 +1372,14 @@ void C4AulCompiler::CodegenAstVisitor::visit(const ::aul::ast::UnOpExpr *n)
 void C4AulCompiler::CodegenAstVisitor::visit(const ::aul::ast::BinOpExpr *n)
 {
 	StackGuard g(this, 1);
+
+	int32_t value;
+	if (FoldIntConstant(n, value))
+	{
+		AddBCC(n->loc, AB_INT, value);
+		type_of_stack_top = C4V_Int;
+		return;
+	}
 	
 	SafeVisit(n->lhs);
 
@@ -1601,6 +1766,7 @@ void C4AulCompiler::CodegenAstVisitor::EmitFunctionCode(const ::aul::ast::Functi
 	assert(scopes.empty());
 
 	Fn->ClearCode();
+	last_jump_target = -1;
 
 	// Reserve var stack space
 	if (Fn->VarNamed.iSize > 0)
@@ -28,6 +28,22 @@
 
 C4AulExec AulExec;
 
+// Every handler in Exec ends by moving pCPos to the next bytecode with AUL_NEXT,
+// or to a jump target with AUL_JUMP. With USE_AUL_COMPUTED_GOTO, these macros
+// jump straight to the handler of the new bytecode through a table of label
+// addresses, a GCC extension that Clang supports as well. Otherwise, they
+// continue the loop around the switch statement.
+#if defined(USE_AUL_COMPUTED_GOTO) && defined(__GNUC__)
+#define AUL_COMPUTED_GOTO
+#define AUL_OP(type) case type: handle_##type
+#define AUL_DISPATCH goto *Handlers[pCPos->bccType]
+#else
+#define AUL_OP(type) case type
+#define AUL_DISPATCH continue
+#endif
+#define AUL_JUMP(pos) { pCPos = (pos); AUL_DISPATCH; }
+#define AUL_NEXT AUL_JUMP(pCPos + 1)
+
 C4AulExecError::C4AulExecError(const char *szError)
 {
 	assert(szError);
@@ -165,6 +181,7 @@ C4Value C4AulExec::Exec(C4AulScriptFunc *pSFunc, C4PropList * p, C4Value *pnPars
 		PushContext(ctx);
 
 		// Execute
+		pSFunc->CountExec(::ScriptEngine.TierUpThreshold);
 		return Exec(pSFunc->GetCode());
 	}
 	catch (C4AulError &e)
@@ -192,88 +209,191 @@ C4Value C4AulExec::Exec(C4AulScriptFunc *pSFunc, C4PropList * p, C4Value *pnPars
 
 C4Value C4AulExec::Exec(C4AulBCC *pCPos)
 {
+#ifdef AUL_COMPUTED_GOTO
+	// Handler of every bytecode type. Types without a handler label go through the switch.
+	static void *Handlers[AB_EOFN + 1];
+	static bool fHandlersSet = false;
+	if (!fHandlersSet)
+	{
+		for (auto &pHandler : Handlers)
+			pHandler = &&dispatch_switch;
+#define AUL_HANDLER(type) Handlers[type] = &&handle_##type
+		AUL_HANDLER(AB_ARRAYA);
+		AUL_HANDLER(AB_ARRAYA_SET);
+		AUL_HANDLER(AB_PROP);
+		AUL_HANDLER(AB_PROP_SET);
+		AUL_HANDLER(AB_ARRAY_SLICE);
+		AUL_HANDLER(AB_ARRAY_SLICE_SET);
+		AUL_HANDLER(AB_DUP);
+		AUL_HANDLER(AB_DUP_CONTEXT);
+		AUL_HANDLER(AB_STACK_SET);
+		AUL_HANDLER(AB_POP_TO);
+		AUL_HANDLER(AB_LOCALN);
+		AUL_HANDLER(AB_LOCALN_SET);
+		AUL_HANDLER(AB_GLOBALN);
+		AUL_HANDLER(AB_GLOBALN_SET);
+		AUL_HANDLER(AB_PAR);
+		AUL_HANDLER(AB_THIS);
+		AUL_HANDLER(AB_FUNC);
+		AUL_HANDLER(AB_Inc);
+		AUL_HANDLER(AB_Dec);
+		AUL_HANDLER(AB_BitNot);
+		AUL_HANDLER(AB_Not);
+		AUL_HANDLER(AB_Neg);
+		AUL_HANDLER(AB_Pow);
+		AUL_HANDLER(AB_Div);
+		AUL_HANDLER(AB_Mul);
+		AUL_HANDLER(AB_Mod);
+		AUL_HANDLER(AB_Sub);
+		AUL_HANDLER(AB_Sum);
+		AUL_HANDLER(AB_LeftShift);
+		AUL_HANDLER(AB_RightShift);
+		AUL_HANDLER(AB_LessThan);
+		AUL_HANDLER(AB_LessThanEqual);
+		AUL_HANDLER(AB_GreaterThan);
+		AUL_HANDLER(AB_GreaterThanEqual);
+		AUL_HANDLER(AB_Equal);
+		AUL_HANDLER(AB_NotEqual);
+		AUL_HANDLER(AB_BitAnd);
+		AUL_HANDLER(AB_BitXOr);
+		AUL_HANDLER(AB_BitOr);
+		AUL_HANDLER(AB_STACK_Inc);
+		AUL_HANDLER(AB_STACK_Dec);
+		AUL_HANDLER(AB_Sum_INT);
+		AUL_HANDLER(AB_Sub_INT);
+		AUL_HANDLER(AB_Mul_INT);
+		AUL_HANDLER(AB_LessThan_INT);
+		AUL_HANDLER(AB_LessThanEqual_INT);
+		AUL_HANDLER(AB_GreaterThan_INT);
+		AUL_HANDLER(AB_GreaterThanEqual_INT);
+		AUL_HANDLER(AB_Equal_INT);
+		AUL_HANDLER(AB_NotEqual_INT);
+		AUL_HANDLER(AB_LessThan_CONDN);
+		AUL_HANDLER(AB_LessThanEqual_CONDN);
+		AUL_HANDLER(AB_GreaterThan_CONDN);
+		AUL_HANDLER(AB_GreaterThanEqual_CONDN);
+		AUL_HANDLER(AB_Equal_CONDN);
+		AUL_HANDLER(AB_NotEqual_CONDN);
+		AUL_HANDLER(AB_THIS_PROP);
+		AUL_HANDLER(AB_INT_ARRAYA);
+		AUL_HANDLER(AB_DUP_Sum);
+		AUL_HANDLER(AB_DUP_Sub);
+		AUL_HANDLER(AB_DUP_LessThan_CONDN);
+		AUL_HANDLER(AB_DUP_GreaterThan_CONDN);
+		AUL_HANDLER(AB_CALL);
+		AUL_HANDLER(AB_CALLFS);
+		AUL_HANDLER(AB_STACK);
+		AUL_HANDLER(AB_INT);
+		AUL_HANDLER(AB_BOOL);
+		AUL_HANDLER(AB_STRING);
+		AUL_HANDLER(AB_CPROPLIST);
+		AUL_HANDLER(AB_CARRAY);
+		AUL_HANDLER(AB_CFUNCTION);
+		AUL_HANDLER(AB_NIL);
+		AUL_HANDLER(AB_NEW_ARRAY);
+		AUL_HANDLER(AB_NEW_PROPLIST);
+		AUL_HANDLER(AB_JUMP);
+		AUL_HANDLER(AB_JUMPAND);
+		AUL_HANDLER(AB_JUMPOR);
+		AUL_HANDLER(AB_JUMPNNIL);
+		AUL_HANDLER(AB_CONDN);
+		AUL_HANDLER(AB_COND);
+		AUL_HANDLER(AB_FOREACH_NEXT);
+		AUL_HANDLER(AB_RETURN);
+		AUL_HANDLER(AB_ERR);
+		AUL_HANDLER(AB_DEBUG);
+		AUL_HANDLER(AB_EOFN);
+#undef AUL_HANDLER
+		fHandlersSet = true;
+	}
+#endif
+
 	try
 	{
 
 		for (;;)
 		{
 
-			bool fJump = false;
+#ifdef AUL_COMPUTED_GOTO
+			// Enter the first handler; from there on, each handler dispatches the next one
+			AUL_DISPATCH;
+dispatch_switch:
+#endif
 			switch (pCPos->bccType)
 			{
-			case AB_INT:
+			AUL_OP(AB_INT):
 				PushInt(pCPos->Par.i);
-				break;
+				AUL_NEXT;
 
-			case AB_BOOL:
+			AUL_OP(AB_BOOL):
 				PushBool(!!pCPos->Par.i);
-				break;
+				AUL_NEXT;
 
-			case AB_STRING:
+			AUL_OP(AB_STRING):
 				PushString(pCPos->Par.s);
-				break;
+				AUL_NEXT;
 
-			case AB_CPROPLIST:
+			AUL_OP(AB_CPROPLIST):
 				PushPropList(pCPos->Par.p);
-				break;
+				AUL_NEXT;
 
-			case AB_CARRAY:
+			AUL_OP(AB_CARRAY):
 				PushArray(pCPos->Par.a);
-				break;
+				AUL_NEXT;
 
-			case AB_CFUNCTION:
+			AUL_OP(AB_CFUNCTION):
 				PushFunction(pCPos->Par.f);
-				break;
+				AUL_NEXT;
 
-			case AB_NIL:
+			AUL_OP(AB_NIL):
 				PushValue(C4VNull);
-				break;
+				AUL_NEXT;
 
-			case AB_DUP:
+			AUL_OP(AB_DUP):
 				PushValue(pCurVal[pCPos->Par.i]);
-				break;
-			case AB_STACK_SET:
+				AUL_NEXT;
+			AUL_OP(AB_STACK_SET):
 				pCurVal[pCPos->Par.i] = pCurVal[0];
-				break;
-			case AB_POP_TO:
+				AUL_NEXT;
+			AUL_OP(AB_POP_TO):
 				pCurVal[pCPos->Par.i] = pCurVal[0];
 				PopValue();
-				break;
+				AUL_NEXT;
 
-			case AB_EOFN:
+			AUL_OP(AB_EOFN):
 				throw C4AulExecError("internal error: function didn't return");
 
-			case AB_ERR:
+			AUL_OP(AB_ERR):
 				if (pCPos->Par.s)
 					throw C4AulExecError((std::string("syntax error: ") + pCPos->Par.s->GetCStr()).c_str());
 				else
 					throw C4AulExecError("syntax error: see above for details");
 
-			case AB_DUP_CONTEXT:
+			AUL_OP(AB_DUP_CONTEXT):
 				PushValue(AulExec.GetContext(AulExec.GetContextDepth()-2)->Pars[pCPos->Par.i]);
-				break;
+				AUL_NEXT;
 
-			case AB_LOCALN:
+			AUL_OP(AB_LOCALN):
 				if (!pCurCtx->Obj)
 					throw C4AulExecError("can't access local variables without this");
 				PushNullVals(1);
-				pCurCtx->Obj->GetPropertyByS(pCPos->Par.s, pCurVal);
-				break;
-			case AB_LOCALN_SET:
+				pCurCtx->Obj->GetPropertyByS(pCPos->Par.s, pCurVal, pCurCtx->Func->GetLookupCache(pCPos));
+				AUL_NEXT;
+			AUL_OP(AB_LOCALN_SET):
 				if (!pCurCtx->Obj)
 					throw C4AulExecError("can't access local variables without this");
 				if (pCurCtx->Obj->IsFrozen())
 					throw C4AulExecError("local variable: this is readonly");
 				pCurCtx->Obj->SetPropertyByS(pCPos->Par.s, pCurVal[0]);
-				break;
+				AUL_NEXT;
 
-			case AB_PROP:
+			AUL_OP(AB_PROP):
 				if (!pCurVal->CheckConversion(C4V_PropList))
 					throw C4AulExecError(FormatString("proplist access: proplist expected, got %s", pCurVal->GetTypeName()).getData());
-				if (!pCurVal->_getPropList()->GetPropertyByS(pCPos->Par.s, pCurVal))
+				if (!pCurVal->_getPropList()->GetPropertyByS(pCPos->Par.s, pCurVal, pCurCtx->Func->GetLookupCache(pCPos)))
 					pCurVal->Set0();
-				break;
-			case AB_PROP_SET:
+				AUL_NEXT;
+			AUL_OP(AB_PROP_SET):
 			{
 				C4Value *pPropList = pCurVal - 1;
 				if (!pPropList->CheckConversion(C4V_PropList))
@@ -283,46 +403,46 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos)
 				pPropList->_getPropList()->SetPropertyByS(pCPos->Par.s, pCurVal[0]);
 				pPropList->Set(pCurVal[0]);
 				PopValue();
-				break;
+				AUL_NEXT;
 			}
 
-			case AB_GLOBALN:
+			AUL_OP(AB_GLOBALN):
 				PushValue(*::ScriptEngine.GlobalNamed.GetItem(pCPos->Par.i));
-				break;
-			case AB_GLOBALN_SET:
+				AUL_NEXT;
+			AUL_OP(AB_GLOBALN_SET):
 				::ScriptEngine.GlobalNamed.GetItem(pCPos->Par.i)->Set(pCurVal[0]);
-				break;
+				AUL_NEXT;
 				
 			// prefix
-			case AB_BitNot: // ~
+			AUL_OP(AB_BitNot): // ~
 				CheckOpPar(C4V_Int, "~");
 				pCurVal->SetInt(~pCurVal->_getInt());
-				break;
-			case AB_Not:  // !
+				AUL_NEXT;
+			AUL_OP(AB_Not):  // !
 				pCurVal->SetBool(!pCurVal->getBool());
-				break;
-			case AB_Neg:  // -
+				AUL_NEXT;
+			AUL_OP(AB_Neg):  // -
 				CheckOpPar(C4V_Int, "-");
 				pCurVal->SetInt(-pCurVal->_getInt());
-				break;
-			case AB_Inc: // ++
+				AUL_NEXT;
+			AUL_OP(AB_Inc): // ++
 				CheckOpPar(C4V_Int, "++");
 				pCurVal->SetInt(pCurVal->_getInt() + 1);
-				break;
-			case AB_Dec: // --
+				AUL_NEXT;
+			AUL_OP(AB_Dec): // --
 				CheckOpPar(C4V_Int, "--");
 				pCurVal->SetInt(pCurVal->_getInt() - 1);
-				break;
+				AUL_NEXT;
 			// postfix
-			case AB_Pow:  // **
+			AUL_OP(AB_Pow):  // **
 			{
 				CheckOpPars(C4V_Int, C4V_Int, "**");
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(Pow(pPar1->_getInt(), pPar2->_getInt()));
 				PopValue();
-				break;
+				AUL_NEXT;
 			}
-			case AB_Div:  // /
+			AUL_OP(AB_Div):  // /
 			{
 				CheckOpPars(C4V_Int, C4V_Int, "/");
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -333,17 +453,17 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos)
 					throw C4AulExecError("division overflow");
 				pPar1->SetInt(pPar1->_getInt() / pPar2->_getInt());
 				PopValue();
-				break;
+				AUL_NEXT;
 			}
-			case AB_Mul:  // *
+			AUL_OP(AB_Mul):  // *
 			{
 				CheckOpPars(C4V_Int, C4V_Int, "*");
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() * pPar2->_getInt());
 				PopValue();
-				break;
+				AUL_NEXT;
 			}
-			case AB_Mod:  // %
+			AUL_OP(AB_Mod):  // %
 			{
 				CheckOpPars(C4V_Int, C4V_Int, "%");
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -355,112 +475,275 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos)
 				else
 					pPar1->Set0();
 				PopValue();
-				break;
+				AUL_NEXT;
 			}
-			case AB_Sub:  // -
+			AUL_OP(AB_Sub):  // -
 			{
 				CheckOpPars(C4V_Int, C4V_Int, "-");
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() - pPar2->_getInt());
 				PopValue();
-				break;
+				AUL_NEXT;
 			}
-			case AB_Sum:  // +
+			AUL_OP(AB_Sum):  // +
 			{
 				CheckOpPars(C4V_Int, C4V_Int, "+");
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() + pPar2->_getInt());
 				PopValue();
-				break;
+				AUL_NEXT;
 			}
-			case AB_LeftShift:  // <<
+			AUL_OP(AB_LeftShift):  // <<
 			{
 				CheckOpPars(C4V_Int, C4V_Int, "<<");
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() << pPar2->_getInt());
 				PopValue();
-				break;
+				AUL_NEXT;
 			}
-			case AB_RightShift: // >>
+			AUL_OP(AB_RightShift): // >>
 			{
 				CheckOpPars(C4V_Int, C4V_Int, ">>");
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() >> pPar2->_getInt());
 				PopValue();
-				break;
+				AUL_NEXT;
 			}
-			case AB_LessThan: // <
+			AUL_OP(AB_LessThan): // <
 			{
 				CheckOpPars(C4V_Int, C4V_Int, "<");
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getInt() < pPar2->_getInt());
 				PopValue();
-				break;
+				AUL_NEXT;
 			}
-			case AB_LessThanEqual:  // <=
+			AUL_OP(AB_LessThanEqual):  // <=
 			{
 				CheckOpPars(C4V_Int, C4V_Int, "<=");
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getInt() <= pPar2->_getInt());
 				PopValue();
-				break;
+				AUL_NEXT;
 			}
-			case AB_GreaterThan:  // >
+			AUL_OP(AB_GreaterThan):  // >
 			{
 				CheckOpPars(C4V_Int, C4V_Int, ">");
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getInt() > pPar2->_getInt());
 				PopValue();
-				break;
+				AUL_NEXT;
 			}
-			case AB_GreaterThanEqual: // >=
+			AUL_OP(AB_GreaterThanEqual): // >=
 			{
 				CheckOpPars(C4V_Int, C4V_Int, ">=");
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getInt() >= pPar2->_getInt());
 				PopValue();
-				break;
+				AUL_NEXT;
 			}
-			case AB_Equal:  // ==
+			AUL_OP(AB_Equal):  // ==
 			{
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->IsIdenticalTo(*pPar2));
 				PopValue();
-				break;
+				AUL_NEXT;
 			}
-			case AB_NotEqual: // !=
+			AUL_OP(AB_NotEqual): // !=
 			{
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(!pPar1->IsIdenticalTo(*pPar2));
 				PopValue();
-				break;
+				AUL_NEXT;
 			}
-			case AB_BitAnd: // &
+			AUL_OP(AB_BitAnd): // &
 			{
 				CheckOpPars(C4V_Int, C4V_Int, "&");
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() & pPar2->_getInt());
 				PopValue();
-				break;
+				AUL_NEXT;
 			}
-			case AB_BitXOr: // ^
+			AUL_OP(AB_BitXOr): // ^
 			{
 				CheckOpPars(C4V_Int, C4V_Int, "^");
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() ^ pPar2->_getInt());
 				PopValue();
-				break;
+				AUL_NEXT;
 			}
-			case AB_BitOr:  // |
+			AUL_OP(AB_BitOr):  // |
 			{
 				CheckOpPars(C4V_Int, C4V_Int, "|");
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() | pPar2->_getInt());
 				PopValue();
-				break;
+				AUL_NEXT;
 			}
 
-			case AB_NEW_ARRAY:
+			AUL_OP(AB_STACK_Inc): // ++ on a variable
+				CheckOpPar(C4V_Int, "++", &pCurVal[pCPos->Par.i]);
+				pCurVal[pCPos->Par.i].SetInt(pCurVal[pCPos->Par.i]._getInt() + 1);
+				AUL_NEXT;
+			AUL_OP(AB_STACK_Dec): // -- on a variable
+				CheckOpPar(C4V_Int, "--", &pCurVal[pCPos->Par.i]);
+				pCurVal[pCPos->Par.i].SetInt(pCurVal[pCPos->Par.i]._getInt() - 1);
+				AUL_NEXT;
+			AUL_OP(AB_Sum_INT):  // + constant
+				CheckOpLeftPar(C4V_Int, "+");
+				pCurVal->SetInt(pCurVal->_getInt() + pCPos->Par.i);
+				AUL_NEXT;
+			AUL_OP(AB_Sub_INT):  // - constant
+				CheckOpLeftPar(C4V_Int, "-");
+				pCurVal->SetInt(pCurVal->_getInt() - pCPos->Par.i);
+				AUL_NEXT;
+			AUL_OP(AB_Mul_INT):  // * constant
+				CheckOpLeftPar(C4V_Int, "*");
+				pCurVal->SetInt(pCurVal->_getInt() * pCPos->Par.i);
+				AUL_NEXT;
+			AUL_OP(AB_LessThan_INT): // < constant
+				CheckOpLeftPar(C4V_Int, "<");
+				pCurVal->SetBool(pCurVal->_getInt() < pCPos->Par.i);
+				AUL_NEXT;
+			AUL_OP(AB_LessThanEqual_INT):  // <= constant
+				CheckOpLeftPar(C4V_Int, "<=");
+				pCurVal->SetBool(pCurVal->_getInt() <= pCPos->Par.i);
+				AUL_NEXT;
+			AUL_OP(AB_GreaterThan_INT):  // > constant
+				CheckOpLeftPar(C4V_Int, ">");
+				pCurVal->SetBool(pCurVal->_getInt() > pCPos->Par.i);
+				AUL_NEXT;
+			AUL_OP(AB_GreaterThanEqual_INT): // >= constant
+				CheckOpLeftPar(C4V_Int, ">=");
+				pCurVal->SetBool(pCurVal->_getInt() >= pCPos->Par.i);
+				AUL_NEXT;
+			AUL_OP(AB_Equal_INT):  // == constant
+				pCurVal->SetBool(pCurVal->IsIdenticalTo(C4VInt(pCPos->Par.i)));
+				AUL_NEXT;
+			AUL_OP(AB_NotEqual_INT): // != constant
+				pCurVal->SetBool(!pCurVal->IsIdenticalTo(C4VInt(pCPos->Par.i)));
+				AUL_NEXT;
+
+			AUL_OP(AB_LessThan_CONDN): // < and CONDN
+			{
+				CheckOpPars(C4V_Int, C4V_Int, "<");
+				bool fCond = pCurVal[-1]._getInt() < pCurVal[0]._getInt();
+				PopValues(2);
+				if (!fCond)
+				{
+					AUL_JUMP(pCPos + pCPos->Par.i);
+				}
+				AUL_NEXT;
+			}
+			AUL_OP(AB_LessThanEqual_CONDN):  // <= and CONDN
+			{
+				CheckOpPars(C4V_Int, C4V_Int, "<=");
+				bool fCond = pCurVal[-1]._getInt() <= pCurVal[0]._getInt();
+				PopValues(2);
+				if (!fCond)
+				{
+					AUL_JUMP(pCPos + pCPos->Par.i);
+				}
+				AUL_NEXT;
+			}
+			AUL_OP(AB_GreaterThan_CONDN):  // > and CONDN
+			{
+				CheckOpPars(C4V_Int, C4V_Int, ">");
+				bool fCond = pCurVal[-1]._getInt() > pCurVal[0]._getInt();
+				PopValues(2);
+				if (!fCond)
+				{
+					AUL_JUMP(pCPos + pCPos->Par.i);
+				}
+				AUL_NEXT;
+			}
+			AUL_OP(AB_GreaterThanEqual_CONDN): // >= and CONDN
+			{
+				CheckOpPars(C4V_Int, C4V_Int, ">=");
+				bool fCond = pCurVal[-1]._getInt() >= pCurVal[0]._getInt();
+				PopValues(2);
+				if (!fCond)
+				{
+					AUL_JUMP(pCPos + pCPos->Par.i);
+				}
+				AUL_NEXT;
+			}
+			AUL_OP(AB_Equal_CONDN):  // == and CONDN
+			{
+				bool fCond = pCurVal[-1].IsIdenticalTo(pCurVal[0]);
+				PopValues(2);
+				if (!fCond)
+				{
+					AUL_JUMP(pCPos + pCPos->Par.i);
+				}
+				AUL_NEXT;
+			}
+			AUL_OP(AB_NotEqual_CONDN): // != and CONDN
+			{
+				bool fCond = !pCurVal[-1].IsIdenticalTo(pCurVal[0]);
+				PopValues(2);
+				if (!fCond)
+				{
+					AUL_JUMP(pCPos + pCPos->Par.i);
+				}
+				AUL_NEXT;
+			}
+
+			// tiered up sequences, see C4AulScriptFunc::TierUp
+			AUL_OP(AB_THIS_PROP):
+				PushNullVals(1);
+				if (!pCurCtx->Obj || !pCurCtx->Obj->Status)
+					AUL_NEXT; // AB_PROP reports the error
+				if (!pCurCtx->Obj->GetPropertyByS(pCPos[1].Par.s, pCurVal, pCurCtx->Func->GetLookupCache(pCPos + 1)))
+					pCurVal->Set0();
+				AUL_JUMP(pCPos + 2);
+			AUL_OP(AB_INT_ARRAYA):
+				if (pCurVal->GetType() != C4V_Array)
+				{
+					PushInt(pCPos->Par.i);
+					AUL_NEXT;
+				}
+				pCurVal->Set(pCurVal->_getArray()->GetItem(pCPos->Par.i));
+				AUL_JUMP(pCPos + 2);
+			AUL_OP(AB_DUP_Sum):
+				if (pCurVal->GetType() != C4V_Int || pCurVal[pCPos->Par.i].GetType() != C4V_Int)
+				{
+					PushValue(pCurVal[pCPos->Par.i]);
+					AUL_NEXT;
+				}
+				pCurVal->SetInt(pCurVal->_getInt() + pCurVal[pCPos->Par.i]._getInt());
+				AUL_JUMP(pCPos + 2);
+			AUL_OP(AB_DUP_Sub):
+				if (pCurVal->GetType() != C4V_Int || pCurVal[pCPos->Par.i].GetType() != C4V_Int)
+				{
+					PushValue(pCurVal[pCPos->Par.i]);
+					AUL_NEXT;
+				}
+				pCurVal->SetInt(pCurVal->_getInt() - pCurVal[pCPos->Par.i]._getInt());
+				AUL_JUMP(pCPos + 2);
+			AUL_OP(AB_DUP_LessThan_CONDN):
+			{
+				if (pCurVal->GetType() != C4V_Int || pCurVal[pCPos->Par.i].GetType() != C4V_Int)
+				{
+					PushValue(pCurVal[pCPos->Par.i]);
+					AUL_NEXT;
+				}
+				bool fCond = pCurVal->_getInt() < pCurVal[pCPos->Par.i]._getInt();
+				PopValue();
+				AUL_JUMP(pCPos + (fCond ? 2 : 1 + pCPos[1].Par.i));
+			}
+			AUL_OP(AB_DUP_GreaterThan_CONDN):
+			{
+				if (pCurVal->GetType() != C4V_Int || pCurVal[pCPos->Par.i].GetType() != C4V_Int)
+				{
+					PushValue(pCurVal[pCPos->Par.i]);
+					AUL_NEXT;
+				}
+				bool fCond = pCurVal->_getInt() > pCurVal[pCPos->Par.i]._getInt();
+				PopValue();
+				AUL_JUMP(pCPos + (fCond ? 2 : 1 + pCPos[1].Par.i));
+			}
+
+			AUL_OP(AB_NEW_ARRAY):
 			{
 				// Create array
 				C4ValueArray *pArray = new C4ValueArray(pCPos->Par.i);
@@ -473,10 +756,10 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos)
 				PopValues(pCPos->Par.i);
 				PushArray(pArray);
 
-				break;
+				AUL_NEXT;
 			}
 
-			case AB_NEW_PROPLIST:
+			AUL_OP(AB_NEW_PROPLIST):
 			{
 				C4PropList * pPropList = C4PropList::New();
 
@@ -485,10 +768,10 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos)
 
 				PopValues(pCPos->Par.i * 2);
 				PushPropList(pPropList);
-				break;
+				AUL_NEXT;
 			}
 
-			case AB_ARRAYA:
+			AUL_OP(AB_ARRAYA):
 			{
 				C4Value *pIndex = pCurVal, *pStruct = pCurVal - 1, *pResult = pCurVal - 1;
 				// Typcheck to determine whether it's an array or a proplist
@@ -505,9 +788,9 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos)
 				}
 				// Remove index
 				PopValue();
-				break;
+				AUL_NEXT;
 			}
-			case AB_ARRAYA_SET:
+			AUL_OP(AB_ARRAYA_SET):
 			{
 				C4Value *pValue = pCurVal, *pIndex = pCurVal - 1, *pStruct = pCurVal - 2, *pResult = pCurVal - 2;
 				// Typcheck to determine whether it's an array or a proplist
@@ -528,9 +811,9 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos)
 				// Set result, remove array and index from stack
 				*pResult = *pValue;
 				PopValues(2);
-				break;
+				AUL_NEXT;
 			}
-			case AB_ARRAY_SLICE:
+			AUL_OP(AB_ARRAY_SLICE):
 			{
 				C4Value &Array = pCurVal[-2];
 				C4Value &StartIndex = pCurVal[-1];
@@ -548,10 +831,10 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos)
 
 				// Remove both indices
 				PopValues(2);
-				break;
+				AUL_NEXT;
 			}
 
-			case AB_ARRAY_SLICE_SET:
+			AUL_OP(AB_ARRAY_SLICE_SET):
 			{
 				C4Value &Array = pCurVal[-3];
 				C4Value &StartIndex = pCurVal[-2];
@@ -573,78 +856,79 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos)
 				// Set value as result, remove both indices and first copy of value
 				Array = Value;
 				PopValues(3);
-				break;
+				AUL_NEXT;
 			}
 
-			case AB_STACK:
+			AUL_OP(AB_STACK):
 				if (pCPos->Par.i < 0)
 					PopValues(-pCPos->Par.i);
 				else
 					PushNullVals(pCPos->Par.i);
-				break;
+				AUL_NEXT;
 
-			case AB_JUMP:
-				fJump = true;
-				pCPos += pCPos->Par.i;
-				break;
+			AUL_OP(AB_JUMP):
+				// loop iteration
+				if (pCPos->Par.i < 0)
+					pCurCtx->Func->CountExec(::ScriptEngine.TierUpThreshold);
+				AUL_JUMP(pCPos + pCPos->Par.i);
 
-			case AB_JUMPAND:
+			AUL_OP(AB_JUMPAND):
 				if (!pCurVal[0])
 				{
-					fJump = true;
-					pCPos += pCPos->Par.i;
+					AUL_JUMP(pCPos + pCPos->Par.i);
 				}
 				else
 				{
 					PopValue();
 				}
-				break;
+				AUL_NEXT;
 
-			case AB_JUMPOR:
+			AUL_OP(AB_JUMPOR):
 				if (!!pCurVal[0])
 				{
-					fJump = true;
-					pCPos += pCPos->Par.i;
+					AUL_JUMP(pCPos + pCPos->Par.i);
 				}
 				else
 				{
 					PopValue();
 				}
-				break;
+				AUL_NEXT;
 
-			case AB_JUMPNNIL: // ??
+			AUL_OP(AB_JUMPNNIL): // ??
 			{
 				if (pCurVal[0].GetType() != C4V_Nil)
 				{
-					fJump = true;
-					pCPos += pCPos->Par.i;
+					AUL_JUMP(pCPos + pCPos->Par.i);
 				}
 				else
 				{
 					PopValue();
 				}
-				break;
+				AUL_NEXT;
 			}
 
-			case AB_CONDN:
+			AUL_OP(AB_CONDN):
 				if (!pCurVal[0])
 				{
-					fJump = true;
-					pCPos += pCPos->Par.i;
+					PopValue();
+					AUL_JUMP(pCPos + pCPos->Par.i);
 				}
 				PopValue();
-				break;
+				AUL_NEXT;
 
-			case AB_COND:
+			AUL_OP(AB_COND):
 				if (pCurVal[0])
 				{
-					fJump = true;
-					pCPos += pCPos->Par.i;
+					// do-while loop iteration
+					if (pCPos->Par.i < 0)
+						pCurCtx->Func->CountExec(::ScriptEngine.TierUpThreshold);
+					PopValue();
+					AUL_JUMP(pCPos + pCPos->Par.i);
 				}
 				PopValue();
-				break;
+				AUL_NEXT;
 
-			case AB_RETURN:
+			AUL_OP(AB_RETURN):
 			{
 				// Trace
 				if (iTraceStart >= 0)
@@ -677,13 +961,10 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos)
 				PopValuesUntil(pReturn);
 
 				// Jump back, continue.
-				pCPos = pCurCtx->CPos + 1;
-				fJump = true;
-
-				break;
+				AUL_JUMP(pCurCtx->CPos + 1);
 			}
 
-			case AB_FUNC:
+			AUL_OP(AB_FUNC):
 			{
 				// Get function call data
 				C4AulFunc *pFunc = pCPos->Par.f;
@@ -695,13 +976,12 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos)
 				C4AulBCC *pJump = Call(pFunc, pPars, pPars, nullptr);
 				if (pJump)
 				{
-					pCPos = pJump;
-					fJump = true;
+					AUL_JUMP(pJump);
 				}
-				break;
+				AUL_NEXT;
 			}
 
-			case AB_PAR:
+			AUL_OP(AB_PAR):
 				if (!pCurVal->CheckConversion(C4V_Int))
 					throw C4AulExecError(FormatString("Par: index of type %s, int expected", pCurVal->GetTypeName()).getData());
 				// Push reference to parameter on the stack
@@ -709,16 +989,16 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos)
 					pCurVal->Set(pCurCtx->Pars[pCurVal->_getInt()]);
 				else
 					pCurVal->Set0();
-				break;
+				AUL_NEXT;
 
-			case AB_THIS:
+			AUL_OP(AB_THIS):
 				if (!pCurCtx->Obj || !pCurCtx->Obj->Status)
 					PushNullVals(1);
 				else
 					PushPropList(pCurCtx->Obj);
-				break;
+				AUL_NEXT;
 
-			case AB_FOREACH_NEXT:
+			AUL_OP(AB_FOREACH_NEXT):
 			{
 				// This should always hold
 				assert(pCurVal->CheckConversion(C4V_Int));
@@ -732,19 +1012,17 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos)
 				C4ValueArray *pArray = pCurVal[-1]._getArray();
 				// No more entries?
 				if (pCurVal->_getInt() >= pArray->GetSize())
-					break;
+					AUL_NEXT;
 				// Get next
 				pCurVal[pCPos->Par.i] = pArray->GetItem(iItem);
 				// Save position
 				pCurVal->SetInt(iItem + 1);
 				// Jump over next instruction
-				pCPos += 2;
-				fJump = true;
-				break;
+				AUL_JUMP(pCPos + 2);
 			}
 
-			case AB_CALL:
-			case AB_CALLFS:
+			AUL_OP(AB_CALL):
+			AUL_OP(AB_CALLFS):
 			{
 
 				C4Value *pPars = pCurVal - C4AUL_MAX_Par + 1;
@@ -759,12 +1037,12 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos)
 					throw C4AulExecError(FormatString("'->': invalid target type %s, expected proplist", pTargetVal->GetTypeName()).getData());
 
 				// Search function for given context
-				C4AulFunc * pFunc = pDest->GetFunc(pCPos->Par.s);
+				C4AulFunc * pFunc = pDest->GetFunc(pCPos->Par.s, pCurCtx->Func->GetLookupCache(pCPos));
 				if (!pFunc && pCPos->bccType == AB_CALLFS)
 				{
 					PopValuesUntil(pTargetVal);
 					pTargetVal->Set0();
-					break;
+					AUL_NEXT;
 				}
 
 				// Function not found?
@@ -786,24 +1064,20 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos)
 				if (pNewCPos)
 				{
 					// Jump
-					pCPos = pNewCPos;
-					fJump = true;
+					AUL_JUMP(pNewCPos);
 				}
 
-				break;
+				AUL_NEXT;
 			}
 
-			case AB_DEBUG:
+			AUL_OP(AB_DEBUG):
 #ifndef NOAULDEBUG
 				if (C4AulDebug *pDebug = C4AulDebug::GetDebugger())
 					pDebug->DebugStep(pCPos, pCurVal);
 #endif
-				break;
+				AUL_NEXT;
 			}
-
-			// Continue
-			if (!fJump)
-				pCPos++;
+			throw C4AulExecError("internal error: unknown bytecode");
 		}
 
 	}
@@ -843,6 +1117,7 @@ C4AulBCC *C4AulExec::Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, C4
 		PushContext(ctx);
 
 		// Jump to code
+		pSFunc->CountExec(::ScriptEngine.TierUpThreshold);
 		return pSFunc->GetCode();
 	}
 	else
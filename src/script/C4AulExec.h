@@ -201,11 +201,19 @@ private:
 			throw C4AulExecError(FormatString(R"(operator "%s" right side got %s, but expected %s)",
 			                                      opname, pPar2->GetTypeName(), GetC4VName(Type2)).getData());
 	}
-	ALWAYS_INLINE void CheckOpPar(C4V_Type Type1, const char * opname)
+	ALWAYS_INLINE void CheckOpPar(C4V_Type Type1, const char * opname, C4Value *pPar = nullptr)
 	{
+		if (!pPar) pPar = pCurVal;
 		// Typecheck parameter
-		if (!pCurVal->CheckParConversion(Type1))
+		if (!pPar->CheckParConversion(Type1))
 			throw C4AulExecError(FormatString(R"(operator "%s": got %s, but expected %s)",
+			                                      opname, pPar->GetTypeName(), GetC4VName(Type1)).getData());
+	}
+	// For operators whose right side is a constant int
+	ALWAYS_INLINE void CheckOpLeftPar(C4V_Type Type1, const char * opname)
+	{
+		if (!pCurVal->CheckParConversion(Type1))
+			throw C4AulExecError(FormatString(R"(operator "%s" left side got %s, but expected %s)",
 			                                      opname, pCurVal->GetTypeName(), GetC4VName(Type1)).getData());
 	}
 
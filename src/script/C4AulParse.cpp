@@ -134,6 +134,7 @@ void C4AulParse::Warn(C4AulWarningId warning, ...)
 {
 	if (!IsWarningEnabled(TokenSPos, warning))
 		return;
+	++WarnCnt;
 	va_list args; va_start(args, warning);
 	StdStrBuf Buf = FormatStringV(C4AulWarningMessages[static_cast<size_t>(warning)], args);
 	AppendPosition(Buf);
@@ -577,6 +578,31 @@ static const char * GetTTName(C4AulBCCType e)
 	case AB_BitXOr: return "BitXOr";  // ^
 	case AB_BitOr: return "BitOr";  // |
 
+// superinstructions
+	case AB_STACK_Inc: return "STACK_Inc";
+	case AB_STACK_Dec: return "STACK_Dec";
+	case AB_Sum_INT: return "Sum_INT";
+	case AB_Sub_INT: return "Sub_INT";
+	case AB_Mul_INT: return "Mul_INT";
+	case AB_LessThan_INT: return "LessThan_INT";
+	case AB_LessThanEqual_INT: return "LessThanEqual_INT";
+	case AB_GreaterThan_INT: return "GreaterThan_INT";
+	case AB_GreaterThanEqual_INT: return "GreaterThanEqual_INT";
+	case AB_Equal_INT: return "Equal_INT";
+	case AB_NotEqual_INT: return "NotEqual_INT";
+	case AB_LessThan_CONDN: return "LessThan_CONDN";
+	case AB_LessThanEqual_CONDN: return "LessThanEqual_CONDN";
+	case AB_GreaterThan_CONDN: return "GreaterThan_CONDN";
+	case AB_GreaterThanEqual_CONDN: return "GreaterThanEqual_CONDN";
+	case AB_Equal_CONDN: return "Equal_CONDN";
+	case AB_NotEqual_CONDN: return "NotEqual_CONDN";
+	case AB_THIS_PROP: return "THIS_PROP";
+	case AB_INT_ARRAYA: return "INT_ARRAYA";
+	case AB_DUP_Sum: return "DUP_Sum";
+	case AB_DUP_Sub: return "DUP_Sub";
+	case AB_DUP_LessThan_CONDN: return "DUP_LessThan_CONDN";
+	case AB_DUP_GreaterThan_CONDN: return "DUP_GreaterThan_CONDN";
+
 	case AB_CALL: return "CALL";    // direct object call
 	case AB_CALLFS: return "CALLFS";  // failsafe direct call
 	case AB_STACK: return "STACK";    // push nulls / pop
@@ -619,6 +645,8 @@ void C4AulScriptFunc::DumpByteCode()
 			switch (bcc.bccType)
 			{
 			case AB_JUMP: case AB_JUMPAND: case AB_JUMPOR: case AB_JUMPNNIL: case AB_CONDN: case AB_COND:
+			case AB_LessThan_CONDN: case AB_LessThanEqual_CONDN: case AB_GreaterThan_CONDN:
+			case AB_GreaterThanEqual_CONDN: case AB_Equal_CONDN: case AB_NotEqual_CONDN:
 				labels[&bcc + bcc.Par.i] = ++labeln; break;
 			default: break;
 			}
@@ -673,7 +701,7 @@ void C4AulScriptFunc::DumpByteCode()
 				fprintf(stderr, "\t\"%s\"\n", es.c_str()); break;
 			}
 			case AB_DEBUG: case AB_NIL: case AB_RETURN:
-			case AB_PAR: case AB_THIS:
+			case AB_PAR: case AB_THIS: case AB_THIS_PROP:
 			case AB_ARRAYA: case AB_ARRAYA_SET: case AB_ARRAY_SLICE: case AB_ARRAY_SLICE_SET:
 			case AB_EOFN:
 				assert(!bcc.Par.X); fprintf(stderr, "\n"); break;
@@ -682,6 +710,8 @@ void C4AulScriptFunc::DumpByteCode()
 			case AB_CPROPLIST:
 				fprintf(stderr, "\t%s\n", C4VPropList(bcc.Par.p).GetDataString().getData()); break;
 			case AB_JUMP: case AB_JUMPAND: case AB_JUMPOR: case AB_JUMPNNIL: case AB_CONDN: case AB_COND:
+			case AB_LessThan_CONDN: case AB_LessThanEqual_CONDN: case AB_GreaterThan_CONDN:
+			case AB_GreaterThanEqual_CONDN: case AB_Equal_CONDN: case AB_NotEqual_CONDN:
 				fprintf(stderr, "\t% -d\n", labels[&bcc + bcc.Par.i]); break;
 			default:
 				fprintf(stderr, "\t% -d\n", bcc.Par.i); break;
@@ -712,8 +742,7 @@ bool C4ScriptHost::Preparse()
 #include "C4AulWarnings.h"
 #undef DIAG
 
-	C4AulParse parser(this);
-	ast = parser.Parse_Script(this);
+	ast = Engine->ScriptCache.Parse(this);
 
 	C4AulCompiler::Preparse(this, this, ast.get());
 
@@ -722,6 +751,7 @@ bool C4ScriptHost::Preparse()
 
 	// Parse will write the properties back after the ones from included scripts
 	GetPropList()->Properties.Swap(&LocalValues);
+	GetPropList()->InvalidateLookupCaches();
 
 	// return success
 	this->State = ASS_PREPARSED;
@@ -50,6 +50,7 @@ public:
 	~C4AulParse();
 	std::unique_ptr<::aul::ast::FunctionDecl> Parse_DirectExec(const char *code, bool whole_function);
 	std::unique_ptr<::aul::ast::Script> Parse_Script(C4ScriptHost *);
+	int GetWarningCount() const { return WarnCnt; }
 
 private:
 	C4AulScriptFunc *Fn; C4ScriptHost * Host; C4ScriptHost * pOrgScript;
@@ -61,6 +62,7 @@ private:
 	int32_t cInt; // current int constant
 	C4String * cStr; // current string constant
 	C4AulScriptContext* ContextToExecIn;
+	int WarnCnt{0}; // number of warnings reported by this parser
 	void Parse_Function(bool parse_for_direct_exec);
 	void Parse_WarningPragma();
 
@@ -0,0 +1,569 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2016, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4Include.h"
+#include "script/C4AulScriptCache.h"
+
+#include "blake2.h"
+#include "script/C4AulAST.h"
+#include "script/C4AulParse.h"
+#include "script/C4ScriptHost.h"
+
+// Bump this whenever the syntax tree or the parser output changes
+static const uint32_t C4AulScriptCacheFormat = 1;
+static const size_t DigestLength = 20;
+static const char C4AulScriptCacheMagic[8] = { 'C', '4', 'A', 'u', 'l', 'A', 'S', 'T' };
+// Entries of old engine versions and changed scripts are never loaded again
+static const int32_t C4AulScriptCacheMaxAge = 30 * 24 * 60 * 60;
+// Used entries are rewritten at most this often to mark them as recent
+static const int32_t C4AulScriptCacheRefreshAge = 24 * 60 * 60;
+// Temporary files left behind by aborted writes
+static const int32_t C4AulScriptCacheTempMaxAge = 60 * 60;
+
+static_assert(static_cast<size_t>(C4AulWarningId::WarningCount) <= 64, "warning sets must fit into 64 bits");
+
+namespace
+{
+	using namespace ::aul::ast;
+
+	enum NodeTag : uint8_t
+	{
+		NT_Null,
+		NT_Noop,
+		NT_StringLit,
+		NT_IntLit,
+		NT_BoolLit,
+		NT_ArrayLit,
+		NT_ProplistLit,
+		NT_NilLit,
+		NT_ThisLit,
+		NT_VarExpr,
+		NT_UnOpExpr,
+		NT_BinOpExpr,
+		NT_AssignmentExpr,
+		NT_SubscriptExpr,
+		NT_SliceExpr,
+		NT_CallExpr,
+		NT_ParExpr,
+		NT_FunctionExpr,
+		NT_Block,
+		NT_Return,
+		NT_ForLoop,
+		NT_RangeLoop,
+		NT_DoLoop,
+		NT_WhileLoop,
+		NT_Break,
+		NT_Continue,
+		NT_If,
+		NT_VarDecl,
+		NT_FunctionDecl,
+		NT_IncludePragma,
+		NT_AppendtoPragma,
+		NT_Script
+	};
+
+	// Whether nodes with the tag derive from the given class. Cheaper than a dynamic_cast per node.
+	template<class T> bool HasType(NodeTag tag);
+	template<> bool HasType<Stmt>(NodeTag tag) { return tag != NT_Script; }
+	template<> bool HasType<Expr>(NodeTag tag) { return tag >= NT_StringLit && tag <= NT_FunctionExpr; }
+	template<> bool HasType<Decl>(NodeTag tag) { return tag >= NT_VarDecl && tag <= NT_AppendtoPragma; }
+	template<> bool HasType<Block>(NodeTag tag) { return tag == NT_Block; }
+	template<> bool HasType<Script>(NodeTag tag) { return tag == NT_Script; }
+
+	// Serializes a syntax tree. Locations are stored as offsets into the script text.
+	class AstWriter : public ::aul::AstVisitor
+	{
+		std::string &Out;
+		const char *Base; size_t BaseLength;
+
+	public:
+		AstWriter(std::string &out, const char *base, size_t base_length) : Out(out), Base(base), BaseLength(base_length) {}
+
+		using AstVisitor::visit;
+
+		template<class T> void Value(T v) { Out.append(reinterpret_cast<const char *>(&v), sizeof(v)); }
+		void String(const std::string &s) { Value<uint32_t>(s.size()); Out.append(s); }
+		void Loc(const char *loc)
+		{
+			if (loc && (loc < Base || loc > Base + BaseLength))
+				throw std::runtime_error("location outside of script");
+			Value<uint32_t>(loc ? loc - Base + 1 : 0);
+		}
+		void Head(NodeTag tag, const Node *n) { Value<uint8_t>(tag); Loc(n->loc); }
+		void Child(const Node *n)
+		{
+			if (n)
+				n->accept(this);
+			else
+				Value<uint8_t>(NT_Null);
+		}
+		template<class T> void Children(const std::vector<T> &v)
+		{
+			Value<uint32_t>(v.size());
+			for (const auto &c : v)
+				Child(c.get());
+		}
+		void Function(const ::aul::ast::Function *f)
+		{
+			Value<uint32_t>(f->params.size());
+			for (const auto &p : f->params)
+			{
+				String(p.name);
+				Value<int32_t>(p.type);
+			}
+			Value<uint8_t>(f->has_unnamed_params);
+			Child(f->body.get());
+		}
+
+		void visit(const Noop *n) override { Head(NT_Noop, n); }
+		void visit(const StringLit *n) override { Head(NT_StringLit, n); String(n->value); }
+		void visit(const IntLit *n) override { Head(NT_IntLit, n); Value<uint32_t>(n->value); }
+		void visit(const BoolLit *n) override { Head(NT_BoolLit, n); Value<uint8_t>(n->value); }
+		void visit(const ArrayLit *n) override { Head(NT_ArrayLit, n); Children(n->values); }
+		void visit(const ProplistLit *n) override
+		{
+			Head(NT_ProplistLit, n);
+			Value<uint32_t>(n->values.size());
+			for (const auto &v : n->values)
+			{
+				String(v.first);
+				Child(v.second.get());
+			}
+		}
+		void visit(const NilLit *n) override { Head(NT_NilLit, n); }
+		void visit(const ThisLit *n) override { Head(NT_ThisLit, n); }
+		void visit(const VarExpr *n) override { Head(NT_VarExpr, n); String(n->identifier); }
+		void visit(const UnOpExpr *n) override { Head(NT_UnOpExpr, n); Value<int32_t>(n->op); Child(n->operand.get()); }
+		void visit(const BinOpExpr *n) override { Head(NT_BinOpExpr, n); Value<int32_t>(n->op); Child(n->lhs.get()); Child(n->rhs.get()); }
+		void visit(const AssignmentExpr *n) override { Head(NT_AssignmentExpr, n); Child(n->lhs.get()); Child(n->rhs.get()); }
+		void visit(const SubscriptExpr *n) override { Head(NT_SubscriptExpr, n); Child(n->object.get()); Child(n->index.get()); }
+		void visit(const SliceExpr *n) override { Head(NT_SliceExpr, n); Child(n->object.get()); Child(n->start.get()); Child(n->end.get()); }
+		void visit(const CallExpr *n) override
+		{
+			Head(NT_CallExpr, n);
+			Value<uint8_t>(n->safe_call);
+			Value<uint8_t>(n->append_unnamed_pars);
+			Child(n->context.get());
+			Children(n->args);
+			String(n->callee);
+		}
+		void visit(const ParExpr *n) override { Head(NT_ParExpr, n); Child(n->arg.get()); }
+		void visit(const FunctionExpr *n) override { Head(NT_FunctionExpr, n); Function(n); }
+		void visit(const Block *n) override { Head(NT_Block, n); Children(n->children); }
+		void visit(const Return *n) override { Head(NT_Return, n); Child(n->value.get()); }
+		void visit(const ForLoop *n) override
+		{
+			Head(NT_ForLoop, n);
+			Child(n->init.get()); Child(n->cond.get()); Child(n->incr.get()); Child(n->body.get());
+		}
+		void visit(const RangeLoop *n) override
+		{
+			Head(NT_RangeLoop, n);
+			String(n->var); Value<uint8_t>(n->scoped_var);
+			Child(n->cond.get()); Child(n->body.get());
+		}
+		void visit(const DoLoop *n) override { Head(NT_DoLoop, n); Child(n->cond.get()); Child(n->body.get()); }
+		void visit(const WhileLoop *n) override { Head(NT_WhileLoop, n); Child(n->cond.get()); Child(n->body.get()); }
+		void visit(const Break *n) override { Head(NT_Break, n); }
+		void visit(const Continue *n) override { Head(NT_Continue, n); }
+		void visit(const If *n) override { Head(NT_If, n); Child(n->cond.get()); Child(n->iftrue.get()); Child(n->iffalse.get()); }
+		void visit(const VarDecl *n) override
+		{
+			Head(NT_VarDecl, n);
+			Value<uint8_t>(static_cast<uint8_t>(n->scope));
+			Value<uint8_t>(n->constant);
+			Value<uint32_t>(n->decls.size());
+			for (const auto &d : n->decls)
+			{
+				String(d.name);
+				Child(d.init.get());
+			}
+		}
+		void visit(const FunctionDecl *n) override { Head(NT_FunctionDecl, n); String(n->name); Value<uint8_t>(n->is_global); Function(n); }
+		void visit(const IncludePragma *n) override { Head(NT_IncludePragma, n); String(n->what); }
+		void visit(const AppendtoPragma *n) override { Head(NT_AppendtoPragma, n); String(n->what); }
+		void visit(const Script *n) override { Head(NT_Script, n); Children(n->declarations); }
+	};
+
+	// Rebuilds a syntax tree written by AstWriter. Throws on malformed input.
+	class AstReader
+	{
+		const char *Pos, *End;
+		const char *Base; size_t BaseLength;
+
+	public:
+		AstReader(const char *data, size_t size, const char *base, size_t base_length) : Pos(data), End(data + size), Base(base), BaseLength(base_length) {}
+
+		bool AtEnd() const { return Pos == End; }
+		template<class T> T Value()
+		{
+			if (size_t(End - Pos) < sizeof(T))
+				throw std::runtime_error("unexpected end of cache file");
+			T v;
+			std::memcpy(&v, Pos, sizeof(T));
+			Pos += sizeof(T);
+			return v;
+		}
+		std::string String()
+		{
+			uint32_t length = Value<uint32_t>();
+			if (size_t(End - Pos) < length)
+				throw std::runtime_error("unexpected end of cache file");
+			std::string s(Pos, length);
+			Pos += length;
+			return s;
+		}
+		const char *Loc()
+		{
+			uint32_t offset = Value<uint32_t>();
+			if (!offset)
+				return nullptr;
+			if (offset - 1 > BaseLength)
+				throw std::runtime_error("location outside of script");
+			return Base + offset - 1;
+		}
+
+		// Optional child node of the given type
+		template<class T> std::unique_ptr<T> Child()
+		{
+			NodeTag tag;
+			std::unique_ptr<Node> n = ReadNode(&tag);
+			if (!n)
+				return nullptr;
+			if (!HasType<T>(tag))
+				throw std::runtime_error("unexpected node type");
+			return std::unique_ptr<T>(static_cast<T *>(n.release()));
+		}
+		// Mandatory child node of the given type
+		template<class T> std::unique_ptr<T> Get()
+		{
+			std::unique_ptr<T> n = Child<T>();
+			if (!n)
+				throw std::runtime_error("missing node");
+			return n;
+		}
+		template<class T> void Children(std::vector<std::unique_ptr<T>> &v)
+		{
+			for (uint32_t n = Value<uint32_t>(); n; --n)
+				v.push_back(Get<T>());
+		}
+		// Index into C4ScriptOpMap, checked because the compiler uses it unchecked
+		int Operator(bool binary)
+		{
+			static const int32_t OperatorCount = [] { int32_t i = 0; while (C4ScriptOpMap[i].Identifier) ++i; return i; }();
+			int32_t op = Value<int32_t>();
+			if (op < 0 || op >= OperatorCount)
+				throw std::runtime_error("invalid operator");
+			const C4ScriptOpDef &def = C4ScriptOpMap[op];
+			if (binary != (def.Postfix && !def.NoSecondStatement))
+				throw std::runtime_error("invalid operator");
+			return op;
+		}
+		// Only the types the parser accepts for parameters
+		C4V_Type ParameterType()
+		{
+			auto type = static_cast<C4V_Type>(Value<int32_t>());
+			switch (type)
+			{
+			case C4V_Int: case C4V_Bool: case C4V_PropList: case C4V_String: case C4V_Array: case C4V_Function:
+			case C4V_Any: case C4V_Object: case C4V_Def: case C4V_Effect:
+				return type;
+			default:
+				throw std::runtime_error("invalid parameter type");
+			}
+		}
+		void Function(::aul::ast::Function *f)
+		{
+			for (uint32_t n = Value<uint32_t>(); n; --n)
+			{
+				std::string name = String();
+				f->params.emplace_back(name, ParameterType());
+			}
+			f->has_unnamed_params = !!Value<uint8_t>();
+			f->body = Get<Block>();
+		}
+
+		std::unique_ptr<Node> ReadNode(NodeTag *tag_out);
+	};
+
+	std::unique_ptr<Node> AstReader::ReadNode(NodeTag *tag_out)
+	{
+		NodeTag tag = *tag_out = static_cast<NodeTag>(Value<uint8_t>());
+		if (tag == NT_Null)
+			return nullptr;
+		const char *loc = Loc();
+		switch (tag)
+		{
+		case NT_Noop: return Noop::New(loc);
+		case NT_StringLit: return StringLit::New(loc, String());
+		case NT_IntLit: { auto n = IntLit::New(loc, 0); n->value = Value<uint32_t>(); return n; }
+		case NT_BoolLit: return BoolLit::New(loc, !!Value<uint8_t>());
+		case NT_ArrayLit: { auto n = ArrayLit::New(loc); Children(n->values); return n; }
+		case NT_ProplistLit:
+		{
+			auto n = ProplistLit::New(loc);
+			for (uint32_t i = Value<uint32_t>(); i; --i)
+			{
+				std::string key = String();
+				n->values.emplace_back(key, Get<Expr>());
+			}
+			return n;
+		}
+		case NT_NilLit: return NilLit::New(loc);
+		case NT_ThisLit: return ThisLit::New(loc);
+		case NT_VarExpr: return VarExpr::New(loc, String());
+		case NT_UnOpExpr: { int op = Operator(false); return UnOpExpr::New(loc, op, Get<Expr>()); }
+		case NT_BinOpExpr:
+		{
+			int op = Operator(true);
+			auto lhs = Get<Expr>();
+			return BinOpExpr::New(loc, op, std::move(lhs), Get<Expr>());
+		}
+		case NT_AssignmentExpr: { auto lhs = Get<Expr>(); return AssignmentExpr::New(loc, std::move(lhs), Get<Expr>()); }
+		case NT_SubscriptExpr: { auto object = Get<Expr>(); return SubscriptExpr::New(loc, std::move(object), Get<Expr>()); }
+		case NT_SliceExpr:
+		{
+			auto object = Get<Expr>();
+			auto start = Get<Expr>();
+			return SliceExpr::New(loc, std::move(object), std::move(start), Get<Expr>());
+		}
+		case NT_CallExpr:
+		{
+			auto n = CallExpr::New(loc);
+			n->safe_call = !!Value<uint8_t>();
+			n->append_unnamed_pars = !!Value<uint8_t>();
+			n->context = Child<Expr>();
+			Children(n->args);
+			n->callee = String();
+			return n;
+		}
+		case NT_ParExpr: return ParExpr::New(loc, Get<Expr>());
+		case NT_FunctionExpr: { auto n = FunctionExpr::New(loc); Function(n.get()); return n; }
+		case NT_Block: { auto n = Block::New(loc); Children(n->children); return n; }
+		case NT_Return: return Return::New(loc, Child<Expr>());
+		case NT_ForLoop:
+		{
+			auto n = ForLoop::New(loc);
+			n->init = Child<Stmt>(); n->cond = Child<Expr>(); n->incr = Child<Expr>(); n->body = Get<Stmt>();
+			return n;
+		}
+		case NT_RangeLoop:
+		{
+			auto n = RangeLoop::New(loc);
+			n->var = String(); n->scoped_var = !!Value<uint8_t>();
+			n->cond = Get<Expr>(); n->body = Get<Stmt>();
+			return n;
+		}
+		case NT_DoLoop: { auto n = DoLoop::New(loc); n->cond = Get<Expr>(); n->body = Get<Stmt>(); return n; }
+		case NT_WhileLoop: { auto n = WhileLoop::New(loc); n->cond = Get<Expr>(); n->body = Get<Stmt>(); return n; }
+		case NT_Break: return Break::New(loc);
+		case NT_Continue: return Continue::New(loc);
+		case NT_If:
+		{
+			auto n = If::New(loc);
+			n->cond = Get<Expr>(); n->iftrue = Get<Stmt>(); n->iffalse = Child<Stmt>();
+			return n;
+		}
+		case NT_VarDecl:
+		{
+			auto n = VarDecl::New(loc);
+			uint8_t scope = Value<uint8_t>();
+			if (scope > static_cast<uint8_t>(VarDecl::Scope::Global))
+				throw std::runtime_error("invalid variable scope");
+			n->scope = static_cast<VarDecl::Scope>(scope);
+			n->constant = !!Value<uint8_t>();
+			for (uint32_t i = Value<uint32_t>(); i; --i)
+			{
+				std::string name = String();
+				n->decls.push_back({ name, Child<Expr>() });
+			}
+			return n;
+		}
+		case NT_FunctionDecl:
+		{
+			auto n = FunctionDecl::New(loc, String());
+			n->is_global = !!Value<uint8_t>();
+			Function(n.get());
+			return n;
+		}
+		case NT_IncludePragma: return IncludePragma::New(loc, String());
+		case NT_AppendtoPragma: return AppendtoPragma::New(loc, String());
+		case NT_Script: { auto n = Script::New(loc); Children(n->declarations); return n; }
+		default:
+			throw std::runtime_error("unknown node type");
+		}
+	}
+}
+
+void C4AulScriptCache::Init(const char *szPath, const char *szEngineVersion)
+{
+	Disable();
+	if (!szPath || !*szPath || !CreatePath(szPath))
+		return;
+	Path = szPath;
+	EngineVersion = szEngineVersion;
+	Prune(C4AulScriptCacheMaxAge);
+}
+
+void C4AulScriptCache::Disable()
+{
+	Path.clear();
+	EngineVersion.clear();
+}
+
+void C4AulScriptCache::ResetStatistics()
+{
+	ParsedCnt = LoadedCnt = 0;
+	ParseTime = LoadTime = Duration::zero();
+}
+
+void C4AulScriptCache::Prune(int32_t iMaxAge)
+{
+	if (!IsEnabled())
+		return;
+	const time_t now = time(nullptr);
+	for (DirectoryIterator i(Path.c_str()); *i; ++i)
+	{
+		int32_t max_age;
+		if (WildcardMatch("*.ocast", ::GetFilename(*i)))
+			max_age = iMaxAge;
+		else if (WildcardMatch("*.ocast.tmp", ::GetFilename(*i)))
+			max_age = std::min(iMaxAge, C4AulScriptCacheTempMaxAge);
+		else
+			continue;
+		if (FileTime(*i) < now - max_age)
+			EraseFile(*i);
+	}
+}
+
+std::unique_ptr<::aul::ast::Script> C4AulScriptCache::Parse(C4ScriptHost *host)
+{
+	auto start = std::chrono::steady_clock::now();
+	bool use_cache = IsEnabled() && host->Script.getData();
+	std::string filename;
+	if (use_cache)
+	{
+		filename = GetFilename(host);
+		if (auto script = Load(host, filename))
+		{
+			++LoadedCnt;
+			LoadTime += std::chrono::steady_clock::now() - start;
+			return script;
+		}
+	}
+
+	C4AulParse parser(host);
+	int errors = host->Engine->errCnt;
+	auto script = parser.Parse_Script(host);
+	// Only store scripts that parse cleanly so that diagnostics are repeated on every load
+	if (use_cache && host->Engine->errCnt == errors && !parser.GetWarningCount())
+		Store(host, script.get(), filename);
+	++ParsedCnt;
+	ParseTime += std::chrono::steady_clock::now() - start;
+	return script;
+}
+
+std::string C4AulScriptCache::GetFilename(C4ScriptHost *host) const
+{
+	// The parser forbids #appendto in definitions, so the same text may parse differently
+	const bool is_def = host->GetPropList() && host->GetPropList()->GetDef();
+	blake2b_state hash;
+	blake2b_init(&hash, DigestLength);
+	blake2b_update(&hash, &C4AulScriptCacheFormat, sizeof(C4AulScriptCacheFormat));
+	blake2b_update(&hash, EngineVersion.c_str(), EngineVersion.size() + 1);
+	blake2b_update(&hash, &is_def, sizeof(is_def));
+	blake2b_update(&hash, host->Script.getData(), host->Script.getLength());
+	uint8_t digest[DigestLength];
+	blake2b_final(&hash, digest, DigestLength);
+	std::string filename = Path + DirectorySeparator;
+	for (uint8_t b : digest)
+		filename += strprintf("%02x", b);
+	return filename + ".ocast";
+}
+
+std::unique_ptr<::aul::ast::Script> C4AulScriptCache::Load(C4ScriptHost *host, const std::string &filename)
+{
+	StdBuf buf;
+	if (!FileExists(filename.c_str()) || !buf.LoadFromFile(filename.c_str()))
+		return nullptr;
+	try
+	{
+		const char *script_text = host->Script.getData();
+		size_t script_length = host->Script.getLength();
+		AstReader reader(static_cast<const char *>(buf.getData()), buf.getSize(), script_text, script_length);
+		for (char c : C4AulScriptCacheMagic)
+			if (reader.Value<char>() != c)
+				return nullptr;
+		if (reader.Value<uint32_t>() != C4AulScriptCacheFormat || reader.Value<uint32_t>() != script_length)
+			return nullptr;
+		// warning state as set by #warning pragmas
+		decltype(host->enabledWarnings) warnings;
+		for (uint32_t i = reader.Value<uint32_t>(); i; --i)
+		{
+			const char *pos = reader.Loc();
+			warnings[pos] = reader.Value<uint64_t>();
+		}
+		if (warnings.empty() || warnings.begin()->first != script_text)
+			return nullptr;
+		auto script = reader.Get<::aul::ast::Script>();
+		if (!reader.AtEnd())
+			return nullptr;
+		host->enabledWarnings = std::move(warnings);
+		// Keep the entry from being pruned
+		if (FileTime(filename.c_str()) < time(nullptr) - C4AulScriptCacheRefreshAge)
+			Write(filename, buf.getData(), buf.getSize());
+		return script;
+	}
+	catch (std::runtime_error &)
+	{
+		// corrupt file: parse again and overwrite it
+		return nullptr;
+	}
+}
+
+void C4AulScriptCache::Store(C4ScriptHost *host, const ::aul::ast::Script *script, const std::string &filename)
+{
+	std::string data;
+	try
+	{
+		AstWriter writer(data, host->Script.getData(), host->Script.getLength());
+		data.append(C4AulScriptCacheMagic, sizeof(C4AulScriptCacheMagic));
+		writer.Value<uint32_t>(C4AulScriptCacheFormat);
+		writer.Value<uint32_t>(host->Script.getLength());
+		writer.Value<uint32_t>(host->enabledWarnings.size());
+		for (const auto &entry : host->enabledWarnings)
+		{
+			writer.Loc(entry.first);
+			writer.Value<uint64_t>(entry.second.to_ullong());
+		}
+		writer.Child(script);
+	}
+	catch (std::runtime_error &)
+	{
+		return;
+	}
+	Write(filename, data.data(), data.size());
+}
+
+void C4AulScriptCache::Write(const std::string &filename, const void *data, size_t size)
+{
+	// Write to a temporary file first so that concurrent instances never see partial files
+	std::string temp_filename = filename + ".tmp";
+	if (!StdBuf(data, size).SaveToFile(temp_filename.c_str()))
+		return;
+	EraseItem(filename.c_str());
+	if (!RenameItem(temp_filename.c_str(), filename.c_str()))
+		EraseItem(temp_filename.c_str());
+}
@@ -0,0 +1,58 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2016, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// Persistent cache of parsed scripts
+
+#ifndef INC_C4AulScriptCache
+#define INC_C4AulScriptCache
+
+#include <chrono>
+
+class C4ScriptHost;
+namespace aul { namespace ast { class Script; } }
+
+// Stores the syntax trees of successfully parsed scripts on disk, keyed by
+// a hash of the script text and the engine version. Bytecode itself is not
+// cached because it refers to functions and definitions that only exist
+// after linking; includes, appends and strings are resolved from the tree.
+class C4AulScriptCache
+{
+public:
+	typedef std::chrono::steady_clock::duration Duration;
+
+	void Init(const char *szPath, const char *szEngineVersion); // enable caching in the given directory
+	void Disable();
+	bool IsEnabled() const { return !Path.empty(); }
+	void ResetStatistics();
+	void Prune(int32_t iMaxAge); // erase files that weren't used within the given number of seconds
+
+	// Parse the script of the host or load the tree from the cache
+	std::unique_ptr<::aul::ast::Script> Parse(C4ScriptHost *host);
+
+	// startup timing
+	int32_t ParsedCnt{0}, LoadedCnt{0}; // number of scripts parsed / loaded from the cache
+	Duration ParseTime{0}, LoadTime{0};
+
+private:
+	std::string Path; // directory of the cache files; caching is disabled if empty
+	std::string EngineVersion;
+
+	std::string GetFilename(C4ScriptHost *host) const;
+	std::unique_ptr<::aul::ast::Script> Load(C4ScriptHost *host, const std::string &filename);
+	void Store(C4ScriptHost *host, const ::aul::ast::Script *script, const std::string &filename);
+	static void Write(const std::string &filename, const void *data, size_t size);
+};
+
+#endif
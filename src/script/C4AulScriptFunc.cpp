@@ -76,6 +76,8 @@ void C4AulScriptFunc::ClearCode()
 {
 	Code.clear();
 	PosForCode.clear();
+	LookupCaches.clear();
+	ExecCnt = 0;
 	// This function is now broken until an AddBCC call
 }
 
@@ -90,6 +92,38 @@ C4AulBCC * C4AulScriptFunc::GetCode()
 	return &Code[0];
 }
 
+void C4AulScriptFunc::TierUp()
+{
+	// Only the first instruction of each sequence is replaced, so the code keeps
+	// its length and jumps into the middle of a sequence still work.
+	for (size_t i = 0; i + 1 < Code.size(); ++i)
+	{
+		C4AulBCC &bcc = Code[i];
+		switch (Code[i + 1].bccType)
+		{
+		case AB_PROP:
+			if (bcc.bccType == AB_THIS) bcc.bccType = AB_THIS_PROP;
+			break;
+		case AB_ARRAYA:
+			if (bcc.bccType == AB_INT) bcc.bccType = AB_INT_ARRAYA;
+			break;
+		case AB_Sum:
+			if (bcc.bccType == AB_DUP) bcc.bccType = AB_DUP_Sum;
+			break;
+		case AB_Sub:
+			if (bcc.bccType == AB_DUP) bcc.bccType = AB_DUP_Sub;
+			break;
+		case AB_LessThan_CONDN:
+			if (bcc.bccType == AB_DUP) bcc.bccType = AB_DUP_LessThan_CONDN;
+			break;
+		case AB_GreaterThan_CONDN:
+			if (bcc.bccType == AB_DUP) bcc.bccType = AB_DUP_GreaterThan_CONDN;
+			break;
+		default: break;
+		}
+	}
+}
+
 C4Value C4AulScriptFunc::Exec(C4PropList * p, C4Value pPars[], bool fPassErrors)
 {
 	return AulExec.Exec(this, p, pPars, fPassErrors);
@@ -67,7 +67,36 @@ enum C4AulBCCType : int
 	AB_BitXOr,  // ^
 	AB_BitOr, // |
 
-	AB_CALL,    // direct object call
+// superinstructions joined by the compiler
+	AB_STACK_Inc, // ++ on a stack value without pushing it
+	AB_STACK_Dec, // -- on a stack value without pushing it
+	AB_Sum_INT,   // + constant
+	AB_Sub_INT,   // - constant
+	AB_Mul_INT,   // * constant
+	AB_LessThan_INT,  // < constant
+	AB_LessThanEqual_INT, // <= constant
+	AB_GreaterThan_INT, // > constant
+	AB_GreaterThanEqual_INT,  // >= constant
+	AB_Equal_INT, // == constant
+	AB_NotEqual_INT,  // != constant
+	AB_LessThan_CONDN,  // < and conditional jump (negated, pops both operands)
+	AB_LessThanEqual_CONDN, // <= and conditional jump
+	AB_GreaterThan_CONDN, // > and conditional jump
+	AB_GreaterThanEqual_CONDN,  // >= and conditional jump
+	AB_Equal_CONDN, // == and conditional jump
+	AB_NotEqual_CONDN,  // != and conditional jump
+
+	// Written over the first instruction of a sequence when a function gets hot.
+	// They run the whole sequence if the operands have the expected types and
+	// fall back to the first instruction otherwise.
+	AB_THIS_PROP, // this.key
+	AB_INT_ARRAYA, // array access with constant index
+	AB_DUP_Sum, // + stack value
+	AB_DUP_Sub, // - stack value
+	AB_DUP_LessThan_CONDN, // < stack value and conditional jump
+	AB_DUP_GreaterThan_CONDN, // > stack value and conditional jump
+
+	AB_CALL,   // direct object call
 	AB_CALLFS,  // failsafe direct call
 	AB_STACK,   // push nulls / pop
 	AB_INT,     // constant: int
@@ -97,6 +126,7 @@ class C4AulBCC
 {
 public:
 	C4AulBCCType bccType{AB_EOFN}; // chunk type
+	uint32_t LookupCache{0}; // one-based index into the lookup caches of the function; zero if none yet
 	union
 	{
 		intptr_t X;
@@ -116,11 +146,12 @@ public:
 	{
 		DecRef();
 		bccType = from.bccType;
+		LookupCache = 0;
 		Par = from.Par;
 		IncRef();
 		return *this;
 	}
-	C4AulBCC(C4AulBCC && from): bccType(from.bccType), Par(from.Par)
+	C4AulBCC(C4AulBCC && from): bccType(from.bccType), LookupCache(from.LookupCache), Par(from.Par)
 	{
 		from.bccType = AB_EOFN;
 	}
@@ -128,6 +159,7 @@ public:
 	{
 		DecRef();
 		bccType = from.bccType;
+		LookupCache = from.LookupCache;
 		Par = from.Par;
 		from.bccType = AB_EOFN;
 		return *this;
@@ -186,6 +218,7 @@ protected:
 	void DumpByteCode();
 	std::vector<C4AulBCC> Code;
 	std::vector<const char *> PosForCode;
+	std::vector<C4PropertyCache> LookupCaches; // property lookup caches of the byte code, assigned on first execution
 	int ParCount;
 	C4V_Type ParType[C4AUL_MAX_Par]; // parameter types
 
@@ -218,6 +251,18 @@ public:
 
 	int GetLineOfCode(C4AulBCC * bcc);
 	C4AulBCC * GetCode();
+	uint32_t ExecCnt{0}; // number of calls and loop iterations, counted until the function is tiered up
+	void TierUp(); // rewrite common sequences of the code with specialized instructions
+	void CountExec(uint32_t iThreshold) { if (iThreshold && ++ExecCnt == iThreshold) TierUp(); }
+	C4PropertyCache & GetLookupCache(C4AulBCC * bcc)
+	{
+		if (!bcc->LookupCache)
+		{
+			LookupCaches.emplace_back();
+			bcc->LookupCache = LookupCaches.size();
+		}
+		return LookupCaches[bcc->LookupCache - 1];
+	}
 
 	uint32_t tProfileTime; // internally set by profiler
 
@@ -47,7 +47,7 @@ C4Effect::C4Effect(C4Effect **ppEffectList, C4String *szName, int32_t iPrio, int
 	// assign values
 	iPriority = 0; // effect is not yet valid; some callbacks to other effects are done before
 	iInterval = iTimerInterval;
-	iTime = 0;
+	iStartTicks = 0;
 	CommandTarget.SetPropList(pCmdTarget);
 	AcquireNumber();
 	Register(ppEffectList, iPrio);
@@ -61,7 +61,7 @@ C4Effect::C4Effect(C4Effect **ppEffectList, C4PropList * prototype, int32_t iPri
 	// assign values
 	iPriority = 0; // effect is not yet valid; some callbacks to other effects are done before
 	iInterval = iTimerInterval;
-	iTime = 0;
+	iStartTicks = 0;
 	CommandTarget.Set0();
 	AcquireNumber();
 	Register(ppEffectList, iPrio);
@@ -70,6 +70,13 @@ C4Effect::C4Effect(C4Effect **ppEffectList, C4PropList * prototype, int32_t iPri
 
 void C4Effect::Register(C4Effect **ppEffectList, int32_t iPrio)
 {
+	// join the timer of the list, keeping the effect time if the effect is moved from another list
+	int32_t iTime = GetTime();
+	if (*ppEffectList)
+		ListTimer = (*ppEffectList)->ListTimer;
+	else
+		ListTimer = std::make_shared<C4EffectListTimer>();
+	SetTime(iTime);
 	// get effect target
 	C4Effect *pCheck, *pPrev = *ppEffectList;
 	if (pPrev && Abs(pPrev->iPriority) < iPrio)
@@ -156,7 +163,7 @@ C4Effect * C4Effect::Init(C4PropList *pForObj, int32_t iPrio, const C4Value &rVa
 C4Effect::C4Effect()
 {
 	// defaults
-	iPriority=iTime=iInterval=0;
+	iPriority=iInterval=iStartTicks=0;
 	CommandTarget.Set0();
 	pNext = nullptr;
 }
@@ -205,6 +212,30 @@ void C4Effect::ClearPointers(C4PropList *pObj)
 void C4Effect::SetDead()
 {
 	iPriority = 0;
+	// deleted in the next execution
+	ScheduleListWalk();
+}
+
+void C4Effect::SetTime(int32_t iTime)
+{
+	iStartTicks = (ListTimer ? ListTimer->iTicks : 0) - iTime;
+	ScheduleListWalk();
+}
+
+void C4Effect::SetInterval(int32_t iToInterval)
+{
+	iInterval = iToInterval;
+	ScheduleListWalk();
+}
+
+int32_t C4Effect::GetNextTimerTick() const
+{
+	if (!iInterval || !ListTimer) return INT32_MAX;
+	// timers are called whenever the effect time is a nonzero multiple of the interval
+	int64_t iIntv = Abs<int64_t>(iInterval), iTime = GetTime();
+	int64_t iNextTime = iTime + iIntv - ((iTime % iIntv) + iIntv) % iIntv;
+	if (!iNextTime) iNextTime = iIntv;
+	return std::min<int64_t>(ListTimer->iTicks + iNextTime - iTime, INT32_MAX);
 }
 
 C4Effect *C4Effect::Get(const char *szName, int32_t iIndex, int32_t iMaxPriority)
@@ -296,13 +327,18 @@ C4Effect* C4Effect::Check(const char *szCheckEffect, int32_t iPrio, int32_t iTim
 
 void C4Effect::Execute(C4Effect **ppEffectList)
 {
+	if (!*ppEffectList) return;
 	// advance all effect timers first; then do execution
 	// this prevents a possible endless loop if timers register into the same effect list with interval 1 while it is being executed
-	for (C4Effect *pEffect = *ppEffectList; pEffect; pEffect = pEffect->pNext)
-	{
-		// ignore dead status; adjusting their time doesn't hurt
-		++pEffect->iTime;
-	}
+	// effect times are relative to the list ticks, so this advances dead effects as well, which doesn't hurt
+	// keep the timer alive in case all effects get deleted
+	std::shared_ptr<C4EffectListTimer> pTimer = (*ppEffectList)->ListTimer;
+	int32_t iTicks = ++pTimer->iTicks;
+	// no timer due and nothing changed since the last execution: nothing to do
+	if (iTicks < pTimer->iNextDue) return;
+	// changes done during the timer calls lower this again
+	pTimer->iNextDue = INT32_MAX;
+	int32_t iNextDue = INT32_MAX;
 	// get effect list
 	// execute all effects not marked as dead
 	C4Effect *pEffect = *ppEffectList, **ppPrevEffect=ppEffectList;
@@ -321,23 +357,26 @@ void C4Effect::Execute(C4Effect **ppEffectList)
 		else
 		{
 			// check timer execution
-			if (pEffect->iInterval && !(pEffect->iTime % pEffect->iInterval) && pEffect->iTime)
+			int32_t iTime = pEffect->GetTime();
+			if (pEffect->iInterval && !(iTime % pEffect->iInterval) && iTime)
 			{
-				if (pEffect->CallTimer(pEffect->iTime) == C4Fx_Execute_Kill)
+				if (pEffect->CallTimer(iTime) == C4Fx_Execute_Kill)
 				{
 					// safety: this class got deleted!
-					if (pEffect->Target && !pEffect->Target->Status) return;
+					if (pEffect->Target && !pEffect->Target->Status) { pTimer->iNextDue = 0; return; }
 					// timer function decided to finish it
 					pEffect->Kill();
 				}
 				// safety: this class got deleted!
-				if (pEffect->Target && !pEffect->Target->Status) return;
+				if (pEffect->Target && !pEffect->Target->Status) { pTimer->iNextDue = 0; return; }
 			}
+			iNextDue = std::min(iNextDue, pEffect->GetNextTimerTick());
 			// next effect
 			ppPrevEffect = &pEffect->pNext;
 			pEffect = pEffect->pNext;
 		}
 	}
+	pTimer->iNextDue = std::min(pTimer->iNextDue, iNextDue);
 }
 
 void C4Effect::Kill()
@@ -546,8 +585,15 @@ void C4Effect::CompileFunc(StdCompiler *pComp, C4PropList * Owner, C4ValueNumber
 	// read priority
 	pComp->Value(iPriority); pComp->Separator();
 	// read time and intervall
+	int32_t iTime = GetTime();
 	pComp->Value(iTime); pComp->Separator();
 	pComp->Value(iInterval); pComp->Separator();
+	if (pComp->isDeserializer())
+	{
+		// loaded effects start with a fresh list timer
+		ListTimer = std::make_shared<C4EffectListTimer>();
+		iStartTicks = -iTime;
+	}
 	// read object number
 	// FIXME: replace with this when savegame compat breaks for other reasons
 	// pComp->Value(mkParAdapt(CommandTarget, numbers));
@@ -592,6 +638,8 @@ void C4Effect::CompileFunc(StdCompiler *pComp, C4PropList * Owner, C4ValueNumber
 	if (!fNext) return;
 	// read next
 	pComp->Value(mkParAdapt(mkPtrAdaptNoNull(pNext), Owner, numbers));
+	// all fresh list timers are at tick zero, so the following effects' timer can be shared
+	if (pComp->isDeserializer()) ListTimer = pNext->ListTimer;
 	// denumeration and callback assignment will be done later
 }
 
@@ -609,12 +657,12 @@ void C4Effect::SetPropertyByS(C4String * k, const C4Value & to)
 				return;
 			case P_Priority:
 				throw C4AulExecError("effect: Priority is readonly");
-			case P_Interval: iInterval = to.getInt(); return;
+			case P_Interval: SetInterval(to.getInt()); return;
 			case P_CommandTarget:
 				throw C4AulExecError("effect: CommandTarget is readonly");
 			case P_Target:
 				throw C4AulExecError("effect: Target is readonly");
-			case P_Time: iTime = to.getInt(); return;
+			case P_Time: SetTime(to.getInt()); return;
 			case P_Prototype:
 				throw new C4AulExecError("effect: Prototype is readonly");
 		}
@@ -632,12 +680,12 @@ void C4Effect::ResetProperty(C4String * k)
 				throw C4AulExecError("effect: Name has to be a nonempty string");
 			case P_Priority:
 				throw C4AulExecError("effect: Priority is readonly");
-			case P_Interval: iInterval = 0; return;
+			case P_Interval: SetInterval(0); return;
 			case P_CommandTarget:
 				throw C4AulExecError("effect: CommandTarget is readonly");
 			case P_Target:
 				throw C4AulExecError("effect: Target is readonly");
-			case P_Time: iTime = 0; return;
+			case P_Time: SetTime(0); return;
 			case P_Prototype:
 				throw new C4AulExecError("effect: Prototype is readonly");
 		}
@@ -656,7 +704,7 @@ bool C4Effect::GetPropertyByS(const C4String *k, C4Value *pResult) const
 			case P_Interval: *pResult = C4VInt(iInterval); return true;
 			case P_CommandTarget: *pResult = CommandTarget; return true;
 			case P_Target: *pResult = C4Value(Target); return true;
-			case P_Time: *pResult = C4VInt(iTime); return true;
+			case P_Time: *pResult = C4VInt(GetTime()); return true;
 		}
 	}
 	return C4PropListNumbered::GetPropertyByS(k, pResult);
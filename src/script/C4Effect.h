@@ -26,6 +26,8 @@
 
 #include "script/C4PropList.h"
 
+#include <memory>
+
 // callback return values
 #define C4Fx_OK                      0 // generic standard behaviour for all effect callbacks
 
@@ -65,16 +67,26 @@
 #define C4Fx_FireParticle1   "Fire"
 #define C4Fx_FireParticle2   "Fire2"
 
+// timer state shared by all effects of one effect list
+// effect times are derived from the number of list executions, so the list needs to be walked only if a timer is due
+struct C4EffectListTimer
+{
+	int32_t iTicks = 0;   // number of executions of the effect list
+	int32_t iNextDue = 0; // tick at which the list has to be walked next
+};
+
 // generic object effect
 class C4Effect: public C4PropListNumbered
 {
 public:
 	int32_t iPriority;          // effect priority for sorting into effect list; -1 indicates a dead effect
-	int32_t iTime, iInterval;  // effect time; effect callback intervall
+	int32_t iInterval;          // effect callback intervall
 
 	C4Effect *pNext;        // next effect in linked list
 
 protected:
+	std::shared_ptr<C4EffectListTimer> ListTimer; // timer of the effect list this effect is in
+	int32_t iStartTicks;   // list tick at which the effect time was zero
 	C4Value CommandTarget; // target object for script callbacks - if deleted, the effect is removed without callbacks
 	C4PropList * Target; // target the effect is contained in
 	// presearched callback functions for faster calling
@@ -106,6 +118,10 @@ public:
 	void Denumerate(C4ValueNumbers *) override; // numbers to object pointers
 	void ClearPointers(C4PropList *pObj); // clear all pointers to object - may kill some effects w/o callback, because the callback target is lost
 
+	int32_t GetTime() const { return ListTimer ? ListTimer->iTicks - iStartTicks : 0; } // effect time
+	void SetTime(int32_t iTime);
+	void SetInterval(int32_t iToInterval);
+
 	void SetDead();                      // mark effect to be removed in next execution cycle
 	bool IsDead() { return !iPriority; } // return whether effect is to be removed
 	void FlipActive() { iPriority*=-1; } // alters activation status
@@ -141,6 +157,8 @@ public:
 	C4ValueArray * GetProperties() const override;
 
 protected:
+	void ScheduleListWalk() { if (ListTimer) ListTimer->iNextDue = 0; } // make the next Execute walk the list
+	int32_t GetNextTimerTick() const; // list tick of the next timer call
 	void TempRemoveUpperEffects(bool fTempRemoveThis, C4Effect **ppLastRemovedEffect); // temp remove all effects with higher priority
 	void TempReaddUpperEffects(C4Effect *pLastReaddEffect); // temp remove all effects with higher priority
 };
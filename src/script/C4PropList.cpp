@@ -22,6 +22,71 @@
 #include "object/C4GameObjects.h"
 #include "script/C4Aul.h"
 
+C4Value ** C4PropListRefSet::GetPlaceFor(const C4Value * pRef) const
+{
+	unsigned int iMask = Capacity - 1, i = Hash(pRef) & iMask;
+	while (Table[i] && Table[i] != pRef)
+		i = (i + 1) & iMask;
+	return &Table[i];
+}
+
+void C4PropListRefSet::Rehash(unsigned int iNewCapacity)
+{
+	// the inline storage overlaps the table pointer, so save it first
+	C4Value * OInline[InlineCapacity];
+	C4Value ** OTable = Table;
+	unsigned int OCapacity = Capacity;
+	if (!Capacity)
+	{
+		std::copy(Inline, Inline + Size, OInline);
+		OTable = OInline;
+		OCapacity = Size;
+	}
+	Table = new C4Value * [iNewCapacity]();
+	Capacity = iNewCapacity;
+	for (unsigned int i = 0; i < OCapacity; ++i)
+		if (OTable[i])
+			*GetPlaceFor(OTable[i]) = OTable[i];
+	if (OTable != OInline) delete [] OTable;
+}
+
+void C4PropListRefSet::InsertIntoTable(C4Value * pRef)
+{
+	// keep the table at most half full
+	if ((Size + 1) * 2 > Capacity)
+		Rehash(Capacity ? Capacity * 2 : InlineCapacity * 4);
+	*GetPlaceFor(pRef) = pRef;
+	++Size;
+}
+
+size_t C4PropListRefSet::EraseFromTable(C4Value * pRef)
+{
+	unsigned int iMask = Capacity - 1;
+	C4Value ** pPlace = GetPlaceFor(pRef);
+	if (!*pPlace) return 0;
+	// move back following entries which would not be found anymore after the hole
+	unsigned int i = pPlace - Table, j = i;
+	while (Table[j = (j + 1) & iMask])
+	{
+		unsigned int k = Hash(Table[j]) & iMask;
+		if (((j - k) & iMask) >= ((j - i) & iMask))
+		{
+			Table[i] = Table[j];
+			i = j;
+		}
+	}
+	Table[i] = nullptr;
+	// back to inline storage once empty
+	if (!--Size) clear();
+	return 1;
+}
+
+size_t C4PropListRefSet::count(const C4Value * pRef) const
+{
+	if (Capacity) return !!*GetPlaceFor(pRef);
+	return std::find(Inline, Inline + Size, pRef) != Inline + Size;
+}
+
 void C4PropList::AddRef(C4Value *pRef)
 {
 	assert(Refs.count(pRef) == 0);
@@ -286,6 +351,7 @@ C4PropListStatic *C4PropList::FreezeAndMakeStaticRecursively(std::vector<C4Value
 		// Make self static by creating a copy and replacing all references
 		this_static = NewStatic(GetPrototype(), parent, key);
 		this_static->Properties.Swap(&Properties); // grab properties
+		InvalidateLookupCaches();
 		this_static->Status = Status;
 		RefSet pre_freeze_refs{Refs}; // copy to avoid iterator validity headaches
 		C4Value holder = C4VPropList(this); // add another reference to prevent premature deletion
@@ -328,10 +394,12 @@ void C4PropList::Denumerate(C4ValueNumbers * numbers)
 	}
 	prototype.Denumerate(numbers);
 	RemoveCyclicPrototypes();
+	InvalidateLookupCaches();
 }
 
 C4PropList::~C4PropList()
 {
+	InvalidateLookupCaches();
 	for (C4Value * Ref : Refs)
 	{
 		// Manually kill references so DelRef doesn't destroy us again
@@ -368,6 +436,7 @@ void C4PropList::CompileFunc(StdCompiler *pComp, C4ValueNumbers * numbers)
 	bool oldFormat = false;
 	// constant proplists are not serialized to savegames, but recreated from the game data instead
 	assert(!constant);
+	if (pComp->isDeserializer()) InvalidateLookupCaches();
 	if (pComp->isDeserializer() && pComp->hasNaming())
 	{
 		// backwards compat to savegames and scenarios before 5.5
@@ -783,6 +852,66 @@ C4AulFunc * C4PropList::GetFunc(C4String * k) const
 	return nullptr;
 }
 
+bool C4PropList::GetPropertyByS(const C4String * k, C4Value *pResult, C4PropertyCache &cache) const
+{
+	// Objects and effects may override predefined properties, and the prototype isn't in the property table
+	bool fPredefined = k >= &Strings.P[0] && k < &Strings.P[P_LAST];
+	if ((fPredefined && IsNumbered()) || k == &Strings.P[P_Prototype])
+		return GetPropertyByS(k, pResult);
+	const C4Property & p = Properties.Get(k);
+	if (p)
+	{
+		*pResult = p.Value;
+		return true;
+	}
+	C4PropList * pProto = GetPrototype();
+	if (!pProto)
+		return false;
+	if (cache.Epoch != LookupEpoch || cache.Prototype != pProto)
+		if (!LookupInPrototypes(k, cache, fPredefined))
+			return pProto->GetPropertyByS(k, pResult);
+	if (!cache.Value)
+		return false;
+	*pResult = *cache.Value;
+	return true;
+}
+
+C4AulFunc * C4PropList::GetFunc(C4String * k, C4PropertyCache &cache) const
+{
+	assert(k);
+	const C4Property & p = Properties.Get(k);
+	if (p)
+		return p.Value.getFunction();
+	C4PropList * pProto = GetPrototype();
+	if (!pProto)
+		return nullptr;
+	if (cache.Epoch != LookupEpoch || cache.Prototype != pProto)
+		LookupInPrototypes(k, cache, false);
+	return cache.Value ? cache.Value->getFunction() : nullptr;
+}
+
+bool C4PropList::LookupInPrototypes(const C4String * k, C4PropertyCache &cache, bool fPredefined) const
+{
+	const C4Value * pValue = nullptr;
+	for (const C4PropList * it = GetPrototype(); it; it = it->GetPrototype())
+	{
+		// can't cache dynamic properties
+		if (fPredefined && it->IsNumbered())
+			return false;
+		it->lookup_cached = true;
+		const C4Property & p = it->Properties.Get(k);
+		if (p)
+		{
+			pValue = &p.Value;
+			break;
+		}
+	}
+	cache.Prototype = GetPrototype();
+	cache.Value = pValue;
+	cache.Epoch = LookupEpoch;
+	return true;
+}
+
 C4AulFunc * C4PropList::GetFunc(const char * s) const
 {
 	assert(s);
@@ -947,6 +1076,7 @@ void C4PropList::SetPropertyByS(C4String * k, const C4Value & to)
 			if(it == this)
 				throw C4AulExecError("Trying to create cyclic prototype structure");
 		prototype.SetPropList(newpt);
+		InvalidateLookupCaches();
 	}
 	else if (Properties.Has(k))
 	{
@@ -955,6 +1085,7 @@ void C4PropList::SetPropertyByS(C4String * k, const C4Value & to)
 	else
 	{
 		Properties.Add(C4Property(k, to));
+		InvalidateLookupCaches();
 	}
 }
 
@@ -964,6 +1095,7 @@ void C4PropList::ResetProperty(C4String * k)
 		prototype.Set0();
 	else
 		Properties.Remove(k);
+	InvalidateLookupCaches();
 }
 
 void C4PropList::Iterator::Init()
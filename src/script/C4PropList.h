@@ -30,12 +30,73 @@
 All PropLists can be destroyed while there are still C4Values referencing them, though
 Definitions do not get destroyed during the game. So always check for nullpointers.
 
-The unordered_set Refs is used to change all C4Values referencing the destroyed Proplist to contain nil instead.
+The set Refs is used to change all C4Values referencing the destroyed Proplist to contain nil instead.
 Objects are also cleaned up via various ClearPointer functions.
 The list is also used as a reference count to remove unused Proplists.
 The exception are C4PropListNumbered and C4Def, which have implicit references
 from C4GameObjects, C4Object and C4DefList. They have to be destroyed when loosing that reference.*/
 
+// Set of the C4Values referencing a proplist
+// Most proplists are only referenced a few times, so small sets are stored inline
+// and only larger sets use an open addressing hash table
+class C4PropListRefSet
+{
+	static const unsigned int InlineCapacity = 4;
+	unsigned int Size{0};
+	unsigned int Capacity{0}; // size of the hash table, or zero while the inline storage is used
+	union
+	{
+		C4Value * Inline[InlineCapacity];
+		C4Value ** Table;
+	};
+	static unsigned int Hash(const C4Value * pRef) { return static_cast<unsigned int>(reinterpret_cast<uintptr_t>(pRef) >> 4) * 2654435761u; }
+	C4Value ** GetPlaceFor(const C4Value * pRef) const;
+	void Rehash(unsigned int iNewCapacity);
+	void InsertIntoTable(C4Value * pRef);
+	size_t EraseFromTable(C4Value * pRef);
+public:
+	class iterator
+	{
+		C4Value * const * p, * const * end;
+		void Skip() { while (p != end && !*p) ++p; }
+	public:
+		iterator(C4Value * const * p, C4Value * const * end): p(p), end(end) { Skip(); }
+		C4Value * operator * () const { return *p; }
+		iterator & operator ++ () { ++p; Skip(); return *this; }
+		bool operator != (const iterator & b) const { return p != b.p; }
+	};
+
+	C4PropListRefSet() = default;
+	C4PropListRefSet(const C4PropListRefSet & b) { for (C4Value * pRef : b) insert(pRef); }
+	C4PropListRefSet & operator = (const C4PropListRefSet &) = delete;
+	~C4PropListRefSet() { clear(); }
+
+	void insert(C4Value * pRef)
+	{
+		if (!Capacity && Size < InlineCapacity)
+			Inline[Size++] = pRef;
+		else
+			InsertIntoTable(pRef);
+	}
+	size_t erase(C4Value * pRef)
+	{
+		if (Capacity) return EraseFromTable(pRef);
+		for (unsigned int i = 0; i < Size; ++i)
+			if (Inline[i] == pRef)
+			{
+				Inline[i] = Inline[--Size];
+				return 1;
+			}
+		return 0;
+	}
+	size_t count(const C4Value * pRef) const;
+	size_t size() const { return Size; }
+	bool empty() const { return !Size; }
+	void clear() { if (Capacity) delete [] Table; Capacity = Size = 0; }
+	iterator begin() const { return Capacity ? iterator(Table, Table + Capacity) : iterator(Inline, Inline + Size); }
+	iterator end() const { return Capacity ? iterator(Table + Capacity, Table + Capacity) : iterator(Inline + Size, Inline + Size); }
+};
+
 class C4Property
 {
 public:
@@ -63,11 +124,19 @@ inline bool C4Set<C4Property>::Equals(const C4Property &a, const C4Property &b)
 	return a.Key == b.Key;
 }
 
+// Cache for repeated lookups of one key through the prototype chain, used by the script byte code
+struct C4PropertyCache
+{
+	const C4PropList * Prototype{nullptr}; // prototype of the proplists the entry is valid for
+	const C4Value * Value{nullptr};        // value found in the prototype chain; nullptr if there is none
+	uint32_t Epoch{0};                     // C4PropList::LookupEpoch when the entry was made; zero if unused
+};
+
 class C4PropListNumbered;
 class C4PropList
 {
 public:
-	void Clear() { constant = false; Properties.Clear(); prototype.Set0(); }
+	void Clear() { constant = false; Properties.Clear(); prototype.Set0(); InvalidateLookupCaches(); }
 	virtual const char *GetName() const;
 	virtual void SetName (const char *NewName = nullptr);
 	virtual void SetOnFire(bool OnFire) { }
@@ -110,6 +179,9 @@ public:
 	{ return GetFunc(&Strings.P[k]); }
 	C4AulFunc * GetFunc(C4String * k) const;
 	C4AulFunc * GetFunc(const char * k) const;
+	// same as above, but the prototype chain walk is skipped while the cache is valid
+	bool GetPropertyByS(const C4String *k, C4Value *pResult, C4PropertyCache &cache) const;
+	C4AulFunc * GetFunc(C4String * k, C4PropertyCache &cache) const;
 	C4String * EnumerateOwnFuncs(C4String * prev = nullptr) const;
 	C4Value Call(C4PropertyName k, C4AulParSet *pPars=nullptr, bool fPassErrors=false)
 	{ return Call(&Strings.P[k], pPars, fPassErrors); }
@@ -162,11 +234,16 @@ protected:
 private:
 	void AddRef(C4Value *pRef);
 	void DelRef(C4Value *pRef);
-	typedef std::unordered_set<C4Value *> RefSet;
+	bool LookupInPrototypes(const C4String *k, C4PropertyCache &cache, bool fPredefined) const;
+	// any change to a proplist that cached lookups went through invalidates all caches
+	void InvalidateLookupCaches() { if (lookup_cached && !++LookupEpoch) LookupEpoch = 1; }
+	typedef C4PropListRefSet RefSet;
 	RefSet Refs;
 	C4Set<C4Property> Properties;
 	C4Value prototype;
 	bool constant{false}; // if true, this proplist is not changeable
+	mutable bool lookup_cached{false}; // if true, lookup caches depend on this proplist
+	static uint32_t LookupEpoch;
 	friend class C4Value;
 	friend class C4ScriptHost;
 public:
@@ -27,6 +27,7 @@
 #ifdef _DEBUG
 C4Set<C4PropList *> C4PropList::PropLists;
 #endif
+uint32_t C4PropList::LookupEpoch = 1;
 C4Set<C4PropListNumbered *> C4PropListNumbered::PropLists;
 C4Set<C4PropListScript *> C4PropListScript::PropLists;
 std::vector<C4PropListNumbered *> C4PropListNumbered::ShelvedPropLists;
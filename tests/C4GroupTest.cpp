@@ -0,0 +1,171 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2019, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include "c4group/C4Group.h"
+
+#include <gtest/gtest.h>
+
+class C4GroupTest : public ::testing::Test
+{
+protected:
+	const char *filename = "C4GroupTest.ocd";
+	std::map<std::string, std::string> contents, child_contents;
+
+	void SetUp() override
+	{
+		// text compresses well, noise does not
+		std::string text, noise;
+		for (int i = 0; i < 2000; ++i)
+			text += FormatString("Line %d\n", i).getData();
+		uint32_t seed = 1;
+		for (int i = 0; i < 10000; ++i)
+			noise += char((seed = seed * 1103515245 + 12345) >> 24);
+		contents = { { "Text.txt", text }, { "Noise.bin", noise }, { "Empty.txt", "" } };
+		child_contents = { { "Inner.txt", text.substr(0, 500) }, { "Inner.bin", noise.substr(0, 500) } };
+
+		EraseItem(filename);
+		C4Group group;
+		ASSERT_TRUE(group.Open(filename, true));
+		for (auto &entry : contents)
+		{
+			StdBuf buffer;
+			buffer.Copy(entry.second.data(), entry.second.size());
+			ASSERT_TRUE(group.Add(entry.first.c_str(), buffer, false, true));
+		}
+		C4Group child;
+		ASSERT_TRUE(child.OpenAsChild(&group, "Child.ocd", false, true));
+		for (auto &entry : child_contents)
+		{
+			StdBuf buffer;
+			buffer.Copy(entry.second.data(), entry.second.size());
+			ASSERT_TRUE(child.Add(entry.first.c_str(), buffer, false, true));
+		}
+		ASSERT_TRUE(child.Close());
+		ASSERT_TRUE(group.Close());
+	}
+
+	void TearDown() override
+	{
+		EraseItem(filename);
+	}
+
+	void Convert(bool seekable)
+	{
+		C4Group group;
+		ASSERT_TRUE(group.Open(filename));
+		ASSERT_TRUE(group.SetSeekable(seekable));
+		ASSERT_TRUE(group.Close());
+	}
+
+	void ExpectEntry(C4Group &group, const std::string &name, const std::string &expected)
+	{
+		SCOPED_TRACE(name);
+		StdBuf buffer;
+		ASSERT_TRUE(group.LoadEntry(name.c_str(), &buffer));
+		EXPECT_EQ(expected, std::string(static_cast<const char *>(buffer.getData()), buffer.getSize()));
+	}
+
+	// Reads all entries against the order in the file, switching between mother and child
+	void ExpectContents(int version)
+	{
+		C4Group group;
+		ASSERT_TRUE(group.Open(filename));
+		EXPECT_EQ(version, group.GetHeader().Ver2);
+		for (auto entry = contents.rbegin(); entry != contents.rend(); ++entry)
+			ExpectEntry(group, entry->first, entry->second);
+		C4Group child;
+		ASSERT_TRUE(child.OpenAsChild(&group, "Child.ocd"));
+		EXPECT_EQ(version, child.GetHeader().Ver2);
+		for (auto entry = child_contents.rbegin(); entry != child_contents.rend(); ++entry)
+		{
+			ExpectEntry(child, entry->first, entry->second);
+			ExpectEntry(group, "Text.txt", contents["Text.txt"]);
+		}
+	}
+};
+
+TEST_F(C4GroupTest, ConvertFormats)
+{
+	ExpectContents(C4GroupFileVer2);
+	Convert(true);
+	ExpectContents(C4GroupFileVer2Seekable);
+	Convert(false);
+	ExpectContents(C4GroupFileVer2);
+}
+
+TEST_F(C4GroupTest, ModifySeekable)
+{
+	Convert(true);
+	{
+		C4Group group;
+		ASSERT_TRUE(group.Open(filename));
+		EXPECT_TRUE(group.IsSeekable());
+		ASSERT_TRUE(group.Delete("Empty.txt"));
+		StdBuf buffer;
+		buffer.Copy("added", 5);
+		ASSERT_TRUE(group.Add("Added.txt", buffer, false, true));
+		ASSERT_TRUE(group.Close());
+	}
+	contents.erase("Empty.txt");
+	contents["Added.txt"] = "added";
+	ExpectContents(C4GroupFileVer2Seekable);
+}
+
+TEST_F(C4GroupTest, EntryView)
+{
+	// Stored entries of seekable groups are mapped, everything else is loaded
+	for (bool seekable : { false, true })
+	{
+		Convert(seekable);
+		C4Group group, child;
+		ASSERT_TRUE(group.Open(filename));
+		ASSERT_TRUE(child.OpenAsChild(&group, "Child.ocd"));
+		C4GroupEntryView text, noise, inner;
+		ASSERT_TRUE(group.LoadEntryView("Text.txt", &text));
+		ASSERT_TRUE(group.LoadEntryView("Noise.bin", &noise));
+		ASSERT_TRUE(child.LoadEntryView("Inner.bin", &inner));
+		EXPECT_FALSE(text.isMapped());
+		EXPECT_EQ(seekable, noise.isMapped());
+		EXPECT_EQ(seekable, inner.isMapped());
+		EXPECT_EQ(contents["Text.txt"], std::string(reinterpret_cast<const char *>(text.getData()), text.getSize()));
+		EXPECT_EQ(contents["Noise.bin"], std::string(reinterpret_cast<const char *>(noise.getData()), noise.getSize()));
+		EXPECT_EQ(child_contents["Inner.bin"], std::string(reinterpret_cast<const char *>(inner.getData()), inner.getSize()));
+		// Views stay valid after the group is closed
+		child.Close();
+		group.Close();
+		EXPECT_EQ(contents["Noise.bin"], std::string(reinterpret_cast<const char *>(noise.getData()), noise.getSize()));
+	}
+}
+
+TEST_F(C4GroupTest, CorruptEntrySize)
+{
+	// An unpacked size that deflate can't produce is rejected instead of allocated
+	Convert(true);
+	StdBuf file;
+	ASSERT_TRUE(file.LoadFromFile(filename));
+	std::string data(static_cast<const char *>(file.getData()), file.getSize());
+	size_t name_pos = data.rfind(std::string("Text.txt", sizeof("Text.txt")));
+	ASSERT_NE(std::string::npos, name_pos);
+	C4GroupEntryCore core;
+	ASSERT_LE(name_pos + sizeof(core), data.size());
+	memcpy(&core, &data[name_pos], sizeof(core));
+	ASSERT_TRUE(core.Packed);
+	core.Size = std::numeric_limits<int32_t>::max();
+	memcpy(&data[name_pos], &core, sizeof(core));
+	ASSERT_TRUE(StdBuf(data.data(), data.size()).SaveToFile(filename));
+	C4Group group;
+	EXPECT_FALSE(group.Open(filename));
+}
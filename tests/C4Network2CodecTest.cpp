@@ -0,0 +1,92 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2019, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include "network/C4Network2Codec.h"
+
+#include <gtest/gtest.h>
+
+class C4Network2CodecTest : public ::testing::Test
+{
+protected:
+	std::string text, noise;
+
+	void SetUp() override
+	{
+		for (int i = 0; i < 5000; ++i)
+			text += FormatString("Control %d\n", i % 100).getData();
+		uint32_t seed = 1;
+		for (int i = 0; i < 10000; ++i)
+			noise += char((seed = seed * 1103515245 + 12345) >> 24);
+	}
+};
+
+TEST_F(C4Network2CodecTest, Negotiation)
+{
+	EXPECT_TRUE(C4Network2Codecs::IsAvailable(NCC_Zlib));
+	EXPECT_EQ(NCC_None, C4Network2Codecs::ChooseFast(1u << NCC_None | 1u << NCC_Zlib));
+	EXPECT_EQ(NCC_Zlib, C4Network2Codecs::ChooseStream(""));
+	EXPECT_EQ(NCC_Zlib, C4Network2Codecs::ChooseStream("zlib, bzip2"));
+	EXPECT_EQ(C4Network2Codecs::IsAvailable(NCC_Zstd) ? NCC_Zstd : NCC_Zlib, C4Network2Codecs::ChooseStream("zlib, zstd"));
+	for (auto codec : { NCC_Zlib, NCC_Zstd, NCC_LZ4 })
+		EXPECT_EQ(codec, C4Network2Codecs::GetByName(C4Network2Codecs::GetName(codec)));
+}
+
+TEST_F(C4Network2CodecTest, BlockRoundTrip)
+{
+	for (auto codec : { NCC_Zlib, NCC_Zstd, NCC_LZ4 })
+	{
+		if (!C4Network2Codecs::IsAvailable(codec)) continue;
+		SCOPED_TRACE(C4Network2Codecs::GetName(codec));
+		StdBuf packed, unpacked;
+		ASSERT_TRUE(C4Network2Codecs::Compress(codec, text.data(), text.size(), packed));
+		EXPECT_LT(packed.getSize(), text.size());
+		ASSERT_TRUE(C4Network2Codecs::Decompress(codec, packed.getData(), packed.getSize(), text.size(), unpacked));
+		EXPECT_EQ(text, std::string(static_cast<const char *>(unpacked.getData()), unpacked.getSize()));
+		// Wrong size or corrupt data is rejected
+		EXPECT_FALSE(C4Network2Codecs::Decompress(codec, packed.getData(), packed.getSize(), text.size() - 1, unpacked));
+		EXPECT_FALSE(C4Network2Codecs::Decompress(codec, noise.data(), 100, text.size(), unpacked));
+		// Incompressible data is sent as is
+		EXPECT_FALSE(C4Network2Codecs::Compress(codec, noise.data(), noise.size(), packed));
+	}
+}
+
+TEST_F(C4Network2CodecTest, StreamRoundTrip)
+{
+	for (auto codec : { NCC_Zlib, NCC_Zstd })
+	{
+		if (!C4Network2Codecs::IsAvailable(codec)) continue;
+		SCOPED_TRACE(C4Network2Codecs::GetName(codec));
+		C4Network2StreamCompressor compressor;
+		ASSERT_TRUE(compressor.Init(codec, 3));
+		// Feed the input in pieces through a small output window, like record streaming
+		std::string input = text + noise, output;
+		size_t pos = 0;
+		bool finished = false;
+		char window[1000];
+		while (!finished)
+		{
+			const bool finish = (pos == input.size());
+			const size_t piece = std::min<size_t>(input.size() - pos, 777);
+			size_t consumed, produced;
+			ASSERT_TRUE(compressor.Process(input.data() + pos, piece, &consumed, window, sizeof(window), &produced, finish, &finished));
+			pos += consumed;
+			output.append(window, produced);
+		}
+		StdBuf unpacked;
+		ASSERT_TRUE(C4Network2Codecs::Decompress(codec, output.data(), output.size(), input.size(), unpacked));
+		EXPECT_EQ(input, std::string(static_cast<const char *>(unpacked.getData()), unpacked.getSize()));
+	}
+}
@@ -0,0 +1,130 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2019, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include "network/C4Network2ResCache.h"
+#include "c4group/CStdFile.h"
+
+#include <gtest/gtest.h>
+
+class C4Network2ResCacheTest : public ::testing::Test
+{
+protected:
+	const char *cache_dir = "C4Network2ResCacheTest.cache";
+	const char *folder = "C4Network2ResCacheTest.ocd";
+	const char *packed = "C4Network2ResCacheTest.packed";
+
+	void WriteFile(const char *filename, const std::string &contents)
+	{
+		StdBuf buffer;
+		buffer.Copy(contents.data(), contents.size());
+		ASSERT_TRUE(buffer.SaveToFile(filename));
+	}
+
+	void SetUp() override
+	{
+		TearDown();
+		ASSERT_TRUE(CreatePath(std::string(folder) + DirSep "Sub"));
+		WriteFile((std::string(folder) + DirSep "Script.c").c_str(), "func Initialize() {}");
+		WriteFile((std::string(folder) + DirSep "Sub" DirSep "Data.txt").c_str(), "data");
+		// stands in for the packed version of the folder
+		WriteFile(packed, std::string(5000, 'x'));
+	}
+
+	void TearDown() override
+	{
+		EraseItem(cache_dir);
+		EraseItem(folder);
+		EraseItem(packed);
+	}
+};
+
+TEST_F(C4Network2ResCacheTest, Fingerprint)
+{
+	C4Network2ResCache::Fingerprint print, changed;
+	ASSERT_TRUE(print.Calculate(folder));
+	EXPECT_EQ(2u, print.FileCnt);
+	EXPECT_EQ(24u, print.Size);
+	// changes deep inside are noticed
+	WriteFile((std::string(folder) + DirSep "Sub" DirSep "Data.txt").c_str(), "changed");
+	ASSERT_TRUE(changed.Calculate(folder));
+	EXPECT_NE(print, changed);
+	EXPECT_FALSE(print.Calculate("C4Network2ResCacheTest.missing"));
+}
+
+TEST_F(C4Network2ResCacheTest, Checksums)
+{
+	C4Network2ResCache cache;
+	ASSERT_TRUE(cache.Init(cache_dir, 1024 * 1024));
+	uint32_t crc = 0, size = 0;
+	StdStrBuf file;
+	EXPECT_FALSE(cache.GetContentsCRC(folder, &crc));
+	EXPECT_FALSE(cache.GetStandalone(folder, &file, &size, &crc));
+	cache.SetContentsCRC(folder, 1234);
+	ASSERT_TRUE(cache.SetStandalone(folder, packed, 5000, 5678));
+	EraseItem(packed);
+	// the packed version is copied into the cache directory
+	ASSERT_TRUE(cache.GetStandalone(folder, &file, &size, &crc));
+	EXPECT_EQ(5000u, size);
+	EXPECT_EQ(5678u, crc);
+	EXPECT_EQ(5000u, FileSize(file.getData()));
+	// the SHA is calculated from the copy
+	uint8_t sha[SHA_DIGEST_LENGTH], expected_sha[SHA_DIGEST_LENGTH];
+	ASSERT_TRUE(GetFileSHA1(file.getData(), expected_sha));
+	ASSERT_TRUE(cache.GetSHA(folder, sha));
+	EXPECT_EQ(0, memcmp(sha, expected_sha, SHA_DIGEST_LENGTH));
+	// everything survives a restart
+	cache.Clear();
+	ASSERT_TRUE(cache.Init(cache_dir, 1024 * 1024));
+	EXPECT_TRUE(cache.GetContentsCRC(folder, &crc));
+	EXPECT_EQ(1234u, crc);
+	ASSERT_TRUE(cache.GetSHA(folder, sha));
+	EXPECT_EQ(0, memcmp(sha, expected_sha, SHA_DIGEST_LENGTH));
+	// until the folder is changed
+	WriteFile((std::string(folder) + DirSep "New.txt").c_str(), "new");
+	EXPECT_FALSE(cache.GetContentsCRC(folder, &crc));
+	EXPECT_FALSE(cache.GetStandalone(folder, &file, &size, &crc));
+	EXPECT_FALSE(cache.GetSHA(folder, sha));
+}
+
+TEST_F(C4Network2ResCacheTest, PackedItem)
+{
+	C4Network2ResCache cache;
+	ASSERT_TRUE(cache.Init(cache_dir, 1024 * 1024));
+	// no copy of items that are packed already
+	ASSERT_TRUE(cache.SetStandalone(packed, packed, 5000, 5678));
+	StdStrBuf file;
+	uint32_t crc = 0, size = 0;
+	ASSERT_TRUE(cache.GetStandalone(packed, &file, &size, &crc));
+	EXPECT_STREQ(packed, file.getData());
+	uint8_t sha[SHA_DIGEST_LENGTH], expected_sha[SHA_DIGEST_LENGTH];
+	ASSERT_TRUE(GetFileSHA1(packed, expected_sha));
+	ASSERT_TRUE(cache.GetSHA(packed, sha));
+	EXPECT_EQ(0, memcmp(sha, expected_sha, SHA_DIGEST_LENGTH));
+}
+
+TEST_F(C4Network2ResCacheTest, SizeLimit)
+{
+	C4Network2ResCache cache;
+	ASSERT_TRUE(cache.Init(cache_dir, 8000));
+	ASSERT_TRUE(cache.SetStandalone(folder, packed, 5000, 1));
+	const std::string other = std::string(folder) + DirSep "Sub";
+	ASSERT_TRUE(cache.SetStandalone(other.c_str(), packed, 5000, 2));
+	// at most one copy fits. Which one is dropped depends on timing.
+	StdStrBuf file;
+	uint32_t crc = 0, size = 0;
+	EXPECT_EQ(1, int(cache.GetStandalone(folder, &file, &size, &crc)) + int(cache.GetStandalone(other.c_str(), &file, &size, &crc)));
+	EXPECT_FALSE(cache.SetStandalone(folder, packed, 9000, 3));
+}
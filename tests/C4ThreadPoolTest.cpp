@@ -0,0 +1,55 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2019, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include "platform/C4ThreadPool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+TEST(C4ThreadPoolTest, RunsEveryItemOnce)
+{
+	for (int32_t thread_count : { 0, 1, 4 })
+	{
+		SCOPED_TRACE(thread_count);
+		C4ThreadPool pool(thread_count);
+		EXPECT_EQ(thread_count, pool.GetThreadCount());
+		// several batches on the same workers, including an empty one
+		for (size_t count : { 1000, 0, 17 })
+		{
+			std::vector<std::atomic<int>> calls(count);
+			for (auto &call : calls) call = 0;
+			pool.Run(count, [&calls](size_t item) { ++calls[item]; });
+			for (size_t i = 0; i < count; ++i)
+				EXPECT_EQ(1, calls[i].load()) << "item " << i;
+		}
+	}
+}
+
+TEST(C4ThreadPoolTest, StartDoesNotBlock)
+{
+	C4ThreadPool pool(2);
+	std::atomic<int> sum(0);
+	pool.Start(100, [&sum](size_t item) { sum += item; });
+	pool.Wait();
+	EXPECT_EQ(4950, sum.load());
+	// destroying a pool with an unfinished batch finishes it first
+	{
+		C4ThreadPool other(2);
+		other.Start(100, [&sum](size_t item) { sum -= item; });
+	}
+	EXPECT_EQ(0, sum.load());
+}
@@ -90,3 +90,22 @@ TEST(C4ValueTest, ToJSON)
 		EXPECT_EQ(C4Value(array).ToJSON(), R"#([{"Options":123}])#");
 	}
 }
+
+TEST(C4ValueTest, PropListReferences)
+{
+	// few references are stored inline, more in a hash table
+	for (int count : {1, 4, 5, 100})
+	{
+		// not deleted when losing the last reference
+		auto proplist = new C4PropListStaticMember(nullptr, nullptr, nullptr);
+		std::vector<C4Value> values(count, C4VPropList(proplist));
+		for (int i = 0; i < count; i += 3)
+			values[i].Set0();
+		for (int i = 0; i < count; ++i)
+			EXPECT_EQ(i % 3 ? proplist : nullptr, values[i].getPropList());
+		// all remaining references are cleared when the proplist is destroyed
+		delete proplist;
+		for (auto &value : values)
+			EXPECT_EQ(nullptr, value.getPropList());
+	}
+}
@@ -0,0 +1,102 @@
+/*
+* OpenClonk, http://www.openclonk.org
+*
+* Copyright (c) 2016, The OpenClonk Team and contributors
+*
+* Distributed under the terms of the ISC license; see accompanying file
+* "COPYING" for details.
+*
+* "Clonk" is a registered trademark of Matthes Bender, used with permission.
+* See accompanying file "TRADEMARK" for details.
+*
+* To redistribute this file separately, substitute the full license texts
+* for the above references.
+*/
+
+// Microbenchmarks for the script engine.
+// These are disabled by default; run them with
+//   aul_test --gtest_also_run_disabled_tests --gtest_filter='AulBenchmark*'
+
+#include "C4Include.h"
+#include "AulTest.h"
+
+#include "script/C4Aul.h"
+
+#include <chrono>
+
+class AulBenchmark : public AulTest
+{
+protected:
+	template<class F> void Measure(const char *name, int iterations, F &&f)
+	{
+		auto start = std::chrono::steady_clock::now();
+		f();
+		std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+		std::cout << name << ": " << duration.count() / iterations << " ns per iteration" << std::endl;
+	}
+};
+
+TEST_F(AulBenchmark, DISABLED_PropListReferences)
+{
+	// AddRef/DelRef: copy a proplist reference into values and release them again
+	const int iterations = 1000000, refs = 16;
+	C4Value proplist = C4VPropList(C4PropList::New());
+	Measure("PropList AddRef/DelRef", iterations * refs, [&]()
+	{
+		C4Value values[refs];
+		for (int i = 0; i < iterations; ++i)
+		{
+			for (auto &value : values) value = proplist;
+			for (auto &value : values) value.Set0();
+		}
+	});
+	// many references to the same proplist
+	std::vector<C4Value> many(10000);
+	Measure("PropList AddRef/DelRef (10000 refs)", iterations / 10, [&]()
+	{
+		for (int i = 0; i < iterations / 10; ++i)
+		{
+			many[i % many.size()] = proplist;
+			many[(i * 7) % many.size()].Set0();
+		}
+	});
+}
+
+TEST_F(AulBenchmark, DISABLED_ScriptCalls)
+{
+	// script function calls passing proplists through the value stack
+	const int iterations = 1000000;
+	Measure("Script call with proplist parameters", iterations, [&]()
+	{
+		RunScript(R"(
+func f(a, b) { return a; }
+func Main() { var p = {}, q = {}; for (var i = 0; i < 1000000; ++i) f(p, q); }
+)");
+	});
+	Measure("Script array store of proplists", iterations, [&]()
+	{
+		RunScript(R"(
+func Main() { var p = {}, a = CreateArray(100); for (var i = 0; i < 1000000; ++i) a[i % 100] = p; }
+)");
+	});
+	Measure("Property and method access through prototypes", iterations, [&]()
+	{
+		RunScript(R"(
+static const Base = { v = 1, f = func() { return 1; } };
+static const Derived = new Base { w = 2 };
+func Main() { var p = new Derived {}, s = 0; for (var i = 0; i < 1000000; ++i) s += p.v + p->f(); return s; }
+)");
+	});
+}
+
+TEST_F(AulBenchmark, DISABLED_Arithmetic)
+{
+	// loops over locals, constants and comparisons
+	const int iterations = 1000000;
+	Measure("Arithmetic loop", iterations, [&]()
+	{
+		RunScript(R"(
+func Main() { var s = 0, n = 1000000; for (var i = 0; i < n; ++i) { if (i % 3 == 0) s += i * 2; else s -= 1; } return s; }
+)");
+	});
+}
@@ -0,0 +1,177 @@
+/*
+* OpenClonk, http://www.openclonk.org
+*
+* Copyright (c) 2016, The OpenClonk Team and contributors
+*
+* Distributed under the terms of the ISC license; see accompanying file
+* "COPYING" for details.
+*
+* "Clonk" is a registered trademark of Matthes Bender, used with permission.
+* See accompanying file "TRADEMARK" for details.
+*
+* To redistribute this file separately, substitute the full license texts
+* for the above references.
+*/
+
+// Testing that constant folding and joined bytecode behave like the
+// unoptimized code.
+
+#include "C4Include.h"
+#include "AulTest.h"
+
+#include "script/C4Aul.h"
+#include "script/C4AulScriptFunc.h"
+#include "script/C4ScriptHost.h"
+
+class AulCodegenTest : public AulTest
+{
+protected:
+	// Runs the code as body of Main. Id(x) is available to hide values from
+	// the compiler. Runtime errors are returned as strings, so that their
+	// messages can be compared as well.
+	C4Value Run(const std::string &code)
+	{
+		try
+		{
+			return RunScript("func Id(x) { return x; }\nfunc Main() {\n" + code + "\n}\n");
+		}
+		catch (C4AulExecError &e)
+		{
+			return C4VString(e.what());
+		}
+	}
+
+	// Returns the bytecode types of Main
+	std::vector<C4AulBCCType> Compile(const std::string &code)
+	{
+		std::vector<C4AulBCCType> result;
+		InitCoreFunctionMap(&ScriptEngine);
+		GameScript.LoadData("<AulCodegenTest>", ("func Main() {\n" + code + "\n}\n").c_str(), nullptr);
+		ScriptEngine.Link(nullptr);
+		C4AulScriptFunc *func = GameScript.GetPropList()->GetFunc("Main")->SFunc();
+		for (C4AulBCC *bcc = func->GetCode(); bcc->bccType != AB_EOFN; ++bcc)
+			result.push_back(bcc->bccType);
+		GameScript.Clear();
+		ScriptEngine.Clear();
+		return result;
+	}
+
+	const std::vector<std::string> int_values = { "0", "1", "-1", "2", "-3", "7", "31", "32", "(-2147483647 - 1)", "2147483647" };
+	const std::vector<std::string> other_values = { "nil", "true", "\"x\"", "[]" };
+	const std::vector<std::string> binary_operators = { "+", "-", "*", "/", "%", "**", "<<", ">>", "&", "|", "^", "<", "<=", ">", ">=", "==", "!=" };
+};
+
+TEST_F(AulCodegenTest, ConstantOperands)
+{
+	for (auto &op : binary_operators)
+		for (auto &a : int_values)
+			for (auto &b : int_values)
+			{
+				SCOPED_TRACE(a + " " + op + " " + b);
+				C4Value expected = Run("return Id(" + a + ") " + op + " Id(" + b + ");");
+				// folded at compile time
+				EXPECT_EQ(expected, Run("return " + a + " " + op + " " + b + ";"));
+				// constant right side
+				EXPECT_EQ(expected, Run("var x = " + a + "; return x " + op + " " + b + ";"));
+				// changing assignment
+				if (op.size() == 1 && op != "<" && op != ">")
+				{
+					EXPECT_EQ(expected, Run("var x = " + a + "; x " + op + "= " + b + "; return x;"));
+				}
+			}
+}
+
+TEST_F(AulCodegenTest, NonIntOperands)
+{
+	// Type errors of joined operators report the same operator and side
+	for (auto &op : binary_operators)
+		for (auto &a : other_values)
+		{
+			SCOPED_TRACE(a + " " + op);
+			EXPECT_EQ(Run("return Id(" + a + ") " + op + " Id(5);"), Run("var x = " + a + "; return x " + op + " 5;"));
+			EXPECT_EQ(Run("var x = " + a + "; if (Id(Id(x) " + op + " Id(x))) return 1; return 2;"), Run("var x = " + a + ", y = x; if (x " + op + " y) return 1; return 2;"));
+		}
+}
+
+TEST_F(AulCodegenTest, CompareAndBranch)
+{
+	for (auto &op : { "<", "<=", ">", ">=", "==", "!=" })
+		for (auto &a : int_values)
+			for (auto &b : int_values)
+			{
+				SCOPED_TRACE(a + " " + op + " " + b);
+				C4Value expected = Run(std::string("if (Id(Id(") + a + ") " + op + " Id(" + b + "))) return 1; return 2;");
+				EXPECT_EQ(expected, Run(std::string("var x = ") + a + ", y = " + b + "; if (x " + op + " y) return 1; return 2;"));
+				EXPECT_EQ(expected, Run(std::string("var x = ") + a + ", y = " + b + "; while (x " + op + " y) return 1; return 2;"));
+				EXPECT_EQ(expected, Run(std::string("var x = ") + a + ", y = " + b + "; for (; x " + op + " y;) return 1; return 2;"));
+			}
+	for (auto &a : other_values)
+	{
+		SCOPED_TRACE(a);
+		EXPECT_EQ(Run("if (Id(Id(" + a + ") < Id(1))) return 1; return 2;"), Run("var x = " + a + ", y = 1; if (x < y) return 1; return 2;"));
+		EXPECT_EQ(Run("if (Id(Id(1) >= Id(" + a + "))) return 1; return 2;"), Run("var x = 1, y = " + a + "; if (x >= y) return 1; return 2;"));
+		EXPECT_EQ(Run("var x = " + a + "; if (Id(Id(x) == Id(x))) return 1; return 2;"), Run("var x = " + a + ", y = x; if (x == y) return 1; return 2;"));
+		EXPECT_EQ(Run("if (Id(Id(" + a + ") != Id(nil))) return 1; return 2;"), Run("var x = " + a + ", y; if (x != y) return 1; return 2;"));
+	}
+	// Short-circuiting operators jump right before the branch, which must not be joined
+	EXPECT_EQ(C4VInt(2), Run("var x = 0, y = 1; if (x && x < y) return 1; return 2;"));
+	EXPECT_EQ(C4VInt(1), Run("var x = 1, y = 0; if (x || x < y) return 1; return 2;"));
+	EXPECT_EQ(C4VInt(1), Run("var x, y = 1; if (x ?? 0 < y) return 1; return 2;"));
+}
+
+TEST_F(AulCodegenTest, IncrementLocal)
+{
+	for (auto &a : int_values)
+	{
+		SCOPED_TRACE(a);
+		C4Value inc = Run("var i = " + a + "; Id(++i); return i;");
+		C4Value dec = Run("var i = " + a + "; Id(--i); return i;");
+		EXPECT_EQ(inc, Run("var i = " + a + "; ++i; return i;"));
+		EXPECT_EQ(inc, Run("var i = " + a + "; i++; return i;"));
+		EXPECT_EQ(inc, Run("var i = " + a + "; i += 1; return i;"));
+		EXPECT_EQ(dec, Run("var i = " + a + "; --i; return i;"));
+		EXPECT_EQ(dec, Run("var i = " + a + "; i--; return i;"));
+		EXPECT_EQ(dec, Run("var i = " + a + "; i -= 1; return i;"));
+	}
+	for (auto &a : other_values)
+	{
+		SCOPED_TRACE(a);
+		EXPECT_EQ(Run("var i = " + a + "; Id(++i); return i;"), Run("var i = " + a + "; ++i; return i;"));
+		EXPECT_EQ(Run("var i = " + a + "; Id(--i); return i;"), Run("var i = " + a + "; i--; return i;"));
+	}
+	// Short-circuiting operators jump to the assignment, which must not be joined with the increment
+	for (auto &op : { "??", "&&", "||" })
+		for (auto &x : { "nil", "0", "7" })
+		{
+			SCOPED_TRACE(std::string(x) + " " + op);
+			EXPECT_EQ(Run(std::string("var x = ") + x + ", i = 5; i = Id(x) " + op + " Id(i) + 1; return [x, i];"), Run(std::string("var x = ") + x + ", i = 5; i = x " + op + " i + 1; return [x, i];"));
+			EXPECT_EQ(Run(std::string("var x = ") + x + ", i = 5; i = Id(x) " + op + " Id(i) - 1; return [x, i];"), Run(std::string("var x = ") + x + ", i = 5; i = x " + op + " i - 1; return [x, i];"));
+		}
+	// Other variables and parameters on the stack stay untouched
+	EXPECT_EQ(C4VArray(C4VInt(1), C4VInt(11), C4VInt(20), C4VInt(30)), RunScript(R"(
+func f(a, b) { var c = 20, d = 30; b++; ++a; return [a, b, c, d]; }
+func Main() { return f(0, 10); }
+)"));
+	EXPECT_EQ(C4VArray(C4VInt(10), C4VInt(9), C4VInt(45)), RunCode(R"(
+var s = 0, n = 0, m = 10;
+for (var i = 0; i < m; ++i) { s += i; n++; --m; ++m; }
+for (var j = 0; j < 10; j++) m--;
+return [n, m + 9, s];
+)"));
+}
+
+TEST_F(AulCodegenTest, Superinstructions)
+{
+	// Make sure the joins happen at all
+	auto code = Compile("var s = 0, n = 10; for (var i = 0; i < n; ++i) s = s * 3 + 1; return s;");
+	EXPECT_NE(code.end(), std::find(code.begin(), code.end(), AB_LessThan_CONDN));
+	EXPECT_NE(code.end(), std::find(code.begin(), code.end(), AB_STACK_Inc));
+	EXPECT_NE(code.end(), std::find(code.begin(), code.end(), AB_Mul_INT));
+	EXPECT_EQ(code.end(), std::find(code.begin(), code.end(), AB_CONDN));
+	// Constant expressions end up as a single constant
+	code = Compile("return (1 + 2) * 3 - (4 << 2) % 5;");
+	EXPECT_EQ(std::vector<C4AulBCCType>({ AB_INT, AB_RETURN }), code);
+	// Runtime errors are kept
+	code = Compile("return 1 / 0;");
+	EXPECT_NE(code.end(), std::find(code.begin(), code.end(), AB_Div));
+}
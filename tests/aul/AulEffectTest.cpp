@@ -0,0 +1,132 @@
+/*
+* OpenClonk, http://www.openclonk.org
+*
+* Copyright (c) 2016, The OpenClonk Team and contributors
+*
+* Distributed under the terms of the ISC license; see accompanying file
+* "COPYING" for details.
+*
+* "Clonk" is a registered trademark of Matthes Bender, used with permission.
+* See accompanying file "TRADEMARK" for details.
+*
+* To redistribute this file separately, substitute the full license texts
+* for the above references.
+*/
+
+// Testing effect timer scheduling.
+
+#include "C4Include.h"
+#include "AulTest.h"
+#include "ErrorHandler.h"
+
+#include "script/C4Aul.h"
+#include "script/C4Effect.h"
+#include "script/C4ScriptHost.h"
+#include "lib/C4Random.h"
+
+class AulEffectTest : public AulTest
+{
+protected:
+	// Runs Main, then executes the effect lists for the given number of frames
+	// calling Frame(frame) before each execution, and returns Result()
+	C4Value RunFrames(const std::string &code, int frames)
+	{
+		class OnScopeExit
+		{
+		public:
+			~OnScopeExit()
+			{
+				GameScript.Clear();
+				ScriptEngine.Clear();
+			}
+		} _cleanup;
+
+		// script errors in timers would silently remove the effects
+		ErrorHandler errh;
+		EXPECT_CALL(errh, OnError(::testing::_)).Times(0);
+		InitCoreFunctionMap(&ScriptEngine);
+		FixedRandom(0x40490fdb);
+		auto test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+		std::string src = std::string("<") + test_info->test_case_name() + "::" + test_info->name() + ">";
+		GameScript.LoadData(src.c_str(), code.c_str(), nullptr);
+		ScriptEngine.Link(nullptr);
+
+		GameScript.Call("Main", nullptr, true);
+		for (int frame = 1; frame <= frames; ++frame)
+		{
+			GameScript.Call("Frame", &C4AulParSet(frame), true);
+			C4Effect::Execute(&ScriptEngine.pGlobalEffects);
+			C4Effect::Execute(&GameScript.pScenarioEffects);
+		}
+		return GameScript.Call("Result", nullptr, true);
+	}
+
+	// Common script parts: effects log their timer calls into an array
+	const std::string log_code = R"(
+static log;
+global func AddLog(v) { log[GetLength(log)] = v; }
+local Fx = { Timer = func(time) { AddLog(time); } };
+)";
+};
+
+using namespace aul_test::detail;
+
+TEST_F(AulEffectTest, Interval)
+{
+	EXPECT_EQ(C4VArray(C4VInt(3), C4VInt(6), C4VInt(9)), RunFrames(log_code + R"(
+func Main() { log = []; CreateEffect(Fx, 1, 3); }
+func Frame() {}
+func Result() { return log; }
+)", 10));
+	// lists containing long-running timers are not walked every frame; changes from outside still apply immediately
+	EXPECT_EQ(C4VArray(C4VInt(6), C4VInt(9), C4VInt(12), C4VInt(15)), RunFrames(log_code + R"(
+static fx;
+func Main() { log = []; CreateEffect(Fx, 2, 50); fx = CreateEffect(Fx, 1, 10); }
+func Frame(frame) { if (frame == 4) fx.Interval = 3; }
+func Result() { return log; }
+)", 15));
+}
+
+TEST_F(AulEffectTest, Time)
+{
+	EXPECT_EQ(C4VArray(C4VInt(2), C4VInt(2), C4VInt(2)), RunFrames(log_code + R"(
+local FxReset = { Timer = func(time) { AddLog(time); this.Time = 0; } };
+func Main() { log = []; CreateEffect(FxReset, 1, 2); }
+func Frame() {}
+func Result() { return log; }
+)", 7));
+	EXPECT_EQ(C4VArray(C4VInt(4), C4VInt(4), C4VInt(8), C4VInt(8)), RunFrames(log_code + R"(
+static fx;
+func Main() { log = []; CreateEffect(Fx, 2, 50); fx = CreateEffect(Fx, 1, 4); }
+func Frame(frame) { if (frame == 5) fx.Time = 0; }
+func Result() { AddLog(fx.Time); return log; }
+)", 12));
+}
+
+TEST_F(AulEffectTest, Creation)
+{
+	// effects created between executions are advanced in the next execution
+	EXPECT_EQ(C4VArray(C4VInt(2), C4VInt(4), C4VInt(6)), RunFrames(log_code + R"(
+func Main() { log = []; CreateEffect(Fx, 2, 50); }
+func Frame(frame) { if (frame == 5) CreateEffect(Fx, 1, 2); }
+func Result() { return log; }
+)", 10));
+	// effects created during an execution start with the next one
+	EXPECT_EQ(C4VArray(C4VInt(3), C4VInt(101), C4VInt(102), C4VInt(6), C4VInt(103)), RunFrames(log_code + R"(
+local FxChild = { Timer = func(time) { AddLog(100 + time); } };
+local FxParent = { Timer = func(time) { AddLog(time); if (time == 3) Scenario->CreateEffect(Scenario.FxChild, 2, 1); } };
+func Main() { log = []; CreateEffect(FxParent, 1, 3); }
+func Frame() {}
+func Result() { return log; }
+)", 6));
+}
+
+TEST_F(AulEffectTest, Removal)
+{
+	EXPECT_EQ(C4VArray(C4VInt(2), C4VInt(4)), RunFrames(log_code + R"(
+static fx;
+func Main() { log = []; CreateEffect(Fx, 2, 50); fx = CreateEffect(Fx, 1, 2); }
+func Frame(frame) { if (frame == 5) RemoveEffect(nil, nil, fx); }
+func Result() { return log; }
+)", 8));
+}
@@ -0,0 +1,220 @@
+/*
+* OpenClonk, http://www.openclonk.org
+*
+* Copyright (c) 2016, The OpenClonk Team and contributors
+*
+* Distributed under the terms of the ISC license; see accompanying file
+* "COPYING" for details.
+*
+* "Clonk" is a registered trademark of Matthes Bender, used with permission.
+* See accompanying file "TRADEMARK" for details.
+*
+* To redistribute this file separately, substitute the full license texts
+* for the above references.
+*/
+
+// Testing that scripts loaded from the parsed script cache behave like
+// freshly parsed ones.
+
+#include "C4Include.h"
+#include "AulTest.h"
+#include "ErrorHandler.h"
+
+#include "script/C4Aul.h"
+#include "script/C4AulParse.h"
+#include "script/C4ScriptHost.h"
+#include "lib/C4Random.h"
+
+class AulScriptCacheTest : public AulTest
+{
+protected:
+	const char *CachePath = "AulScriptCacheTest.tmp";
+
+	void SetUp() override
+	{
+		AulTest::SetUp();
+		ClearCache();
+		ScriptEngine.ScriptCache.Init(CachePath, "test");
+		ASSERT_TRUE(ScriptEngine.ScriptCache.IsEnabled());
+	}
+	void TearDown() override
+	{
+		ScriptEngine.ScriptCache.Disable();
+		ClearCache();
+	}
+	void ClearCache()
+	{
+		if (DirectoryExists(CachePath))
+			EraseDirectory(CachePath);
+	}
+
+	// Runs Main of the script and reports whether its tree came from the cache
+	C4Value Run(const std::string &code, bool *loaded)
+	{
+		InitCoreFunctionMap(&ScriptEngine);
+		FixedRandom(0x40490fdb);
+		GameScript.LoadData("<AulScriptCacheTest>", code.c_str(), nullptr);
+		*loaded = ScriptEngine.ScriptCache.LoadedCnt == 1;
+		ScriptEngine.Link(nullptr);
+		C4Value result;
+		try
+		{
+			result = GameScript.Call("Main", nullptr, true);
+		}
+		catch (C4AulExecError &)
+		{
+		}
+		GameScript.Clear();
+		ScriptEngine.Clear();
+		return result;
+	}
+
+	// Runs the script from source, then again from the cache
+	void RoundTrip(const std::string &code)
+	{
+		bool loaded;
+		C4Value expected = Run(code, &loaded);
+		EXPECT_FALSE(loaded);
+		EXPECT_EQ(expected, Run(code, &loaded));
+		EXPECT_TRUE(loaded);
+	}
+
+	std::vector<std::string> CacheFiles()
+	{
+		std::vector<std::string> result;
+		for (DirectoryIterator i(CachePath); *i; ++i)
+			result.emplace_back(*i);
+		return result;
+	}
+};
+
+TEST_F(AulScriptCacheTest, RoundTrip)
+{
+	RoundTrip(R"(
+static const Consts = { A = 1, B = "b", C = [2, nil, true], D = func(x) { return x * 2; } };
+local foo = 3;
+func f(int a, b, ...) { return [a, b, Par(2), this]; }
+func Main()
+{
+	var s = 0, a = [1, 2, 3, 4], p = { x = 5 };
+	for (var i = 0; i < 10; ++i) { if (i % 2) continue; s += i; if (i > 6) break; }
+	for (var x in a[1:3]) s += x;
+	for (var x in a) s -= x;
+	do s++; while (s < 100);
+	while (s > 120) s--;
+	if (!s) s = -1; else s = ~s ^ 7;
+	a[0] = p.x ?? 6;
+	p.y = [s, "str\n"];
+	return [s, a, p, Consts->D(Consts.A), Consts.C, foo, f(1, 2, 3)[0:3], this->~Missing(), 1 && 0 || 4, 2 ** 10];
+}
+)");
+	// Only one file per script
+	EXPECT_EQ(1u, CacheFiles().size());
+}
+
+TEST_F(AulScriptCacheTest, Warnings)
+{
+	// #warning pragmas are kept, and warnings from the compiler are still reported
+	ErrorHandler errh;
+	EXPECT_CALL(errh, OnWarning(::testing::_)).Times(4);
+	RoundTrip(R"(
+func Main(string s) {
+	Sin(s);
+#warning disable arg_type_mismatch
+	Sin(s);
+#warning enable arg_type_mismatch
+	Sin(s);
+}
+)");
+}
+
+TEST_F(AulScriptCacheTest, Diagnostics)
+{
+	// Scripts with parse errors or warnings are parsed every time
+	ErrorHandler errh;
+	EXPECT_CALL(errh, OnError(::testing::_)).Times(2);
+	EXPECT_CALL(errh, OnWarning(::testing::_)).Times(2);
+	bool loaded;
+	for (int i = 0; i < 2; ++i)
+	{
+		Run("func Main() { return 1 }", &loaded);
+		EXPECT_FALSE(loaded);
+		Run("func Main() { return \"\\q\"; }", &loaded);
+		EXPECT_FALSE(loaded);
+	}
+	EXPECT_TRUE(CacheFiles().empty());
+}
+
+TEST_F(AulScriptCacheTest, ChangedAndCorrupt)
+{
+	bool loaded;
+	EXPECT_EQ(C4VInt(1), Run("func Main() { return 1; }", &loaded));
+	// A changed script gets its own entry
+	EXPECT_EQ(C4VInt(2), Run("func Main() { return 2; }", &loaded));
+	EXPECT_FALSE(loaded);
+	auto files = CacheFiles();
+	ASSERT_EQ(2u, files.size());
+	// Broken files are ignored and replaced
+	for (auto &file : files)
+	{
+		StdBuf buf;
+		ASSERT_TRUE(buf.LoadFromFile(file.c_str()));
+		buf.Shrink(buf.getSize() / 2);
+		ASSERT_TRUE(buf.SaveToFile(file.c_str()));
+	}
+	EXPECT_EQ(C4VInt(1), Run("func Main() { return 1; }", &loaded));
+	EXPECT_FALSE(loaded);
+	EXPECT_EQ(C4VInt(1), Run("func Main() { return 1; }", &loaded));
+	EXPECT_TRUE(loaded);
+	// Other engine versions don't share entries
+	ScriptEngine.ScriptCache.Init(CachePath, "other");
+	EXPECT_EQ(C4VInt(1), Run("func Main() { return 1; }", &loaded));
+	EXPECT_FALSE(loaded);
+}
+
+TEST_F(AulScriptCacheTest, InvalidOperator)
+{
+	bool loaded;
+	EXPECT_EQ(C4VInt(6 * 6 * 6), Run("func Main() { return 6 ** 3; }", &loaded));
+	auto files = CacheFiles();
+	ASSERT_EQ(1u, files.size());
+	// Replace the operator of the binary expression with one that is out of range
+	StdBuf buf;
+	ASSERT_TRUE(buf.LoadFromFile(files[0].c_str()));
+	char *data = static_cast<char *>(buf.getMData());
+	const int32_t pow_op = 8, bad_op = 1000;
+	ASSERT_STREQ("**", C4ScriptOpMap[pow_op].Identifier);
+	bool found = false;
+	for (size_t i = 0; i + 9 <= buf.getSize(); ++i)
+		if (data[i] == 11 && !std::memcmp(data + i + 5, &pow_op, sizeof(pow_op)))
+		{
+			std::memcpy(data + i + 5, &bad_op, sizeof(bad_op));
+			found = true;
+		}
+	ASSERT_TRUE(found);
+	ASSERT_TRUE(buf.SaveToFile(files[0].c_str()));
+	EXPECT_EQ(C4VInt(6 * 6 * 6), Run("func Main() { return 6 ** 3; }", &loaded));
+	EXPECT_FALSE(loaded);
+	EXPECT_EQ(C4VInt(6 * 6 * 6), Run("func Main() { return 6 ** 3; }", &loaded));
+	EXPECT_TRUE(loaded);
+}
+
+TEST_F(AulScriptCacheTest, Prune)
+{
+	bool loaded;
+	Run("func Main() { return 1; }", &loaded);
+	std::string temp_file = std::string(CachePath) + DirectorySeparator + "0123.ocast.tmp";
+	std::string other_file = std::string(CachePath) + DirectorySeparator + "other.txt";
+	ASSERT_TRUE(StdBuf("x", 1).SaveToFile(temp_file.c_str()));
+	ASSERT_TRUE(StdBuf("x", 1).SaveToFile(other_file.c_str()));
+	// Recent files are kept
+	ScriptEngine.ScriptCache.Prune(60);
+	EXPECT_EQ(3u, CacheFiles().size());
+	// Stale entries and temporary files are removed, unrelated files are kept
+	ScriptEngine.ScriptCache.Prune(-1);
+	auto files = CacheFiles();
+	ASSERT_EQ(1u, files.size());
+	EXPECT_EQ(other_file, files[0]);
+	Run("func Main() { return 1; }", &loaded);
+	EXPECT_FALSE(loaded);
+}
@@ -218,6 +218,50 @@ func Main() { return b->c(); }
 	EXPECT_THROW(RunScript("func foo() { return { bar: func() {} }; }"), C4AulError);
 }
 
+TEST_F(AulTest, PrototypeLookupCaching)
+{
+	// lookups through the prototype chain are cached per bytecode, changes to the prototypes must still show
+	EXPECT_EQ(C4VArray(C4VInt(1), C4VInt(2), C4VNull, C4VInt(3), C4VInt(4), C4VInt(5), C4VInt(6)), RunScript(R"(
+func GetV(p) { return p.v; }
+func Main()
+{
+	var proto = { v = 1 }, p = new proto {}, r = [];
+	r[0] = GetV(p);
+	proto.v = 2;
+	r[1] = GetV(p);
+	ResetProperty("v", proto);
+	r[2] = GetV(p);
+	var proto2 = { v = 3 };
+	proto.Prototype = proto2;
+	r[3] = GetV(p);
+	p.v = 4;
+	r[4] = GetV(p);
+	ResetProperty("v", p);
+	proto2.v = 5;
+	r[5] = GetV(p);
+	var other = { v = 6 };
+	r[6] = GetV(new other {});
+	return r;
+}
+)"));
+	EXPECT_EQ(C4VArray(C4VInt(1), C4VInt(2), C4VInt(1), C4VNull), RunScript(R"(
+static const A = { f = func() { return 1; } };
+static const B = { f = func() { return 2; } };
+func CallF(p) { return p->~f(); }
+func Main()
+{
+	var proto = { f = A.f }, p = new proto {}, r = [];
+	r[0] = CallF(p);
+	proto.f = B.f;
+	r[1] = CallF(p);
+	p.f = A.f;
+	r[2] = CallF(p);
+	r[3] = CallF({});
+	return r;
+}
+)"));
+}
+
 TEST_F(AulTest, Eval)
 {
 	EXPECT_EQ(C4VInt(42), RunExpr("eval(\"42\")"));
@@ -0,0 +1,112 @@
+/*
+* OpenClonk, http://www.openclonk.org
+*
+* Copyright (c) 2016, The OpenClonk Team and contributors
+*
+* Distributed under the terms of the ISC license; see accompanying file
+* "COPYING" for details.
+*
+* "Clonk" is a registered trademark of Matthes Bender, used with permission.
+* See accompanying file "TRADEMARK" for details.
+*
+* To redistribute this file separately, substitute the full license texts
+* for the above references.
+*/
+
+// Testing that the specialized bytecode of hot functions behaves like the
+// code it replaces.
+
+#include "C4Include.h"
+#include "AulTest.h"
+
+#include "script/C4Aul.h"
+#include "script/C4AulScriptFunc.h"
+#include "script/C4ScriptHost.h"
+
+class AulTierUpTest : public AulTest
+{
+protected:
+	void TearDown() override
+	{
+		ScriptEngine.TierUpThreshold = C4AUL_TierUpThreshold;
+	}
+
+	// Runs Main with the given tier-up threshold. Runtime errors are returned
+	// as strings, so that their messages can be compared as well.
+	C4Value Run(const std::string &code, uint32_t threshold)
+	{
+		ScriptEngine.TierUpThreshold = threshold;
+		try
+		{
+			return RunScript(code);
+		}
+		catch (C4AulExecError &e)
+		{
+			return C4VString(e.what());
+		}
+	}
+
+	void ExpectSameResult(const std::string &code)
+	{
+		SCOPED_TRACE(code);
+		C4Value expected = Run(code, 0);
+		// tiered up before the first call
+		EXPECT_EQ(expected, Run(code, 1));
+		// tiered up in the middle of a loop
+		EXPECT_EQ(expected, Run(code, 4));
+	}
+
+	const std::vector<std::string> values = { "0", "1", "-3", "(-2147483647 - 1)", "2147483647", "nil", "true", "\"x\"", "[4, 5]", "{ a = 6 }" };
+};
+
+TEST_F(AulTierUpTest, Rewrite)
+{
+	// The code changes once the function reaches the threshold
+	ScriptEngine.TierUpThreshold = 3;
+	InitCoreFunctionMap(&ScriptEngine);
+	GameScript.LoadData("<AulTierUpTest>", "func F(a, b) { return a + b; }", nullptr);
+	ScriptEngine.Link(nullptr);
+	C4AulScriptFunc *func = GameScript.GetPropList()->GetFunc("F")->SFunc();
+	size_t length = 0;
+	for (C4AulBCC *bcc = func->GetCode(); bcc->bccType != AB_EOFN; ++bcc)
+		++length;
+	for (int i = 0; i < 4; ++i)
+	{
+		C4AulParSet pars(C4VInt(i), C4VInt(2));
+		EXPECT_EQ(C4VInt(i + 2), GameScript.Call("F", &pars, true));
+		bool tiered = false;
+		size_t new_length = 0;
+		for (C4AulBCC *bcc = func->GetCode(); bcc->bccType != AB_EOFN; ++bcc, ++new_length)
+			tiered |= bcc->bccType == AB_DUP_Sum;
+		EXPECT_EQ(i >= 2, tiered);
+		EXPECT_EQ(length, new_length);
+	}
+	GameScript.Clear();
+	ScriptEngine.Clear();
+}
+
+TEST_F(AulTierUpTest, Operators)
+{
+	for (auto &a : values)
+		for (auto &b : values)
+		{
+			std::string main = "\nfunc Main() { return F(" + a + ", " + b + "); }";
+			ExpectSameResult("func F(a, b) { return a + b; }" + main);
+			ExpectSameResult("func F(a, b) { return a - b; }" + main);
+			ExpectSameResult("func F(a, b) { if (a < b) return 1; return 2; }" + main);
+			ExpectSameResult("func F(a, b) { if (a > b) return 1; return 2; }" + main);
+		}
+	// Loops jump back into tiered up sequences
+	ExpectSameResult("func Main() { var s = 0, n = 10, m = 3; for (var i = 0; i < n; ++i) { if (i > m) s = s - i; else s = s + i; } return s; }");
+	ExpectSameResult("func Main() { var s = 0, n = 10; while (n > s) { s += 1; n = n - s; } return [s, n]; }");
+}
+
+TEST_F(AulTierUpTest, Access)
+{
+	for (auto &a : values)
+		ExpectSameResult("func F(a) { return a[1]; }\nfunc Main() { return F(" + a + "); }");
+	ExpectSameResult("func Main() { var a = [[1, 2], [3]]; return [a[0][1], a[1][1], a[0][-1]]; }");
+	ExpectSameResult("local foo = 3;\nfunc Main() { return [this.foo, this.bar]; }");
+	ExpectSameResult("func Main() { var p = { x = 4, F = func() { return this.x + this.y; } }; return p->F(); }");
+	ExpectSameResult("func Main() { var p = { x = 4, y = 5, F = func() { return this.x + this.y; } }; return p->F(); }");
+}
@@ -0,0 +1,127 @@
+/*
+* OpenClonk, http://www.openclonk.org
+*
+* Copyright (c) 2016, The OpenClonk Team and contributors
+*
+* Distributed under the terms of the ISC license; see accompanying file
+* "COPYING" for details.
+*
+* "Clonk" is a registered trademark of Matthes Bender, used with permission.
+* See accompanying file "TRADEMARK" for details.
+*
+* To redistribute this file separately, substitute the full license texts
+* for the above references.
+*/
+
+// Tests C4TiledSurface8
+
+#include <gtest/gtest.h>
+
+#include "C4Include.h"
+#include "landscape/C4TiledSurface8.h"
+#include "c4group/CStdFile.h"
+
+namespace
+{
+	// Size that is no multiple of the tile size, so edge tiles are partial
+	const int Wdt = 3 * C4TiledSurface8::TileSize + 5, Hgt = 2 * C4TiledSurface8::TileSize + 17;
+
+	BYTE Pattern(int x, int y)
+	{
+		return (x * 7 + y * 13) % 251;
+	}
+}
+
+TEST(C4TiledSurface8, SetAndGetPix)
+{
+	C4TiledSurface8 sfc(Wdt, Hgt, 3);
+	EXPECT_EQ(3, sfc._GetPix(Wdt - 1, Hgt - 1));
+	for (int y = 0; y < Hgt; ++y)
+		for (int x = 0; x < Wdt; ++x)
+			sfc._SetPix(x, y, Pattern(x, y));
+	for (int y = 0; y < Hgt; ++y)
+		for (int x = 0; x < Wdt; ++x)
+			ASSERT_EQ(Pattern(x, y), sfc._GetPix(x, y));
+	EXPECT_EQ(0, sfc.GetPix(-1, 0));
+	EXPECT_EQ(0, sfc.GetPix(Wdt, 0));
+	// Clipped writes are dropped
+	sfc.Clip(10, 10, 20, 20);
+	sfc.SetPix(5, 5, 200);
+	sfc.SetPix(15, 15, 200);
+	sfc.NoClip();
+	EXPECT_EQ(Pattern(5, 5), sfc._GetPix(5, 5));
+	EXPECT_EQ(200, sfc._GetPix(15, 15));
+}
+
+TEST(C4TiledSurface8, SharedTiles)
+{
+	C4TiledSurface8 sfc(Wdt, Hgt, 0), other(Wdt, Hgt, 0);
+	// Writing the color a shared tile already has keeps it shared
+	sfc._SetPix(1, 1, 0);
+	EXPECT_TRUE(sfc.IsUniformTile(0, 0, 0));
+	// Other writes copy the tile without touching other surfaces
+	sfc._SetPix(1, 1, 42);
+	EXPECT_FALSE(sfc.IsUniformTile(0, 0, 0));
+	EXPECT_EQ(42, sfc._GetPix(1, 1));
+	EXPECT_EQ(0, sfc._GetPix(2, 1));
+	EXPECT_EQ(0, other._GetPix(1, 1));
+	EXPECT_TRUE(other.IsUniformTile(0, 0, 0));
+	// Tiles become shared again once they are uniform
+	sfc.Box(0, 0, C4TiledSurface8::TileSize - 1, C4TiledSurface8::TileSize - 1, 42);
+	sfc.Compact();
+	EXPECT_TRUE(sfc.IsUniformTile(0, 0, 42));
+	EXPECT_EQ(42, sfc._GetPix(C4TiledSurface8::TileSize - 1, C4TiledSurface8::TileSize - 1));
+	EXPECT_EQ(0, sfc._GetPix(C4TiledSurface8::TileSize, 0));
+	// Only pixels inside the surface decide about edge tiles
+	const int tx = Wdt / C4TiledSurface8::TileSize, ty = Hgt / C4TiledSurface8::TileSize;
+	sfc.Box(tx * C4TiledSurface8::TileSize, ty * C4TiledSurface8::TileSize, Wdt - 1, Hgt - 1, 7);
+	sfc.Compact();
+	EXPECT_TRUE(sfc.IsUniformTile(tx, ty, 7));
+}
+
+TEST(C4TiledSurface8, CopyRect)
+{
+	C4TiledSurface8 sfc(Wdt, Hgt);
+	for (int y = 0; y < Hgt; ++y)
+		for (int x = 0; x < Wdt; ++x)
+			sfc._SetPix(x, y, Pattern(x, y));
+	// Rect crossing tile borders in both directions
+	const int x0 = C4TiledSurface8::TileSize - 3, y0 = C4TiledSurface8::TileSize - 2, wdt = C4TiledSurface8::TileSize + 9, hgt = 5;
+	const int pitch = wdt + 3;
+	std::vector<BYTE> buf(pitch * hgt, 255);
+	sfc.CopyRect(x0, y0, wdt, hgt, buf.data(), pitch);
+	for (int y = 0; y < hgt; ++y)
+	{
+		for (int x = 0; x < wdt; ++x)
+			ASSERT_EQ(Pattern(x0 + x, y0 + y), buf[y * pitch + x]);
+		EXPECT_EQ(255, buf[y * pitch + wdt]);
+	}
+}
+
+TEST(C4TiledSurface8, SaveAndRead)
+{
+	C4TiledSurface8 sfc(Wdt, Hgt, 5);
+	sfc.pPal->Colors[5] = C4RGB(1, 2, 3);
+	// Leave most tiles uniform, fill one row of pixels across all tiles
+	for (int x = 0; x < Wdt; ++x)
+		sfc._SetPix(x, C4TiledSurface8::TileSize + 1, Pattern(x, 0));
+	const char *szFilename = "C4TiledSurface8Test.bmp";
+	ASSERT_TRUE(sfc.Save(szFilename));
+
+	CStdFile hFile;
+	ASSERT_TRUE(hFile.Open(szFilename));
+	std::unique_ptr<C4TiledSurface8> pRead = C4TiledSurface8::Read(hFile);
+	hFile.Close();
+	EraseFile(szFilename);
+	ASSERT_NE(nullptr, pRead);
+	ASSERT_EQ(Wdt, pRead->Wdt);
+	ASSERT_EQ(Hgt, pRead->Hgt);
+	EXPECT_EQ(C4RGB(1, 2, 3), pRead->pPal->Colors[5]);
+	for (int y = 0; y < Hgt; ++y)
+		for (int x = 0; x < Wdt; ++x)
+			ASSERT_EQ(sfc._GetPix(x, y), pRead->_GetPix(x, y));
+	// Uniform tiles are shared after reading
+	EXPECT_TRUE(pRead->IsUniformTile(0, 0, 5));
+	EXPECT_FALSE(pRead->IsUniformTile(0, 1, 5));
+	EXPECT_TRUE(pRead->IsUniformTile(2, 2, 5));
+}
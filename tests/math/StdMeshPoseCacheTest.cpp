@@ -0,0 +1,91 @@
+/*
+* OpenClonk, http://www.openclonk.org
+*
+* Copyright (c) 2016, The OpenClonk Team and contributors
+*
+* Distributed under the terms of the ISC license; see accompanying file
+* "COPYING" for details.
+*
+* "Clonk" is a registered trademark of Matthes Bender, used with permission.
+* See accompanying file "TRADEMARK" for details.
+*
+* To redistribute this file separately, substitute the full license texts
+* for the above references.
+*/
+
+// Tests StdMeshPoseCache
+
+#include <gtest/gtest.h>
+
+#include "C4Include.h"
+#include "lib/StdMeshPose.h"
+
+namespace
+{
+	StdMeshPoseCache::BoneMatrices Bones(float x)
+	{
+		return { StdMeshMatrix::Identity(), StdMeshMatrix::Translate(x, 2.0f * x, 3.0f * x) };
+	}
+}
+
+TEST(StdMeshPoseCache, Hit)
+{
+	StdMeshPoseCache cache;
+	EXPECT_EQ(nullptr, cache.Lookup("walk@1"));
+	cache.Store("walk@1", Bones(1.0f));
+	cache.Store("walk@2", Bones(2.0f));
+	const StdMeshPoseCache::BoneMatrices* bones = cache.Lookup("walk@2");
+	ASSERT_NE(nullptr, bones);
+	ASSERT_EQ(2u, bones->size());
+	EXPECT_EQ(2.0f, (*bones)[1](0, 3));
+	EXPECT_EQ(4.0f, (*bones)[1](1, 3));
+	EXPECT_EQ(6.0f, (*bones)[1](2, 3));
+	EXPECT_NE(nullptr, cache.Lookup("walk@1"));
+	EXPECT_EQ(2u, cache.HitCnt);
+	EXPECT_EQ(1u, cache.MissCnt);
+	EXPECT_EQ(2u, cache.MaxEntryCnt);
+}
+
+TEST(StdMeshPoseCache, NextFrame)
+{
+	// Entries survive as long as they are used in every frame
+	StdMeshPoseCache cache;
+	cache.Store("idle@0", Bones(1.0f));
+	cache.Store("walk@1", Bones(2.0f));
+	cache.NextFrame();
+	EXPECT_NE(nullptr, cache.Lookup("idle@0"));
+	cache.NextFrame();
+	EXPECT_NE(nullptr, cache.Lookup("idle@0"));
+	EXPECT_EQ(nullptr, cache.Lookup("walk@1"));
+}
+
+TEST(StdMeshPoseCache, SkeletonsChanged)
+{
+	// Replacing an animation or skeleton invalidates all caches
+	StdMeshPoseCache cache, other;
+	cache.Store("walk@1", Bones(1.0f));
+	other.Store("walk@1", Bones(1.0f));
+	StdMeshPoseCache::SkeletonsChanged();
+	EXPECT_EQ(nullptr, cache.Lookup("walk@1"));
+	EXPECT_EQ(nullptr, other.Lookup("walk@1"));
+	// Entries stored afterwards are valid again
+	cache.Store("walk@1", Bones(2.0f));
+	const StdMeshPoseCache::BoneMatrices* bones = cache.Lookup("walk@1");
+	ASSERT_NE(nullptr, bones);
+	EXPECT_EQ(2.0f, (*bones)[1](0, 3));
+}
+
+TEST(StdMeshPoseCache, Settings)
+{
+	// Changing the time quantum or disabling the cache drops all entries
+	StdMeshPoseCache cache;
+	cache.Store("walk@1", Bones(1.0f));
+	cache.SetTimeQuantum(0.0f);
+	EXPECT_NE(nullptr, cache.Lookup("walk@1"));
+	cache.SetTimeQuantum(0.05f);
+	EXPECT_EQ(nullptr, cache.Lookup("walk@1"));
+	cache.Store("walk@1", Bones(1.0f));
+	cache.SetEnabled(false);
+	EXPECT_FALSE(cache.IsEnabled());
+	EXPECT_EQ(nullptr, cache.Lookup("walk@1"));
+}
@@ -0,0 +1,110 @@
+/*
+* OpenClonk, http://www.openclonk.org
+*
+* Copyright (c) 2016, The OpenClonk Team and contributors
+*
+* Distributed under the terms of the ISC license; see accompanying file
+* "COPYING" for details.
+*
+* "Clonk" is a registered trademark of Matthes Bender, used with permission.
+* See accompanying file "TRADEMARK" for details.
+*
+* To redistribute this file separately, substitute the full license texts
+* for the above references.
+*/
+
+// Tests StdMeshPose
+
+#include <gtest/gtest.h>
+
+#include "C4Include.h"
+#include "lib/StdMeshPose.h"
+
+namespace
+{
+	StdMeshTransformation KeyFrame(float angle, float ax, float ay, float az, float tx, float ty, float tz, float s)
+	{
+		StdMeshTransformation t;
+		StdMeshVector axis = StdMeshVector::Translate(ax, ay, az);
+		axis.Normalize();
+		t.rotate = StdMeshQuaternion::AngleAxis(angle, axis);
+		t.translate = StdMeshVector::Translate(tx, ty, tz);
+		t.scale = StdMeshVector::Translate(s, s * 0.5f, s * 2.0f);
+		return t;
+	}
+
+	uint32_t Bits(float f)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &f, sizeof(bits));
+		return bits;
+	}
+
+	void ExpectBitIdentical(const StdMeshTransformation& expected, const StdMeshTransformation& actual)
+	{
+		EXPECT_EQ(Bits(expected.translate.x), Bits(actual.translate.x));
+		EXPECT_EQ(Bits(expected.translate.y), Bits(actual.translate.y));
+		EXPECT_EQ(Bits(expected.translate.z), Bits(actual.translate.z));
+		EXPECT_EQ(Bits(expected.rotate.w), Bits(actual.rotate.w));
+		EXPECT_EQ(Bits(expected.rotate.x), Bits(actual.rotate.x));
+		EXPECT_EQ(Bits(expected.rotate.y), Bits(actual.rotate.y));
+		EXPECT_EQ(Bits(expected.rotate.z), Bits(actual.rotate.z));
+		EXPECT_EQ(Bits(expected.scale.x), Bits(actual.scale.x));
+		EXPECT_EQ(Bits(expected.scale.y), Bits(actual.scale.y));
+		EXPECT_EQ(Bits(expected.scale.z), Bits(actual.scale.z));
+	}
+}
+
+TEST(StdMeshPose, BlendMatchesNlerp)
+{
+	// Pairs of keyframes, including rotations in opposite hemispheres
+	const std::vector<std::pair<StdMeshTransformation, StdMeshTransformation>> keyframes = {
+		{ KeyFrame(0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f), KeyFrame(1.5f, 0.0f, 0.0f, 1.0f, 1.0f, 2.0f, 3.0f, 1.0f) },
+		{ KeyFrame(0.3f, 1.0f, 2.0f, 3.0f, -4.5f, 0.25f, 7.0f, 0.8f), KeyFrame(-2.9f, 3.0f, -1.0f, 0.5f, 2.0f, -3.0f, 0.1f, 1.3f) },
+		{ KeyFrame(3.0f, 0.0f, 1.0f, 0.0f, 10.0f, 0.0f, -10.0f, 2.0f), KeyFrame(-3.0f, 0.0f, 1.0f, 0.0f, -10.0f, 0.0f, 10.0f, 0.5f) },
+		{ KeyFrame(1.0f, -1.0f, 1.0f, -1.0f, 0.001f, 1000.0f, 0.5f, 1.0f), KeyFrame(1.0001f, -1.0f, 1.0f, -1.0f, 0.002f, 999.0f, 0.5f, 1.0f) },
+		{ KeyFrame(0.7f, 0.2f, 0.9f, 0.1f, 3.0f, 3.0f, 3.0f, 1.1f), KeyFrame(6.0f, -0.4f, 0.3f, 0.8f, -1.0f, 5.0f, 2.0f, 0.9f) },
+	};
+	for (float w : { 0.0f, 0.1f, 0.25f, 0.5f, 0.75f, 0.999f, 1.0f })
+	{
+		SCOPED_TRACE(w);
+		StdMeshPose lhs, rhs;
+		lhs.Reset(keyframes.size());
+		rhs.Reset(keyframes.size());
+		for (size_t i = 0; i < keyframes.size(); ++i)
+		{
+			lhs.Set(i, keyframes[i].first);
+			rhs.Set(i, keyframes[i].second);
+		}
+		lhs.Blend(rhs, w);
+		for (size_t i = 0; i < keyframes.size(); ++i)
+		{
+			SCOPED_TRACE(i);
+			EXPECT_TRUE(lhs.IsSet(i));
+			StdMeshTransformation actual;
+			lhs.Get(i, actual);
+			ExpectBitIdentical(StdMeshTransformation::Nlerp(keyframes[i].first, keyframes[i].second, w), actual);
+		}
+	}
+}
+
+TEST(StdMeshPose, BlendUnsetBones)
+{
+	// Bones set in only one of the poses are taken from that pose
+	const StdMeshTransformation a = KeyFrame(0.5f, 1.0f, 0.0f, 0.0f, 1.0f, 2.0f, 3.0f, 1.0f);
+	const StdMeshTransformation b = KeyFrame(-1.0f, 0.0f, 1.0f, 0.0f, 4.0f, 5.0f, 6.0f, 2.0f);
+	StdMeshPose lhs, rhs;
+	lhs.Reset(3);
+	rhs.Reset(3);
+	lhs.Set(0, a);
+	rhs.Set(1, b);
+	lhs.Blend(rhs, 0.5f);
+	StdMeshTransformation actual;
+	EXPECT_TRUE(lhs.IsSet(0));
+	lhs.Get(0, actual);
+	ExpectBitIdentical(a, actual);
+	EXPECT_TRUE(lhs.IsSet(1));
+	lhs.Get(1, actual);
+	ExpectBitIdentical(b, actual);
+	EXPECT_FALSE(lhs.IsSet(2));
+}
@@ -0,0 +1,29 @@
+#!/usr/bin/env bash
+# Times the scripts in c4script_benchmark/ with the standalone c4script
+# executable. Build c4script with -DUSE_AUL_COMPUTED_GOTO=ON and OFF to
+# compare the bytecode dispatch variants.
+#
+# Usage: c4script_benchmark.sh <path to c4script> [runs per script]
+
+error() {
+	echo error: "$@"
+	exit 1
+}
+
+[[ $# -ge 1 ]] || error "usage: $0 <path to c4script> [runs per script]"
+c4script=$(realpath "$1") || error "c4script not found"
+[[ -x $c4script ]] || error "$c4script is not executable"
+runs=${2:-5}
+
+cd "$(dirname "$0")/c4script_benchmark" || error "benchmark scripts not found"
+
+for script in *.c; do
+	best=
+	for ((run = 0; run < runs; ++run)); do
+		start=$(date +%s%N)
+		"$c4script" "$script" || error "$script failed"
+		time=$(( ($(date +%s%N) - start) / 1000000 ))
+		[[ -z $best || $time -lt $best ]] && best=$time
+	done
+	printf "%-20s %6d ms\n" "${script%.c}" "$best"
+done
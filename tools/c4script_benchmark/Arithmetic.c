@@ -0,0 +1,14 @@
+/* Integer arithmetic, comparisons and branches on local variables */
+
+func Main()
+{
+	var s = 0, n = 5000000;
+	for (var i = 0; i < n; ++i)
+	{
+		if (i % 3 == 0)
+			s += i * 2;
+		else
+			s -= (i >> 2) & 7;
+	}
+	return s;
+}
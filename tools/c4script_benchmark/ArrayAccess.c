@@ -0,0 +1,15 @@
+/* Reading and writing array elements */
+
+func Main()
+{
+	var a = CreateArray(100), s = 0;
+	for (var i = 0; i < 100; ++i)
+		a[i] = i;
+	for (var j = 0; j < 50000; ++j)
+		for (var i = 0; i < 100; ++i)
+		{
+			s += a[i];
+			a[i] = s % 1000;
+		}
+	return s;
+}
@@ -0,0 +1,21 @@
+/* Script function calls with parameters */
+
+func Add(a, b)
+{
+	return a + b;
+}
+
+func Fib(n)
+{
+	if (n < 2)
+		return n;
+	return Fib(n - 1) + Fib(n - 2);
+}
+
+func Main()
+{
+	var s = 0;
+	for (var i = 0; i < 2000000; ++i)
+		s = Add(s, i) % 1000;
+	return s + Fib(24);
+}